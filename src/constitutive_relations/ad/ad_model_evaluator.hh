@@ -0,0 +1,251 @@
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+//! ADModelEvaluator: an algebraic evaluator differentiating its model automatically.
+
+/*!
+
+Evaluates a pointwise model of N dependencies, whose partial derivatives are
+all obtained from one evaluation of the model on dual numbers (see dual.hh),
+so no derivatives are written by hand.
+
+Assembling a preconditioner requests partial derivatives with respect to
+several dependencies at the same state, one at a time.  All partials
+requested so far are computed together in one pass, and kept until a
+dependency changes.
+
+A model provides:
+
+.. code-block:: c++
+
+    class MyModel {
+     public:
+      static const int num_args = 2;
+      static std::string name() { return "my_model"; }
+      // default keys of the arguments, without the domain prefix
+      static std::vector<std::string> arguments() { return {"porosity", "temperature"}; }
+
+      explicit MyModel(Teuchos::ParameterList& plist);
+
+      template<class Scalar>
+      Scalar operator()(const Scalar* x) const;
+    };
+
+and is registered as an evaluator through a specialization of reg_, e.g. in
+my_model_reg.hh:
+
+.. code-block:: c++
+
+    template<> Utils::RegisteredFactory<FieldEvaluator,ADModelEvaluator<MyModel> >
+    ADModelEvaluator<MyModel>::reg_("my model");
+
+The key of each argument is read from `"ARGUMENT key`", where ARGUMENT is
+the default key with spaces for underscores, defaulting to the default key
+in the domain of this evaluator.  Model parameters are read from the
+sublist `"NAME parameters`".
+
+*/
+
+#ifndef ATS_AD_MODEL_EVALUATOR_HH_
+#define ATS_AD_MODEL_EVALUATOR_HH_
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "Factory.hh"
+#include "secondary_variable_field_evaluator.hh"
+
+#include "dual.hh"
+
+namespace Amanzi {
+
+template<class Model>
+class ADModelEvaluator : public SecondaryVariableFieldEvaluator {
+
+ public:
+  static const int N = Model::num_args;
+
+  explicit
+  ADModelEvaluator(Teuchos::ParameterList& plist);
+  ADModelEvaluator(const ADModelEvaluator& other);
+
+  virtual Teuchos::RCP<FieldEvaluator> Clone() const {
+    return Teuchos::rcp(new ADModelEvaluator(*this));
+  }
+
+  // Required methods from SecondaryVariableFieldEvaluator
+  virtual void EvaluateField_(const Teuchos::Ptr<State>& S,
+          const Teuchos::Ptr<CompositeVector>& result);
+  virtual void EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
+          Key wrt_key, const Teuchos::Ptr<CompositeVector>& result);
+
+  // Partial derivatives with respect to several dependencies, computed
+  // together in one pass.
+  void EvaluateFieldPartialDerivatives_(const Teuchos::Ptr<State>& S,
+          const std::vector<Key>& wrt_keys,
+          const std::vector<Teuchos::Ptr<CompositeVector> >& results);
+
+  Teuchos::RCP<Model> get_model() { return model_; }
+
+ protected:
+  // Partials with respect to the arguments in wrt.  Where several arguments
+  // share a key, the partial with respect to that key is their sum.
+  void EvaluatePartials_(const Teuchos::Ptr<State>& S,
+          const std::vector<Key>& wrt,
+          const std::vector<Teuchos::Ptr<CompositeVector> >& results);
+
+  std::vector<Key> keys_;  // key of each argument
+  Teuchos::RCP<Model> model_;
+
+  // partial derivatives with respect to each dependency requested so far,
+  // valid until a dependency changes
+  std::vector<Key> partials_keys_;
+  std::vector<Teuchos::RCP<CompositeVector> > partials_;
+  Key partials_request_;
+
+ private:
+  static Utils::RegisteredFactory<FieldEvaluator,ADModelEvaluator<Model> > reg_;
+};
+
+
+template<class Model>
+ADModelEvaluator<Model>::ADModelEvaluator(Teuchos::ParameterList& plist) :
+    SecondaryVariableFieldEvaluator(plist)
+{
+  Teuchos::ParameterList& sublist = plist_.sublist(Model::name() + " parameters");
+  model_ = Teuchos::rcp(new Model(sublist));
+
+  Key domain_name = Keys::getDomainPrefix(my_key_);
+  std::vector<std::string> args = Model::arguments();
+  AMANZI_ASSERT(args.size() == N);
+  for (int k=0; k!=N; ++k) {
+    std::string arg_string = args[k];
+    std::replace(arg_string.begin(), arg_string.end(), '_', ' ');
+    keys_.push_back(plist_.get<std::string>(arg_string + " key", domain_name + args[k]));
+    dependencies_.insert(keys_[k]);
+  }
+
+  partials_request_ = my_key_ + " partial derivatives";
+}
+
+
+template<class Model>
+ADModelEvaluator<Model>::ADModelEvaluator(const ADModelEvaluator& other) :
+    SecondaryVariableFieldEvaluator(other),
+    keys_(other.keys_),
+    model_(other.model_),
+    partials_request_(other.partials_request_) {}
+
+
+template<class Model>
+void
+ADModelEvaluator<Model>::EvaluateField_(const Teuchos::Ptr<State>& S,
+        const Teuchos::Ptr<CompositeVector>& result)
+{
+  std::vector<Teuchos::RCP<const CompositeVector> > deps(N);
+  for (int k=0; k!=N; ++k) deps[k] = S->GetFieldData(keys_[k]);
+
+  std::vector<const double*> deps_v(N);
+  double x[N];
+  for (CompositeVector::name_iterator comp=result->begin();
+       comp!=result->end(); ++comp) {
+    for (int k=0; k!=N; ++k) deps_v[k] = (*deps[k]->ViewComponent(*comp, false))[0];
+    Epetra_MultiVector& result_v = *result->ViewComponent(*comp,false);
+
+    int ncomp = result->size(*comp, false);
+    for (int i=0; i!=ncomp; ++i) {
+      for (int k=0; k!=N; ++k) x[k] = deps_v[k][i];
+      result_v[0][i] = (*model_)(x);
+    }
+  }
+}
+
+
+template<class Model>
+void
+ADModelEvaluator<Model>::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
+        Key wrt_key, const Teuchos::Ptr<CompositeVector>& result)
+{
+  AMANZI_ASSERT(std::find(keys_.begin(), keys_.end(), wrt_key) != keys_.end());
+
+  bool changed = false;
+  for (KeySet::const_iterator dep=dependencies_.begin();
+       dep!=dependencies_.end(); ++dep) {
+    changed |= S->GetFieldEvaluator(*dep)->HasFieldChanged(S, partials_request_);
+  }
+
+  int k = std::find(partials_keys_.begin(), partials_keys_.end(), wrt_key)
+      - partials_keys_.begin();
+  if (k == partials_keys_.size()) {
+    partials_keys_.push_back(wrt_key);
+    partials_.push_back(Teuchos::rcp(new CompositeVector(*result)));
+    changed = true;
+  }
+
+  if (changed) {
+    std::vector<Teuchos::Ptr<CompositeVector> > results;
+    for (int j=0; j!=partials_.size(); ++j) results.push_back(partials_[j].ptr());
+    EvaluatePartials_(S, partials_keys_, results);
+  }
+
+  *result = *partials_[k];
+}
+
+
+template<class Model>
+void
+ADModelEvaluator<Model>::EvaluateFieldPartialDerivatives_(const Teuchos::Ptr<State>& S,
+        const std::vector<Key>& wrt_keys,
+        const std::vector<Teuchos::Ptr<CompositeVector> >& results)
+{
+  AMANZI_ASSERT(wrt_keys.size() == results.size());
+  if (wrt_keys.size() > 0) EvaluatePartials_(S, wrt_keys, results);
+}
+
+
+template<class Model>
+void
+ADModelEvaluator<Model>::EvaluatePartials_(const Teuchos::Ptr<State>& S,
+        const std::vector<Key>& wrt,
+        const std::vector<Teuchos::Ptr<CompositeVector> >& results)
+{
+  std::vector<Teuchos::RCP<const CompositeVector> > deps(N);
+  for (int k=0; k!=N; ++k) deps[k] = S->GetFieldData(keys_[k]);
+
+  // the result each argument's partial is added to, or -1
+  int nwrt = wrt.size();
+  std::vector<int> result_of_arg(N, -1);
+  for (int k=0; k!=N; ++k) {
+    int j = std::find(wrt.begin(), wrt.end(), keys_[k]) - wrt.begin();
+    if (j != nwrt) result_of_arg[k] = j;
+  }
+
+  std::vector<const double*> deps_v(N);
+  std::vector<double*> results_v(nwrt);
+  AD::Dual<N> x[N];
+  for (CompositeVector::name_iterator comp=results[0]->begin();
+       comp!=results[0]->end(); ++comp) {
+    for (int k=0; k!=N; ++k) deps_v[k] = (*deps[k]->ViewComponent(*comp, false))[0];
+    for (int j=0; j!=nwrt; ++j) results_v[j] = (*results[j]->ViewComponent(*comp, false))[0];
+
+    int ncomp = results[0]->size(*comp, false);
+    for (int i=0; i!=ncomp; ++i) {
+      for (int k=0; k!=N; ++k) x[k] = AD::Dual<N>::variable(deps_v[k][i], k);
+      AD::Dual<N> r = (*model_)(x);
+
+      for (int j=0; j!=nwrt; ++j) results_v[j][i] = 0.;
+      for (int k=0; k!=N; ++k) {
+        if (result_of_arg[k] >= 0) results_v[result_of_arg[k]][i] += r.d(k);
+      }
+    }
+  }
+}
+
+} // namespace
+
+#endif
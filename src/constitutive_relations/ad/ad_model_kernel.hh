@@ -0,0 +1,111 @@
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+//! ADModelKernel: a model of ADModelEvaluator, as a pointwise kernel.
+
+/*!
+
+Wraps a model of ADModelEvaluator (see ad_model_evaluator.hh) as a
+PointwiseKernel, for use in a FusedPointwiseEvaluator.  Derivatives are
+from the model on dual numbers.  It is registered through a specialization
+of reg_, e.g.:
+
+.. code-block:: c++
+
+    template<> Utils::RegisteredFactory<Relations::PointwiseKernel,ADModelKernel<MyModel> >
+    ADModelKernel<MyModel>::reg_("my model");
+
+Argument keys are read as in ADModelEvaluator, and the result key from
+`"result key`", defaulting to the model's name in the domain.
+
+*/
+
+#ifndef ATS_AD_MODEL_KERNEL_HH_
+#define ATS_AD_MODEL_KERNEL_HH_
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "PointwiseKernel.hh"
+
+#include "dual.hh"
+
+namespace Amanzi {
+
+template<class Model>
+class ADModelKernel : public Relations::PointwiseKernel {
+
+ public:
+  static const int N = Model::num_args;
+
+  explicit
+  ADModelKernel(Teuchos::ParameterList& plist);
+
+  virtual void Evaluate(const std::string& comp, int begin, int n,
+                        const double* const* args, double* const* results);
+  virtual void EvaluateWithDerivatives(const std::string& comp, int begin, int n,
+          const double* const* args, double* const* results, double* const* jac);
+
+  Teuchos::RCP<Model> get_model() { return model_; }
+
+ protected:
+  Teuchos::RCP<Model> model_;
+
+ private:
+  static Utils::RegisteredFactory<Relations::PointwiseKernel,ADModelKernel<Model> > reg_;
+};
+
+
+template<class Model>
+ADModelKernel<Model>::ADModelKernel(Teuchos::ParameterList& plist) :
+    Relations::PointwiseKernel(plist)
+{
+  Teuchos::ParameterList& sublist = plist_.sublist(Model::name() + " parameters");
+  model_ = Teuchos::rcp(new Model(sublist));
+
+  std::vector<std::string> args = Model::arguments();
+  AMANZI_ASSERT(args.size() == N);
+  for (int k=0; k!=N; ++k) {
+    std::string arg_string = args[k];
+    std::replace(arg_string.begin(), arg_string.end(), '_', ' ');
+    args_.push_back(plist_.get<std::string>(arg_string + " key", Keys::getKey(domain_, args[k])));
+  }
+  results_.push_back(Keys::readKey(plist_, domain_, "result", Model::name()));
+}
+
+
+template<class Model>
+void
+ADModelKernel<Model>::Evaluate(const std::string& comp, int begin, int n,
+        const double* const* args, double* const* results)
+{
+  double x[N];
+  for (int i=0; i!=n; ++i) {
+    for (int k=0; k!=N; ++k) x[k] = args[k][i];
+    results[0][i] = (*model_)(x);
+  }
+}
+
+
+template<class Model>
+void
+ADModelKernel<Model>::EvaluateWithDerivatives(const std::string& comp, int begin, int n,
+        const double* const* args, double* const* results, double* const* jac)
+{
+  AD::Dual<N> x[N];
+  for (int i=0; i!=n; ++i) {
+    for (int k=0; k!=N; ++k) x[k] = AD::Dual<N>::variable(args[k][i], k);
+    AD::Dual<N> r = (*model_)(x);
+    results[0][i] = r.value();
+    for (int k=0; k!=N; ++k) jac[k][i] = r.d(k);
+  }
+}
+
+} // namespace
+
+#endif
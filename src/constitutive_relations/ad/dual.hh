@@ -0,0 +1,198 @@
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+//! Dual numbers for forward-mode automatic differentiation of models.
+
+/*!
+
+Constitutive models carry a hand-written derivative for each of their
+arguments, which must be written and checked whenever an argument is added.
+A model written once as a template on its scalar type,
+
+.. code-block:: c++
+
+    template<class Scalar>
+    Scalar operator()(const Scalar* x) const { return x[0] * exp(x[1]); }
+
+evaluates its value as `double`, or its value and all N partial derivatives
+as `AD::Dual<N>`, seeding argument k with `AD::Dual<N>::variable(x_k, k)`.
+The derivatives are exact to round-off, not finite differences.
+
+`Dual<N>` holds its derivatives in a fixed size array, so loops over
+derivatives are unrolled.  Each operation costs O(N), and each function
+one evaluation, so dual numbers are cheapest for models of few arguments
+and costly functions (pow, exp), where they beat separate hand-written
+derivatives.  Models of many arguments but little arithmetic, such as the
+sums of products of the energy and water content models, are faster with
+the fused kernels of evaluator_generator.
+
+Comparisons act on values only, so branches in a model follow the value.
+Math functions are found by argument dependent lookup, so models should
+call them unqualified, after `using std::exp;` etc. for the `double` case.
+
+*/
+
+#ifndef ATS_AD_DUAL_HH_
+#define ATS_AD_DUAL_HH_
+
+#include <cmath>
+
+namespace Amanzi {
+namespace AD {
+
+template<int N>
+class Dual {
+ public:
+  Dual() : v_(0.) { for (int i=0; i!=N; ++i) d_[i] = 0.; }
+  Dual(double v) : v_(v) { for (int i=0; i!=N; ++i) d_[i] = 0.; }
+
+  // the independent variable i, with value v
+  static Dual variable(double v, int i) {
+    Dual x(v);
+    x.d_[i] = 1.;
+    return x;
+  }
+
+  double value() const { return v_; }
+  double d(int i) const { return d_[i]; }
+  const double* d() const { return d_; }
+
+  Dual& operator+=(const Dual& o) {
+    v_ += o.v_;
+    for (int i=0; i!=N; ++i) d_[i] += o.d_[i];
+    return *this;
+  }
+  Dual& operator-=(const Dual& o) {
+    v_ -= o.v_;
+    for (int i=0; i!=N; ++i) d_[i] -= o.d_[i];
+    return *this;
+  }
+  Dual& operator*=(const Dual& o) {
+    for (int i=0; i!=N; ++i) d_[i] = d_[i] * o.v_ + v_ * o.d_[i];
+    v_ *= o.v_;
+    return *this;
+  }
+  Dual& operator/=(const Dual& o) {
+    double inv = 1. / o.v_;
+    v_ *= inv;
+    for (int i=0; i!=N; ++i) d_[i] = (d_[i] - v_ * o.d_[i]) * inv;
+    return *this;
+  }
+
+  Dual& operator+=(double a) { v_ += a; return *this; }
+  Dual& operator-=(double a) { v_ -= a; return *this; }
+  Dual& operator*=(double a) {
+    v_ *= a;
+    for (int i=0; i!=N; ++i) d_[i] *= a;
+    return *this;
+  }
+  Dual& operator/=(double a) { return *this *= 1. / a; }
+
+  // f(x), given f(value) and f'(value)
+  Dual chain(double f, double df) const {
+    Dual r(f);
+    for (int i=0; i!=N; ++i) r.d_[i] = df * d_[i];
+    return r;
+  }
+
+ private:
+  double v_;
+  double d_[N];
+};
+
+
+// value of a scalar, for code templated on double or Dual
+inline double value(double x) { return x; }
+template<int N> double value(const Dual<N>& x) { return x.value(); }
+
+
+// arithmetic
+template<int N> Dual<N> operator+(const Dual<N>& a) { return a; }
+template<int N> Dual<N> operator-(const Dual<N>& a) { return a.chain(-a.value(), -1.); }
+
+template<int N> Dual<N> operator+(Dual<N> a, const Dual<N>& b) { return a += b; }
+template<int N> Dual<N> operator+(Dual<N> a, double b) { return a += b; }
+template<int N> Dual<N> operator+(double a, Dual<N> b) { return b += a; }
+
+template<int N> Dual<N> operator-(Dual<N> a, const Dual<N>& b) { return a -= b; }
+template<int N> Dual<N> operator-(Dual<N> a, double b) { return a -= b; }
+template<int N> Dual<N> operator-(double a, const Dual<N>& b) { return -b + a; }
+
+template<int N> Dual<N> operator*(Dual<N> a, const Dual<N>& b) { return a *= b; }
+template<int N> Dual<N> operator*(Dual<N> a, double b) { return a *= b; }
+template<int N> Dual<N> operator*(double a, Dual<N> b) { return b *= a; }
+
+template<int N> Dual<N> operator/(Dual<N> a, const Dual<N>& b) { return a /= b; }
+template<int N> Dual<N> operator/(Dual<N> a, double b) { return a /= b; }
+template<int N> Dual<N> operator/(double a, const Dual<N>& b) {
+  double v = a / b.value();
+  return b.chain(v, -v / b.value());
+}
+
+
+// comparisons act on values
+template<int N> bool operator==(const Dual<N>& a, const Dual<N>& b) { return a.value() == b.value(); }
+template<int N> bool operator==(const Dual<N>& a, double b) { return a.value() == b; }
+template<int N> bool operator==(double a, const Dual<N>& b) { return a == b.value(); }
+template<int N> bool operator!=(const Dual<N>& a, const Dual<N>& b) { return a.value() != b.value(); }
+template<int N> bool operator!=(const Dual<N>& a, double b) { return a.value() != b; }
+template<int N> bool operator!=(double a, const Dual<N>& b) { return a != b.value(); }
+template<int N> bool operator<(const Dual<N>& a, const Dual<N>& b) { return a.value() < b.value(); }
+template<int N> bool operator<(const Dual<N>& a, double b) { return a.value() < b; }
+template<int N> bool operator<(double a, const Dual<N>& b) { return a < b.value(); }
+template<int N> bool operator>(const Dual<N>& a, const Dual<N>& b) { return a.value() > b.value(); }
+template<int N> bool operator>(const Dual<N>& a, double b) { return a.value() > b; }
+template<int N> bool operator>(double a, const Dual<N>& b) { return a > b.value(); }
+template<int N> bool operator<=(const Dual<N>& a, const Dual<N>& b) { return a.value() <= b.value(); }
+template<int N> bool operator<=(const Dual<N>& a, double b) { return a.value() <= b; }
+template<int N> bool operator<=(double a, const Dual<N>& b) { return a <= b.value(); }
+template<int N> bool operator>=(const Dual<N>& a, const Dual<N>& b) { return a.value() >= b.value(); }
+template<int N> bool operator>=(const Dual<N>& a, double b) { return a.value() >= b; }
+template<int N> bool operator>=(double a, const Dual<N>& b) { return a >= b.value(); }
+
+
+// math functions
+template<int N> Dual<N> exp(const Dual<N>& a) {
+  double e = std::exp(a.value());
+  return a.chain(e, e);
+}
+
+template<int N> Dual<N> log(const Dual<N>& a) {
+  return a.chain(std::log(a.value()), 1. / a.value());
+}
+
+template<int N> Dual<N> sqrt(const Dual<N>& a) {
+  double s = std::sqrt(a.value());
+  return a.chain(s, 0.5 / s);
+}
+
+template<int N> Dual<N> pow(const Dual<N>& a, double p) {
+  double f = std::pow(a.value(), p - 1.);
+  double v = a.value() == 0. ? std::pow(0., p) : f * a.value();
+  return a.chain(v, p * f);
+}
+
+template<int N> Dual<N> pow(double a, const Dual<N>& p) {
+  double f = std::pow(a, p.value());
+  return p.chain(f, f * std::log(a));
+}
+
+template<int N> Dual<N> pow(const Dual<N>& a, const Dual<N>& p) {
+  return exp(p * log(a));
+}
+
+template<int N> Dual<N> abs(const Dual<N>& a) {
+  return a.value() < 0. ? -a : a;
+}
+
+template<int N> Dual<N> fmax(const Dual<N>& a, const Dual<N>& b) { return a < b ? b : a; }
+template<int N> Dual<N> fmin(const Dual<N>& a, const Dual<N>& b) { return b < a ? b : a; }
+
+} // namespace
+} // namespace
+
+#endif
@@ -0,0 +1,191 @@
+/*
+  Cost of derivatives from dual numbers against hand-written derivatives.
+
+  - three phase energy, 14 arguments: the value and all partials from
+    separate hand-written functions, from the fused hand-written kernel,
+    and from one evaluation on Dual<14>;
+  - van Genuchten saturation and its derivative: WRMVanGenuchten, against
+    the same formula on Dual<1>.
+
+  Run as:
+
+    ad_benchmark [ncells] [repeats]
+
+  Differences are max relative differences of the derivatives.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include "Teuchos_ParameterList.hpp"
+
+#include "dual.hh"
+#include "three_phase_energy_model.hh"
+#include "wrm_van_genuchten.hh"
+
+
+// time of repeats of f(), per evaluation in ns
+template<class F>
+double time_ns(const F& f, int repeats, int n) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (int k=0; k!=repeats; ++k) f();
+  std::chrono::duration<double, std::nano> t = std::chrono::steady_clock::now() - t0;
+  return t.count() / repeats / n;
+}
+
+
+// three phase energy, as in ThreePhaseEnergyModel
+template<class Scalar>
+Scalar three_phase_energy(const Scalar* x) {
+  const Scalar& phi = x[0];
+  const Scalar& phi0 = x[1];
+  const Scalar& sl = x[2];
+  const Scalar& nl = x[3];
+  const Scalar& ul = x[4];
+  const Scalar& si = x[5];
+  const Scalar& ni = x[6];
+  const Scalar& ui = x[7];
+  const Scalar& sg = x[8];
+  const Scalar& ng = x[9];
+  const Scalar& ug = x[10];
+  const Scalar& rho_r = x[11];
+  const Scalar& ur = x[12];
+  const Scalar& cv = x[13];
+  return (phi*(sl*nl*ul + si*ni*ui + sg*ng*ug) + (1. - phi0)*rho_r*ur) * cv;
+}
+
+
+// van Genuchten saturation above the smoothing interval, as in WRMVanGenuchten
+template<class Scalar>
+Scalar vg_saturation(const Scalar& pc, double alpha, double n, double m, double sr) {
+  using std::pow;
+  return pow(1.0 + pow(alpha*pc, n), -m) * (1.0 - sr) + sr;
+}
+
+
+double rel_diff(double a, double b) {
+  return std::abs(a - b) / std::max(std::abs(b), 1.e-300);
+}
+
+
+int main(int argc, char *argv[])
+{
+  using namespace Amanzi;
+  using namespace Amanzi::Energy::Relations;
+  const int N = 14;
+
+  int ncells = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  int repeats = argc > 2 ? std::atoi(argv[2]) : 20;
+
+  // three phase energy, arguments stored by field as in an evaluator
+  Teuchos::ParameterList plist;
+  ThreePhaseEnergyModel hand(plist);
+
+  std::vector<std::vector<double> > x(N, std::vector<double>(ncells));
+  const double base[N] = { 0.4, 0.38, 0.3, 5.5e4, 1.2, 0.5, 5.0e4, -5.0,
+                           0.2, 40., 2.0, 2500., 0.8, 1.5 };
+  for (int c=0; c!=ncells; ++c) {
+    for (int k=0; k!=N; ++k) x[k][c] = base[k] * (1. + 0.1 * std::sin(c + k));
+  }
+  std::vector<std::vector<double> > d_sep(N+1, std::vector<double>(ncells));
+  std::vector<std::vector<double> > d_fused(N+1, std::vector<double>(ncells));
+  std::vector<std::vector<double> > d_ad(N+1, std::vector<double>(ncells));
+
+#define ARGS(c) x[0][c], x[1][c], x[2][c], x[3][c], x[4][c], x[5][c], x[6][c], \
+    x[7][c], x[8][c], x[9][c], x[10][c], x[11][c], x[12][c], x[13][c]
+
+  double t_sep = time_ns([&]() {
+      for (int c=0; c!=ncells; ++c) {
+        d_sep[N][c] = hand.Energy(ARGS(c));
+        d_sep[0][c] = hand.DEnergyDPorosity(ARGS(c));
+        d_sep[1][c] = hand.DEnergyDBasePorosity(ARGS(c));
+        d_sep[2][c] = hand.DEnergyDSaturationLiquid(ARGS(c));
+        d_sep[3][c] = hand.DEnergyDMolarDensityLiquid(ARGS(c));
+        d_sep[4][c] = hand.DEnergyDInternalEnergyLiquid(ARGS(c));
+        d_sep[5][c] = hand.DEnergyDSaturationIce(ARGS(c));
+        d_sep[6][c] = hand.DEnergyDMolarDensityIce(ARGS(c));
+        d_sep[7][c] = hand.DEnergyDInternalEnergyIce(ARGS(c));
+        d_sep[8][c] = hand.DEnergyDSaturationGas(ARGS(c));
+        d_sep[9][c] = hand.DEnergyDMolarDensityGas(ARGS(c));
+        d_sep[10][c] = hand.DEnergyDInternalEnergyGas(ARGS(c));
+        d_sep[11][c] = hand.DEnergyDDensityRock(ARGS(c));
+        d_sep[12][c] = hand.DEnergyDInternalEnergyRock(ARGS(c));
+        d_sep[13][c] = hand.DEnergyDCellVolume(ARGS(c));
+      }
+    }, repeats, ncells);
+
+  double t_fused = time_ns([&]() {
+      double d[N];
+      for (int c=0; c!=ncells; ++c) {
+        d_fused[N][c] = hand.EnergyAndDerivatives(ARGS(c), d);
+        for (int k=0; k!=N; ++k) d_fused[k][c] = d[k];
+      }
+    }, repeats, ncells);
+
+  double t_ad = time_ns([&]() {
+      AD::Dual<N> xc[N];
+      for (int c=0; c!=ncells; ++c) {
+        for (int k=0; k!=N; ++k) xc[k] = AD::Dual<N>::variable(x[k][c], k);
+        AD::Dual<N> e = three_phase_energy(xc);
+        d_ad[N][c] = e.value();
+        for (int k=0; k!=N; ++k) d_ad[k][c] = e.d(k);
+      }
+    }, repeats, ncells);
+#undef ARGS
+
+  double diff_energy = 0.;
+  for (int k=0; k!=N+1; ++k) {
+    for (int c=0; c!=ncells; ++c) {
+      diff_energy = std::max(diff_energy, rel_diff(d_ad[k][c], d_sep[k][c]));
+    }
+  }
+
+  // van Genuchten saturation
+  double alpha = 2.e-4, vg_n = 1.6, sr = 0.1;
+  double m = 1. - 1. / vg_n;
+  Teuchos::ParameterList vg_plist;
+  vg_plist.set("van Genuchten alpha", alpha);
+  vg_plist.set("van Genuchten m", m);
+  vg_plist.set("residual saturation", sr);
+  Flow::WRMVanGenuchten vg(vg_plist);
+
+  std::vector<double> pc(ncells), s_hand(ncells), ds_hand(ncells), s_ad(ncells), ds_ad(ncells);
+  for (int c=0; c!=ncells; ++c) pc[c] = std::pow(10., 1. + 6. * (c + 0.5) / ncells);
+
+  double t_vg_hand = time_ns([&]() {
+      for (int c=0; c!=ncells; ++c) {
+        s_hand[c] = vg.saturation(pc[c]);
+        ds_hand[c] = vg.d_saturation(pc[c]);
+      }
+    }, repeats, ncells);
+
+  double t_vg_ad = time_ns([&]() {
+      for (int c=0; c!=ncells; ++c) {
+        AD::Dual<1> s = vg_saturation(AD::Dual<1>::variable(pc[c], 0), alpha, vg_n, m, sr);
+        s_ad[c] = s.value();
+        ds_ad[c] = s.d(0);
+      }
+    }, repeats, ncells);
+
+  double diff_vg = 0.;
+  for (int c=0; c!=ncells; ++c) {
+    diff_vg = std::max(diff_vg, rel_diff(s_ad[c], s_hand[c]));
+    diff_vg = std::max(diff_vg, rel_diff(ds_ad[c], ds_hand[c]));
+  }
+
+  std::cout << "Value and derivatives, " << ncells << " cells, " << repeats << " repeats" << std::endl
+            << std::setw(44) << "[ns/cell]" << std::setw(14) << "max rel diff" << std::endl
+            << std::setw(34) << "three phase energy, separate" << std::setw(10) << t_sep << std::endl
+            << std::setw(34) << "three phase energy, fused" << std::setw(10) << t_fused << std::endl
+            << std::setw(34) << "three phase energy, Dual<14>" << std::setw(10) << t_ad
+            << std::setw(14) << diff_energy << std::endl
+            << std::setw(34) << "van Genuchten, WRMVanGenuchten" << std::setw(10) << t_vg_hand << std::endl
+            << std::setw(34) << "van Genuchten, Dual<1>" << std::setw(10) << t_vg_ad
+            << std::setw(14) << diff_vg << std::endl;
+  return 0;
+}
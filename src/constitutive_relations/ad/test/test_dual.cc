@@ -0,0 +1,98 @@
+/*
+  Derivatives from dual numbers, against analytic derivatives and finite
+  differences.
+*/
+
+#include <cmath>
+#include <UnitTest++.h>
+
+#include "Teuchos_ParameterList.hpp"
+
+#include "dual.hh"
+#include "evaporation_downregulation_ad_model.hh"
+#include "evaporation_downregulation_model.hh"
+
+using namespace Amanzi;
+
+TEST(DUAL_ARITHMETIC) {
+  typedef AD::Dual<2> D;
+  D x = D::variable(3., 0);
+  D y = D::variable(0.5, 1);
+
+  D f = (x*y + 2.*x - y/x) / (1. + y) - 4.;
+  double g = 1. + 0.5;
+  CHECK_CLOSE((3.*0.5 + 6. - 0.5/3.) / g - 4., f.value(), 1.e-14);
+  CHECK_CLOSE((0.5 + 2. + 0.5/9.) / g, f.d(0), 1.e-14);
+  CHECK_CLOSE((3. - 1./3.) / g - (3.*0.5 + 6. - 0.5/3.) / (g*g), f.d(1), 1.e-14);
+
+  D h = 1. / x - x;
+  CHECK_CLOSE(-1./9. - 1., h.d(0), 1.e-14);
+  CHECK_CLOSE(0., h.d(1), 1.e-14);
+
+  // comparisons act on values
+  CHECK(x > y);
+  CHECK(y < 1.);
+  CHECK(x == 3.);
+}
+
+
+TEST(DUAL_FUNCTIONS) {
+  typedef AD::Dual<1> D;
+  double x0 = 0.7;
+  D x = D::variable(x0, 0);
+
+  CHECK_CLOSE(std::exp(x0), exp(x).d(0), 1.e-14);
+  CHECK_CLOSE(1./x0, log(x).d(0), 1.e-14);
+  CHECK_CLOSE(0.5/std::sqrt(x0), sqrt(x).d(0), 1.e-14);
+  CHECK_CLOSE(2.5*std::pow(x0, 1.5), pow(x, 2.5).d(0), 1.e-14);
+  CHECK_CLOSE(std::pow(2., x0)*std::log(2.), pow(2., x).d(0), 1.e-14);
+  CHECK_CLOSE(std::pow(x0, x0)*(std::log(x0) + 1.), pow(x, x).d(0), 1.e-14);
+  CHECK_CLOSE(1., abs(-x).d(0), 1.e-14);
+  CHECK_CLOSE(1., fmax(x, D(0.5)).d(0), 1.e-14);
+  CHECK_CLOSE(0., fmin(x, D(0.5)).d(0), 1.e-14);
+
+  // no NaN from the value of a root of zero
+  D z = D::variable(0., 0);
+  CHECK_EQUAL(0., pow(z, 0.5).value());
+}
+
+
+TEST(DUAL_EVAPORATION_DOWNREGULATION) {
+  typedef AD::Dual<3> D;
+  Teuchos::ParameterList plist;
+  plist.set("dessicated zone thickness [m]", 0.05);
+  plist.set("Clapp and Hornberger b of surface soil [-]", 4.5);
+  SurfaceBalance::Relations::EvaporationDownregulationADModel model(plist);
+  SurfaceBalance::Relations::EvaporationDownregulationModel hand(plist);
+
+  double x0[3] = { 0.3, 0.45, 2.e-8 };
+  D x[3];
+  for (int k=0; k!=3; ++k) x[k] = D::variable(x0[k], k);
+  D e = model(x);
+  CHECK_CLOSE(model(x0), e.value(), 1.e-20);
+
+  // centered finite differences
+  for (int k=0; k!=3; ++k) {
+    double h = 1.e-6 * x0[k];
+    double xp[3] = { x0[0], x0[1], x0[2] };
+    double xm[3] = { x0[0], x0[1], x0[2] };
+    xp[k] += h;
+    xm[k] -= h;
+    double fd = (model(xp) - model(xm)) / (2*h);
+    CHECK_CLOSE(fd, e.d(k), 1.e-6 * std::abs(fd));
+  }
+
+  // the value and the derivative with respect to potential evaporation
+  // agree with the hand-written model
+  CHECK_CLOSE(hand.Evaporation(x0[0], x0[1], x0[2]), e.value(), 1.e-14 * e.value());
+  CHECK_CLOSE(hand.DEvaporationDPotentialEvaporation(x0[0], x0[1], x0[2]), e.d(2), 1.e-14 * e.d(2));
+
+  // the hand-written model takes the derivatives with respect to saturation
+  // of gas and porosity to be zero, the automatic ones do not
+  CHECK_EQUAL(0., hand.DEvaporationDSaturationGas(x0[0], x0[1], x0[2]));
+  CHECK_EQUAL(0., hand.DEvaporationDPorosity(x0[0], x0[1], x0[2]));
+  CHECK_CLOSE(1.6164851427189899e-10, e.value(), 1.e-12 * 1.6164851427189899e-10);
+  CHECK_CLOSE(-2.6756149432749095e-09, e.d(0), 1.e-12 * 2.6756149432749095e-09);
+  CHECK_CLOSE(1.4912131438540160e-09, e.d(1), 1.e-12 * 1.4912131438540160e-09);
+  CHECK_CLOSE(8.0824257135949495e-03, e.d(2), 1.e-12 * 8.0824257135949495e-03);
+}
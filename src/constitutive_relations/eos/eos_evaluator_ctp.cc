@@ -9,6 +9,7 @@
 
 #include "eos_factory.hh"
 #include "eos_evaluator_ctp.hh"
+#include "parallel_for.hh"
 
 namespace Amanzi {
 namespace Relations {
@@ -67,7 +68,6 @@ void EOSEvaluatorCTP::EvaluateField_(const Teuchos::Ptr<State>& S,
                          const std::vector<Teuchos::Ptr<CompositeVector> >& results) {
   
   int num_dep = dependencies_.size();  
-  std::vector<double> eos_params(num_dep);
 
   Teuchos::RCP<const CompositeVector> conc = S->GetFieldData(conc_key_);  
   Teuchos::RCP<const CompositeVector> temp = S->GetFieldData(temp_key_);
@@ -97,16 +97,19 @@ void EOSEvaluatorCTP::EvaluateField_(const Teuchos::Ptr<State>& S,
       Epetra_MultiVector& dens_v = *(molar_dens->ViewComponent(*comp,false));
 
       int count = dens_v.MyLength();
-      for (int id=0; id!=count; ++id) {
-
-        eos_params[0] = conc_v[0][id];        
-        eos_params[1] = temp_v[0][id];
-        eos_params[2] = pres_v[0][id];
-       
-        dens_v[0][id] = eos_sw_->MolarDensity(eos_params);
-        
-        AMANZI_ASSERT(dens_v[0][id] > 0.);
-      }
+      Threading::parallel_for_chunks(count, [&](int begin, int end) {
+          std::vector<double> params(num_dep);
+          for (int id=begin; id!=end; ++id) {
+            params[0] = conc_v[0][id];
+            params[1] = temp_v[0][id];
+            params[2] = pres_v[0][id];
+
+            dens_v[0][id] = eos_sw_->MolarDensity(params);
+          }
+        });
+#ifdef ENABLE_DBC
+      for (int id=0; id!=count; ++id) AMANZI_ASSERT(dens_v[0][id] > 0.);
+#endif
     }
   }
 
@@ -128,15 +131,19 @@ void EOSEvaluatorCTP::EvaluateField_(const Teuchos::Ptr<State>& S,
         Epetra_MultiVector& dens_v = *(mass_dens->ViewComponent(*comp,false));
 
         int count = dens_v.MyLength();
-        for (int id=0; id!=count; ++id) {
-
-          eos_params[0] = conc_v[0][id];        
-          eos_params[1] = temp_v[0][id];
-          eos_params[2] = pres_v[0][id];
-          
-          dens_v[0][id] = eos_sw_->MassDensity(eos_params);
-          AMANZI_ASSERT(dens_v[0][id] > 0.);
-        }
+        Threading::parallel_for_chunks(count, [&](int begin, int end) {
+            std::vector<double> params(num_dep);
+            for (int id=begin; id!=end; ++id) {
+              params[0] = conc_v[0][id];
+              params[1] = temp_v[0][id];
+              params[2] = pres_v[0][id];
+
+              dens_v[0][id] = eos_sw_->MassDensity(params);
+            }
+          });
+#ifdef ENABLE_DBC
+        for (int id=0; id!=count; ++id) AMANZI_ASSERT(dens_v[0][id] > 0.);
+#endif
       }
     }
   }
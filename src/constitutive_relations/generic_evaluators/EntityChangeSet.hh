@@ -0,0 +1,76 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! EntityChangeSet: the entities changed by the latest update of a field.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+/*!
+
+Evaluators know that a dependency has changed, but not where.  Evaluators
+which also know where implement ChangeSetProvider: each update of their
+field increments the id of their change set, and records either the owned
+entities that changed, or that all may have changed.
+
+A consumer remembers the id it last saw.  The entities recorded are the
+changes since then only if the id has been incremented by exactly one, and
+otherwise all entities must be assumed to have changed.
+
+*/
+
+#ifndef AMANZI_RELATIONS_ENTITY_CHANGE_SET_
+#define AMANZI_RELATIONS_ENTITY_CHANGE_SET_
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Amanzi {
+namespace Relations {
+
+struct EntityChangeSet {
+  EntityChangeSet() : id(0), all(true) {}
+
+  // Record a change of all entities.
+  void SetAll() {
+    ++id;
+    all = true;
+    entities.clear();
+  }
+
+  // Record a change of the given entities, sorting them.
+  void Set(std::map<std::string, std::vector<int> >& changed) {
+    ++id;
+    all = false;
+    entities.swap(changed);
+    changed.clear();
+    for (auto& comp : entities) {
+      std::sort(comp.second.begin(), comp.second.end());
+      comp.second.erase(std::unique(comp.second.begin(), comp.second.end()),
+                        comp.second.end());
+    }
+  }
+
+  int id;
+  bool all;
+
+  // sorted local ids of changed owned entities, by component
+  std::map<std::string, std::vector<int> > entities;
+};
+
+
+class ChangeSetProvider {
+ public:
+  virtual ~ChangeSetProvider() {}
+  virtual const EntityChangeSet& get_change_set() const = 0;
+};
+
+} // namespace
+} // namespace
+
+#endif
@@ -0,0 +1,451 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  FusedPointwiseEvaluator runs a chain of pointwise kernels in one sweep.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include <algorithm>
+#include <functional>
+#include <map>
+
+#include "errors.hh"
+#include "parallel_for.hh"
+
+#include "FusedPointwiseEvaluator.hh"
+#include "ProfiledFieldEvaluator.hh"
+
+namespace Amanzi {
+namespace Relations {
+
+FusedPointwiseEvaluator::FusedPointwiseEvaluator(Teuchos::ParameterList& plist) :
+    SecondaryVariablesFieldEvaluator(plist),
+    setup_(false),
+    evaluated_(false)
+{
+  InitializeFromPlist_();
+}
+
+
+FusedPointwiseEvaluator::FusedPointwiseEvaluator(const FusedPointwiseEvaluator& other) :
+    SecondaryVariablesFieldEvaluator(other),
+    kernels_(other.kernels_),
+    slot_keys_(other.slot_keys_),
+    n_deps_(other.n_deps_),
+    slot_output_(other.slot_output_),
+    slot_buffer_(other.slot_buffer_),
+    n_buffers_(other.n_buffers_),
+    kernel_args_(other.kernel_args_),
+    kernel_results_(other.kernel_results_),
+    tile_size_(other.tile_size_),
+    setup_(false),
+    incremental_(other.incremental_),
+    evaluated_(false),
+    change_request_(other.change_request_),
+    dep_change_ids_(other.dep_change_ids_.size(), -1) {}
+
+
+Teuchos::RCP<FieldEvaluator>
+FusedPointwiseEvaluator::Clone() const
+{
+  return Teuchos::rcp(new FusedPointwiseEvaluator(*this));
+}
+
+
+void
+FusedPointwiseEvaluator::operator=(const FieldEvaluator& other)
+{
+  SecondaryVariablesFieldEvaluator::operator=(other);
+
+  // the data is copied from the other state, after changes unknown here
+  evaluated_ = false;
+  changes_.SetAll();
+}
+
+
+void
+FusedPointwiseEvaluator::InitializeFromPlist_()
+{
+  Key akey = Keys::cleanPListName(plist_.name());
+  Key domain_name = Keys::getDomain(akey);
+  tile_size_ = plist_.get<int>("tile size", 256);
+  if (tile_size_ < 1) {
+    Errors::Message msg;
+    msg << "FusedPointwiseEvaluator for \"" << akey << "\": \"tile size\" must be positive.";
+    Exceptions::amanzi_throw(msg);
+  }
+
+  // create the kernels
+  if (!plist_.isSublist("kernels")) {
+    Errors::Message msg;
+    msg << "FusedPointwiseEvaluator for \"" << akey << "\": missing sublist \"kernels\".";
+    Exceptions::amanzi_throw(msg);
+  }
+  Teuchos::ParameterList& kernels_list = plist_.sublist("kernels");
+  PointwiseKernelFactory fac;
+  std::vector<Teuchos::RCP<PointwiseKernel> > kernels;
+  for (Teuchos::ParameterList::ConstIterator it=kernels_list.begin();
+       it!=kernels_list.end(); ++it) {
+    const std::string& name = kernels_list.name(it);
+    if (!kernels_list.isSublist(name)) {
+      Errors::Message msg;
+      msg << "FusedPointwiseEvaluator for \"" << akey << "\": kernel \"" << name
+          << "\" is not a sublist.";
+      Exceptions::amanzi_throw(msg);
+    }
+    Teuchos::ParameterList& kernel_plist = kernels_list.sublist(name);
+    if (!kernel_plist.isParameter("domain name")) kernel_plist.set("domain name", domain_name);
+    kernels.push_back(fac.createKernel(kernel_plist));
+  }
+  int nkernels = kernels.size();
+  if (nkernels == 0) {
+    Errors::Message msg;
+    msg << "FusedPointwiseEvaluator for \"" << akey << "\": no kernels.";
+    Exceptions::amanzi_throw(msg);
+  }
+
+  // the kernel computing each key, and the keys used by a kernel
+  std::map<Key,int> producer;
+  KeySet consumed;
+  for (int k=0; k!=nkernels; ++k) {
+    for (const auto& key : kernels[k]->results()) {
+      if (producer.count(key)) {
+        Errors::Message msg;
+        msg << "FusedPointwiseEvaluator for \"" << akey << "\": \"" << key
+            << "\" is computed by more than one kernel.";
+        Exceptions::amanzi_throw(msg);
+      }
+      producer[key] = k;
+    }
+    for (const auto& key : kernels[k]->arguments()) consumed.insert(key);
+  }
+
+  // order the kernels so that each follows those computing its arguments
+  std::vector<int> visited(nkernels, 0); // 0: no, 1: in progress, 2: done
+  std::vector<int> order;
+  std::function<void(int)> visit = [&](int k) {
+    if (visited[k] == 2) return;
+    if (visited[k] == 1) {
+      Errors::Message msg;
+      msg << "FusedPointwiseEvaluator for \"" << akey << "\": kernels form a cycle.";
+      Exceptions::amanzi_throw(msg);
+    }
+    visited[k] = 1;
+    for (const auto& key : kernels[k]->arguments()) {
+      auto p = producer.find(key);
+      if (p != producer.end()) visit(p->second);
+    }
+    visited[k] = 2;
+    order.push_back(k);
+  };
+  for (int k=0; k!=nkernels; ++k) visit(k);
+  for (int k : order) kernels_.push_back(kernels[k]);
+
+  // outputs, with this evaluator's name first
+  std::vector<Key> outputs;
+  if (plist_.isParameter("output keys")) {
+    Teuchos::Array<std::string> names = plist_.get<Teuchos::Array<std::string> >("output keys");
+    outputs.insert(outputs.end(), names.begin(), names.end());
+  } else {
+    for (const auto& kernel : kernels_) {
+      for (const auto& key : kernel->results()) {
+        if (!consumed.count(key)) outputs.push_back(key);
+      }
+    }
+  }
+  auto self = std::find(outputs.begin(), outputs.end(), akey);
+  if (self == outputs.end()) {
+    Errors::Message msg;
+    msg << "FusedPointwiseEvaluator for \"" << akey << "\": its own name is not an output key.";
+    Exceptions::amanzi_throw(msg);
+  }
+  std::rotate(outputs.begin(), self, self+1);
+  for (const auto& key : outputs) {
+    if (!producer.count(key)) {
+      Errors::Message msg;
+      msg << "FusedPointwiseEvaluator for \"" << akey << "\": output key \"" << key
+          << "\" is not computed by any kernel.";
+      Exceptions::amanzi_throw(msg);
+    }
+    my_keys_.push_back(key);
+  }
+
+  // slots: dependencies, then results in order
+  for (const auto& key : consumed) {
+    if (!producer.count(key)) {
+      dependencies_.insert(key);
+      slot_keys_.push_back(key);
+      slot_output_.push_back(-1);
+      slot_buffer_.push_back(-1);
+    }
+  }
+  n_deps_ = slot_keys_.size();
+
+  incremental_ = plist_.get<bool>("incremental evaluation", false);
+  change_request_ = akey + " change sets";
+  dep_change_ids_.resize(n_deps_, -1);
+
+  n_buffers_ = 0;
+  for (const auto& kernel : kernels_) {
+    for (const auto& key : kernel->results()) {
+      slot_keys_.push_back(key);
+      int j = std::find(my_keys_.begin(), my_keys_.end(), key) - my_keys_.begin();
+      if (j != my_keys_.size()) {
+        slot_output_.push_back(j);
+        slot_buffer_.push_back(-1);
+      } else {
+        slot_output_.push_back(-1);
+        slot_buffer_.push_back(n_buffers_++);
+      }
+    }
+  }
+
+  for (const auto& kernel : kernels_) {
+    std::vector<int> args, results;
+    for (const auto& key : kernel->arguments()) {
+      args.push_back(std::find(slot_keys_.begin(), slot_keys_.end(), key) - slot_keys_.begin());
+    }
+    for (const auto& key : kernel->results()) {
+      results.push_back(std::find(slot_keys_.begin(), slot_keys_.end(), key) - slot_keys_.begin());
+    }
+    kernel_args_.push_back(args);
+    kernel_results_.push_back(results);
+  }
+}
+
+
+void
+FusedPointwiseEvaluator::Setup_(const CompositeVector& result)
+{
+  if (setup_) return;
+  std::vector<std::string> comps(result.begin(), result.end());
+  for (const auto& kernel : kernels_) kernel->Setup(result.Mesh(), comps);
+  setup_ = true;
+}
+
+
+bool
+FusedPointwiseEvaluator::ChangedEntities_(const Teuchos::Ptr<State>& S,
+        std::map<std::string, std::vector<int> >& changed)
+{
+  if (!incremental_) return false;
+
+  // Every dependency is checked, so that the changes seen are up to date.
+  // The private request tells whether a dependency changed at all, and the
+  // id of its change set whether its entities are the changes since then.
+  bool sparse = evaluated_;
+  for (int s=0; s!=n_deps_; ++s) {
+    Teuchos::RCP<FieldEvaluator> fe = S->GetFieldEvaluator(slot_keys_[s]);
+    bool dep_changed = fe->HasFieldChanged(S, change_request_);
+    const ChangeSetProvider* provider = dynamic_cast<const ChangeSetProvider*>(get_wrapped(fe).get());
+    int id = provider ? provider->get_change_set().id : -1;
+
+    if (dep_changed || id != dep_change_ids_[s]) {
+      if (provider && id == dep_change_ids_[s] + 1 && !provider->get_change_set().all) {
+        for (const auto& comp : provider->get_change_set().entities) {
+          std::vector<int>& ids = changed[comp.first];
+          ids.insert(ids.end(), comp.second.begin(), comp.second.end());
+        }
+      } else {
+        sparse = false;
+      }
+    }
+    dep_change_ids_[s] = id;
+  }
+
+  for (auto& comp : changed) {
+    std::sort(comp.second.begin(), comp.second.end());
+    comp.second.erase(std::unique(comp.second.begin(), comp.second.end()), comp.second.end());
+  }
+  return sparse;
+}
+
+
+void
+FusedPointwiseEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
+        const std::vector<Teuchos::Ptr<CompositeVector> >& results)
+{
+  Setup_(*results[0]);
+  int nslots = slot_keys_.size();
+  int nkernels = kernels_.size();
+  int tile = tile_size_;
+
+  std::map<std::string, std::vector<int> > changed;
+  bool sparse = ChangedEntities_(S, changed);
+
+  for (CompositeVector::name_iterator comp=results[0]->begin();
+       comp!=results[0]->end(); ++comp) {
+    std::vector<double*> base(nslots, NULL);
+    for (int s=0; s!=n_deps_; ++s) {
+      base[s] = const_cast<double*>((*S->GetFieldData(slot_keys_[s])->ViewComponent(*comp, false))[0]);
+    }
+    for (int s=n_deps_; s!=nslots; ++s) {
+      if (slot_output_[s] >= 0) base[s] = (*results[slot_output_[s]]->ViewComponent(*comp, false))[0];
+    }
+
+    // all kernels on the entities [begin, end), a tile at a time
+    auto evaluate = [&](int begin, int end, std::vector<double>& work,
+                        std::vector<double*>& ptr, std::vector<const double*>& args,
+                        std::vector<double*>& res) {
+      for (int t0=begin; t0 < end; t0 += tile) {
+        int m = std::min(tile, end - t0);
+        for (int s=0; s!=nslots; ++s) {
+          ptr[s] = slot_buffer_[s] >= 0 ? &work[slot_buffer_[s] * tile] : base[s] + t0;
+        }
+
+        for (int k=0; k!=nkernels; ++k) {
+          args.clear();
+          res.clear();
+          for (int s : kernel_args_[k]) args.push_back(ptr[s]);
+          for (int s : kernel_results_[k]) res.push_back(ptr[s]);
+          kernels_[k]->Evaluate(*comp, t0, m, args.data(), res.data());
+        }
+      }
+    };
+
+    // once a component is recomputed entirely, the rest are too
+    int n = results[0]->size(*comp, false);
+    const std::vector<int>& ids = changed[*comp];
+    if (sparse && 2 * (int) ids.size() > n) sparse = false;
+
+    if (sparse) {
+      // runs of consecutive changed entities
+      Threading::parallel_for_chunks((int) ids.size(), [&](int begin, int end) {
+          std::vector<double> work(n_buffers_ * tile);
+          std::vector<double*> ptr(nslots);
+          std::vector<const double*> args;
+          std::vector<double*> res;
+
+          int i = begin;
+          while (i < end) {
+            int j = i + 1;
+            while (j < end && ids[j] == ids[j-1] + 1) ++j;
+            evaluate(ids[i], ids[j-1] + 1, work, ptr, args, res);
+            i = j;
+          }
+        });
+    } else {
+      Threading::parallel_for_chunks(n, [&](int begin, int end) {
+          std::vector<double> work(n_buffers_ * tile);
+          std::vector<double*> ptr(nslots);
+          std::vector<const double*> args;
+          std::vector<double*> res;
+          evaluate(begin, end, work, ptr, args, res);
+        });
+    }
+  }
+
+  if (sparse) {
+    changes_.Set(changed);
+  } else {
+    changes_.SetAll();
+  }
+  evaluated_ = true;
+}
+
+
+void
+FusedPointwiseEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
+        Key wrt_key, const std::vector<Teuchos::Ptr<CompositeVector> >& results)
+{
+  Setup_(*results[0]);
+  int nslots = slot_keys_.size();
+  int nresults = nslots - n_deps_;
+  int nkernels = kernels_.size();
+  int tile = tile_size_;
+
+  int wrt = std::find(slot_keys_.begin(), slot_keys_.begin() + n_deps_, wrt_key)
+      - slot_keys_.begin();
+  AMANZI_ASSERT(wrt < n_deps_);
+
+  int njac = 0;
+  for (int k=0; k!=nkernels; ++k) {
+    njac = std::max(njac, (int) (kernel_args_[k].size() * kernel_results_[k].size()));
+  }
+
+  for (CompositeVector::name_iterator comp=results[0]->begin();
+       comp!=results[0]->end(); ++comp) {
+    std::vector<const double*> deps(n_deps_);
+    for (int s=0; s!=n_deps_; ++s) {
+      deps[s] = (*S->GetFieldData(slot_keys_[s])->ViewComponent(*comp, false))[0];
+    }
+    std::vector<double*> dresults(my_keys_.size());
+    for (int j=0; j!=my_keys_.size(); ++j) {
+      dresults[j] = (*results[j]->ViewComponent(*comp, false))[0];
+    }
+
+    int n = results[0]->size(*comp, false);
+    Threading::parallel_for_chunks(n, [&](int begin, int end) {
+        // values and derivatives of all results with respect to wrt, where
+        // a NULL derivative is zero
+        std::vector<double> work((2*nresults + njac + 1) * tile);
+        double* values = &work[0];
+        double* tangents = &work[nresults * tile];
+        double* jac_work = &work[2 * nresults * tile];
+        double* ones = &work[(2*nresults + njac) * tile];
+        std::fill(ones, ones + tile, 1.);
+
+        std::vector<double*> val(nslots), tan(nslots);
+        std::vector<double*> jac(njac);
+        for (int i=0; i!=njac; ++i) jac[i] = jac_work + i * tile;
+        std::vector<const double*> args;
+        std::vector<double*> res;
+
+        for (int t0=begin; t0 < end; t0 += tile) {
+          int m = std::min(tile, end - t0);
+          for (int s=0; s!=n_deps_; ++s) {
+            val[s] = const_cast<double*>(deps[s]) + t0;
+            tan[s] = s == wrt ? ones : NULL;
+          }
+          for (int s=n_deps_; s!=nslots; ++s) {
+            val[s] = values + (s - n_deps_) * tile;
+          }
+
+          for (int k=0; k!=nkernels; ++k) {
+            const std::vector<int>& kargs = kernel_args_[k];
+            const std::vector<int>& kres = kernel_results_[k];
+            int nargs = kargs.size();
+            args.clear();
+            res.clear();
+            for (int s : kargs) args.push_back(val[s]);
+            for (int s : kres) res.push_back(val[s]);
+
+            bool depends = false;
+            for (int s : kargs) depends |= tan[s] != NULL;
+            if (!depends) {
+              kernels_[k]->Evaluate(*comp, t0, m, args.data(), res.data());
+              for (int s : kres) tan[s] = NULL;
+              continue;
+            }
+
+            kernels_[k]->EvaluateWithDerivatives(*comp, t0, m, args.data(), res.data(), jac.data());
+            for (int r=0; r!=kres.size(); ++r) {
+              int s = kres[r];
+              double* t = slot_output_[s] >= 0 ? dresults[slot_output_[s]] + t0
+                  : tangents + (s - n_deps_) * tile;
+              for (int i=0; i!=m; ++i) t[i] = 0.;
+              for (int a=0; a!=nargs; ++a) {
+                const double* ta = tan[kargs[a]];
+                if (ta == NULL) continue;
+                const double* dra = jac[r*nargs + a];
+                for (int i=0; i!=m; ++i) t[i] += dra[i] * ta[i];
+              }
+              tan[s] = t;
+            }
+          }
+
+          // outputs independent of wrt
+          for (int s=n_deps_; s!=nslots; ++s) {
+            if (slot_output_[s] >= 0 && tan[s] == NULL) {
+              double* t = dresults[slot_output_[s]] + t0;
+              for (int i=0; i!=m; ++i) t[i] = 0.;
+            }
+          }
+        }
+      });
+  }
+}
+
+} // namespace
+} // namespace
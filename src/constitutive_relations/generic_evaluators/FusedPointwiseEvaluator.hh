@@ -0,0 +1,156 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! FusedPointwiseEvaluator runs a chain of pointwise kernels in one sweep.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+/*!
+
+Chains of pointwise evaluators, e.g. capillary pressure to saturation to
+relative permeability, otherwise each sweep over all entities, reading
+their dependencies from and writing their results to memory.  This
+evaluator holds a set of pointwise kernels (see PointwiseKernel), ordered
+so that each kernel follows those computing its arguments.  Entities are
+processed in tiles: on each tile all kernels are run in order, results
+used only within the chain are kept in per-tile buffers, and only the
+output keys are written to State.
+
+Arguments of the kernels not computed by another kernel are the
+dependencies of this evaluator.  Results of the kernels not listed as
+output keys do not exist in State, so any result used by another
+evaluator, or needed for vis or checkpointing, must be listed.
+
+Partial derivatives with respect to a dependency are propagated through the
+chain by the chain rule, a tile at a time.
+
+When only a few entities change, e.g. at a wet/dry or freeze/thaw front or
+in one column, incremental evaluation recomputes only the entities where a
+dependency changed.  This requires the dependencies to know where they
+changed (see EntityChangeSet), as primary variables `"primary variable with
+change sets`" and fused evaluators do.  Where this is not known, or more
+than half of the entities changed, all are recomputed.  The entities
+recomputed are in turn known to evaluators using the results.
+
+* `"kernels`" ``[pointwise-kernel-spec-list]`` Each sublist is one kernel,
+  with its `"kernel type`" and parameters.  Keys of the kernels default to
+  the domain of this evaluator.
+
+* `"output keys`" ``[Array(string)]`` **results not used by another kernel**
+  Results written to State, including the name of this evaluator.
+
+* `"tile size`" ``[int]`` **256** Number of entities per tile.
+
+* `"incremental evaluation`" ``[bool]`` **false** Recompute only the
+  entities where a dependency changed, when known.
+
+Example, which computes relative permeability without writing gas
+saturation, or reading saturation back:
+
+.. code-block:: xml
+
+    <ParameterList name="saturation_liquid" type="ParameterList">
+      <Parameter name="field evaluator type" type="string" value="fused pointwise" />
+      <Parameter name="output keys" type="Array(string)" value="{saturation_liquid, relative_permeability}" />
+      <ParameterList name="kernels" type="ParameterList">
+        <ParameterList name="saturation" type="ParameterList">
+          <Parameter name="kernel type" type="string" value="WRM saturation" />
+          <ParameterList name="WRM parameters" type="ParameterList">
+            ...
+          </ParameterList>
+        </ParameterList>
+        <ParameterList name="relative permeability" type="ParameterList">
+          <Parameter name="kernel type" type="string" value="WRM relative permeability" />
+          <Parameter name="permeability rescaling" type="double" value="1.e7" />
+          <ParameterList name="WRM parameters" type="ParameterList">
+            ...
+          </ParameterList>
+        </ParameterList>
+      </ParameterList>
+    </ParameterList>
+
+*/
+
+#ifndef AMANZI_RELATIONS_FUSED_POINTWISE_EVALUATOR_
+#define AMANZI_RELATIONS_FUSED_POINTWISE_EVALUATOR_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Factory.hh"
+#include "secondary_variables_field_evaluator.hh"
+
+#include "EntityChangeSet.hh"
+#include "PointwiseKernel.hh"
+
+namespace Amanzi {
+namespace Relations {
+
+class FusedPointwiseEvaluator : public SecondaryVariablesFieldEvaluator,
+                                public ChangeSetProvider {
+
+ public:
+  explicit
+  FusedPointwiseEvaluator(Teuchos::ParameterList& plist);
+  FusedPointwiseEvaluator(const FusedPointwiseEvaluator& other);
+
+  virtual Teuchos::RCP<FieldEvaluator> Clone() const;
+  virtual void operator=(const FieldEvaluator& other);
+
+  // kernels, in the order they are run
+  const std::vector<Teuchos::RCP<PointwiseKernel> >& get_kernels() { return kernels_; }
+
+  // entities recomputed by the last evaluation
+  virtual const EntityChangeSet& get_change_set() const { return changes_; }
+
+ protected:
+  void InitializeFromPlist_();
+  void Setup_(const CompositeVector& result);
+
+  // Entities where a dependency changed since the last evaluation, or false
+  // if all may have.
+  bool ChangedEntities_(const Teuchos::Ptr<State>& S,
+                        std::map<std::string, std::vector<int> >& changed);
+
+  // Required methods from SecondaryVariablesFieldEvaluator
+  virtual void EvaluateField_(const Teuchos::Ptr<State>& S,
+          const std::vector<Teuchos::Ptr<CompositeVector> >& results);
+  virtual void EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
+          Key wrt_key, const std::vector<Teuchos::Ptr<CompositeVector> >& results);
+
+ protected:
+  std::vector<Teuchos::RCP<PointwiseKernel> > kernels_;
+
+  // Each key of the chain is a slot: the dependencies first, then the
+  // results of each kernel in order.
+  std::vector<Key> slot_keys_;
+  int n_deps_;
+  std::vector<int> slot_output_;  // index in my_keys_, or -1
+  std::vector<int> slot_buffer_;  // index of its tile buffer, or -1
+  int n_buffers_;
+  std::vector<std::vector<int> > kernel_args_;  // slots of each kernel
+  std::vector<std::vector<int> > kernel_results_;
+
+  int tile_size_;
+  bool setup_;
+
+  // incremental evaluation
+  bool incremental_;
+  bool evaluated_;
+  Key change_request_;
+  std::vector<int> dep_change_ids_;
+  EntityChangeSet changes_;
+
+ private:
+  static Utils::RegisteredFactory<FieldEvaluator,FusedPointwiseEvaluator> factory_;
+};
+
+} // namespace
+} // namespace
+
+#endif
@@ -0,0 +1,18 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  FusedPointwiseEvaluator runs a chain of pointwise kernels in one sweep.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include "FusedPointwiseEvaluator.hh"
+
+namespace Amanzi {
+namespace Relations {
+
+// registry of method
+Utils::RegisteredFactory<FieldEvaluator,FusedPointwiseEvaluator> FusedPointwiseEvaluator::factory_("fused pointwise");
+
+} // namespace
+} // namespace
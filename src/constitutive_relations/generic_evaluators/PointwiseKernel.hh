@@ -0,0 +1,88 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! PointwiseKernel: a model evaluated entity by entity, for fusion into chains.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+/*!
+
+A pointwise kernel computes one or more results on each entity from its
+arguments on the same entity only, e.g. saturation from capillary pressure.
+Unlike an evaluator, it does not own its results and works on a range of
+entities of contiguous arrays, so that a FusedPointwiseEvaluator may run a
+chain of kernels on a small tile of entities before moving on to the next.
+
+Kernels are created by PointwiseKernelFactory from a `"kernel type`", and
+read their argument and result keys from their parameter list, defaulting
+to keys in `"domain name`".
+
+*/
+
+#ifndef AMANZI_RELATIONS_POINTWISE_KERNEL_
+#define AMANZI_RELATIONS_POINTWISE_KERNEL_
+
+#include <string>
+#include <vector>
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+
+#include "Key.hh"
+#include "Mesh.hh"
+#include "Factory.hh"
+
+namespace Amanzi {
+namespace Relations {
+
+class PointwiseKernel {
+
+ public:
+  explicit
+  PointwiseKernel(Teuchos::ParameterList& plist) :
+      plist_(plist),
+      domain_(plist.get<std::string>("domain name", "")) {}
+  virtual ~PointwiseKernel() {}
+
+  const std::vector<Key>& arguments() const { return args_; }
+  const std::vector<Key>& results() const { return results_; }
+
+  // Called before evaluation, once the mesh and components of the results
+  // are known.  Kernels throw on components they cannot evaluate.
+  virtual void Setup(const Teuchos::RCP<const AmanziMesh::Mesh>& mesh,
+                     const std::vector<std::string>& components) {}
+
+  // Results on the n entities [begin, begin+n) of component comp, where
+  // args[a][i] and results[r][i] are on entity begin+i.
+  virtual void Evaluate(const std::string& comp, int begin, int n,
+                        const double* const* args, double* const* results) = 0;
+
+  // Results and their partial derivatives, jac[r*nargs + a][i] being the
+  // derivative of result r with respect to argument a on entity begin+i.
+  virtual void EvaluateWithDerivatives(const std::string& comp, int begin, int n,
+          const double* const* args, double* const* results, double* const* jac) = 0;
+
+ protected:
+  Teuchos::ParameterList plist_;
+  Key domain_;
+  std::vector<Key> args_;
+  std::vector<Key> results_;
+};
+
+
+class PointwiseKernelFactory : public Utils::Factory<PointwiseKernel> {
+ public:
+  Teuchos::RCP<PointwiseKernel> createKernel(Teuchos::ParameterList& plist) {
+    std::string kernel_typename = plist.get<std::string>("kernel type");
+    return Teuchos::rcp(CreateInstance(kernel_typename, plist));
+  }
+};
+
+} // namespace
+} // namespace
+
+#endif
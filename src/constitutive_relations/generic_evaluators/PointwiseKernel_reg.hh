@@ -0,0 +1,16 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+/* -------------------------------------------------------------------------
+
+   ATS
+   Author: Ethan Coon
+
+   Self-registering factory for pointwise kernels.
+   ------------------------------------------------------------------------- */
+
+#include "PointwiseKernel.hh"
+
+// explicity instantitate the static data of Factory<PointwiseKernel>
+template<>
+Amanzi::Utils::Factory<Amanzi::Relations::PointwiseKernel>::map_type*
+Amanzi::Utils::Factory<Amanzi::Relations::PointwiseKernel>::map_;
+
@@ -0,0 +1,54 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  A primary variable evaluator which records the entities changed.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include "PrimaryVariableChangeSetEvaluator.hh"
+
+namespace Amanzi {
+namespace Relations {
+
+PrimaryVariableChangeSetEvaluator::PrimaryVariableChangeSetEvaluator(Teuchos::ParameterList& plist) :
+    PrimaryVariableFieldEvaluator(plist) {}
+
+
+PrimaryVariableChangeSetEvaluator::PrimaryVariableChangeSetEvaluator(
+        const PrimaryVariableChangeSetEvaluator& other) :
+    PrimaryVariableFieldEvaluator(other),
+    changes_(other.changes_) {}
+
+
+Teuchos::RCP<FieldEvaluator>
+PrimaryVariableChangeSetEvaluator::Clone() const
+{
+  return Teuchos::rcp(new PrimaryVariableChangeSetEvaluator(*this));
+}
+
+
+void
+PrimaryVariableChangeSetEvaluator::operator=(const FieldEvaluator& other)
+{
+  PrimaryVariableFieldEvaluator::operator=(other);
+
+  // the data is copied from the other state
+  marked_.clear();
+  changes_.SetAll();
+}
+
+
+void
+PrimaryVariableChangeSetEvaluator::SetFieldAsChanged(const Teuchos::Ptr<State>& S)
+{
+  if (marked_.empty()) {
+    changes_.SetAll();
+  } else {
+    changes_.Set(marked_);
+  }
+  PrimaryVariableFieldEvaluator::SetFieldAsChanged(S);
+}
+
+} // namespace
+} // namespace
@@ -0,0 +1,79 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! A primary variable evaluator which records the entities changed.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+/*!
+
+A primary variable evaluator, which is also a ChangeSetProvider (see
+EntityChangeSet).  Code modifying the variable on a subset of entities marks
+them before calling SetFieldAsChanged(), which then records only those as
+changed.  Without marks, or when the field is copied from another state,
+all entities are recorded as changed, so code unaware of marks is correct.
+
+.. code-block:: c++
+
+    auto pv = Teuchos::rcp_dynamic_cast<Relations::PrimaryVariableChangeSetEvaluator>(fe);
+    pv->MarkChanged("cell", modified_cells);
+    pv->SetFieldAsChanged(S);
+
+It is created with `"field evaluator type`" `"primary variable with change
+sets`", and may be used wherever a primary variable is, as it is one.
+
+*/
+
+#ifndef AMANZI_RELATIONS_PRIMARY_VARIABLE_CHANGE_SET_EVALUATOR_
+#define AMANZI_RELATIONS_PRIMARY_VARIABLE_CHANGE_SET_EVALUATOR_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Factory.hh"
+#include "primary_variable_field_evaluator.hh"
+
+#include "EntityChangeSet.hh"
+
+namespace Amanzi {
+namespace Relations {
+
+class PrimaryVariableChangeSetEvaluator : public PrimaryVariableFieldEvaluator,
+                                          public ChangeSetProvider {
+
+ public:
+  explicit
+  PrimaryVariableChangeSetEvaluator(Teuchos::ParameterList& plist);
+  PrimaryVariableChangeSetEvaluator(const PrimaryVariableChangeSetEvaluator& other);
+
+  virtual Teuchos::RCP<FieldEvaluator> Clone() const;
+  virtual void operator=(const FieldEvaluator& other);
+
+  // Mark owned entities of component comp as changed by the next
+  // SetFieldAsChanged().  An empty list marks that none did.
+  void MarkChanged(const std::string& comp, const std::vector<int>& entities) {
+    std::vector<int>& marked = marked_[comp];
+    marked.insert(marked.end(), entities.begin(), entities.end());
+  }
+
+  virtual void SetFieldAsChanged(const Teuchos::Ptr<State>& S);
+
+  virtual const EntityChangeSet& get_change_set() const { return changes_; }
+
+ protected:
+  std::map<std::string, std::vector<int> > marked_;
+  EntityChangeSet changes_;
+
+ private:
+  static Utils::RegisteredFactory<FieldEvaluator,PrimaryVariableChangeSetEvaluator> factory_;
+};
+
+} // namespace
+} // namespace
+
+#endif
@@ -0,0 +1,18 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  A primary variable evaluator which records the entities changed.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include "PrimaryVariableChangeSetEvaluator.hh"
+
+namespace Amanzi {
+namespace Relations {
+
+// registry of method
+Utils::RegisteredFactory<FieldEvaluator,PrimaryVariableChangeSetEvaluator> PrimaryVariableChangeSetEvaluator::factory_("primary variable with change sets");
+
+} // namespace
+} // namespace
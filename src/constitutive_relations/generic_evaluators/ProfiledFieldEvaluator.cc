@@ -0,0 +1,361 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  ProfiledFieldEvaluator counts and times the updates of another evaluator.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+
+#include "Teuchos_Time.hpp"
+#include "Epetra_Comm.h"
+#include "Epetra_MultiVector.h"
+
+#include "errors.hh"
+#include "CompositeVector.hh"
+#include "State.hh"
+#include "FieldEvaluator_Factory.hh"
+
+#include "ProfiledFieldEvaluator.hh"
+
+namespace Amanzi {
+namespace Relations {
+
+namespace {
+
+// Time spent in the profiled evaluators called from the current one.
+inline double& nested_time() { static thread_local double time = 0.; return time; }
+
+// Adds the time spent in a scope, less that of nested scopes, to a record.
+class ScopedTimer {
+ public:
+  explicit
+  ScopedTimer(double& time) :
+      time_(time),
+      start_(Teuchos::Time::wallTime()),
+      outer_nested_(nested_time()) {
+    nested_time() = 0.;
+  }
+
+  ~ScopedTimer() {
+    double elapsed = Teuchos::Time::wallTime() - start_;
+    time_ += elapsed - nested_time();
+    nested_time() = outer_nested_ + elapsed;
+  }
+
+ private:
+  double& time_;
+  double start_;
+  double outer_nested_;
+};
+
+bool compare_name(const Teuchos::RCP<EvaluatorProfile>& a,
+                  const Teuchos::RCP<EvaluatorProfile>& b) {
+  return a->name < b->name;
+}
+
+bool compare_time(const Teuchos::RCP<EvaluatorProfile>& a,
+                  const Teuchos::RCP<EvaluatorProfile>& b) {
+  return a->time > b->time;
+}
+
+} // namespace
+
+
+ProfiledFieldEvaluator::ProfiledFieldEvaluator(Teuchos::ParameterList& plist) :
+    FieldEvaluator(plist)
+{
+  if (!plist_.isParameter("profiled evaluator type")) {
+    Errors::Message msg;
+    msg << "ProfiledFieldEvaluator for \"" << plist_.name()
+        << "\": missing parameter \"profiled evaluator type\".";
+    Exceptions::amanzi_throw(msg);
+  }
+
+  Teuchos::ParameterList eval_plist(plist_);
+  eval_plist.set("field evaluator type", plist_.get<std::string>("profiled evaluator type"));
+  eval_plist.remove("profiled evaluator type");
+  FieldEvaluatorFactory fac;
+  evaluator_ = fac.createFieldEvaluator(eval_plist);
+
+  profile_ = Teuchos::rcp(new EvaluatorProfile(plist_.name()));
+  profiles_().push_back(profile_);
+  probe_request_ = plist_.name() + " profile";
+}
+
+
+ProfiledFieldEvaluator::ProfiledFieldEvaluator(const ProfiledFieldEvaluator& other) :
+    FieldEvaluator(other),
+    evaluator_(other.evaluator_->Clone()),
+    profile_(other.profile_),
+    probe_request_(other.probe_request_),
+    my_keys_(other.my_keys_),
+    last_(other.last_) {}
+
+
+Teuchos::RCP<FieldEvaluator>
+ProfiledFieldEvaluator::Clone() const
+{
+  return Teuchos::rcp(new ProfiledFieldEvaluator(*this));
+}
+
+
+void
+ProfiledFieldEvaluator::operator=(const FieldEvaluator& other)
+{
+  if (this != &other) {
+    const ProfiledFieldEvaluator* other_p =
+        dynamic_cast<const ProfiledFieldEvaluator*>(&other);
+    if (other_p) {
+      *evaluator_ = *other_p->evaluator_;
+      last_ = other_p->last_;
+    } else {
+      *evaluator_ = other;
+    }
+  }
+}
+
+
+bool
+ProfiledFieldEvaluator::HasFieldChanged(const Teuchos::Ptr<State>& S, Key request)
+{
+  profile_->queries++;
+
+  // Every update goes through this evaluator, so the private request has
+  // changed if and only if the field was recomputed since the last query.
+  // Updating it first also times the recompute here.
+  bool recomputed, changed;
+  {
+    ScopedTimer timer(profile_->time);
+    recomputed = evaluator_->HasFieldChanged(S, probe_request_);
+    changed = evaluator_->HasFieldChanged(S, request);
+  }
+  if (recomputed) RecordRecompute_(S);
+  return changed;
+}
+
+
+bool
+ProfiledFieldEvaluator::HasFieldDerivativeChanged(const Teuchos::Ptr<State>& S,
+        Key request, Key wrt_key)
+{
+  profile_->derivative_queries++;
+
+  bool recomputed, changed;
+  {
+    ScopedTimer timer(profile_->time);
+    recomputed = evaluator_->HasFieldChanged(S, probe_request_);
+    changed = evaluator_->HasFieldDerivativeChanged(S, request, wrt_key);
+  }
+  if (recomputed) RecordRecompute_(S);
+  return changed;
+}
+
+
+bool
+ProfiledFieldEvaluator::IsDependency(const Teuchos::Ptr<State>& S, Key key) const
+{
+  return evaluator_->IsDependency(S, key);
+}
+
+
+bool
+ProfiledFieldEvaluator::ProvidesKey(Key key) const
+{
+  return evaluator_->ProvidesKey(key);
+}
+
+
+void
+ProfiledFieldEvaluator::EnsureCompatibility(const Teuchos::Ptr<State>& S)
+{
+  evaluator_->EnsureCompatibility(S);
+}
+
+
+std::string
+ProfiledFieldEvaluator::WriteToString() const
+{
+  return "Profiled " + evaluator_->WriteToString();
+}
+
+
+void
+ProfiledFieldEvaluator::RecordRecompute_(const Teuchos::Ptr<State>& S)
+{
+  // The copy and comparison are not the evaluator's work, and are excluded
+  // from the time of the evaluators calling it too.
+  double overhead = 0.;
+  ScopedTimer timer(overhead);
+
+  profile_->recomputes++;
+
+  if (my_keys_.empty()) {
+    for (State::field_iterator field=S->field_begin(); field!=S->field_end(); ++field) {
+      if (evaluator_->ProvidesKey(field->first)) my_keys_.push_back(field->first);
+    }
+  }
+
+  bool identical = !my_keys_.empty() && last_.size() == my_keys_.size();
+  last_.resize(my_keys_.size());
+  for (int k=0; k!=my_keys_.size(); ++k) {
+    std::vector<double> values;
+    Teuchos::RCP<const CompositeVector> cv = S->GetFieldData(my_keys_[k]);
+    for (CompositeVector::name_iterator comp=cv->begin(); comp!=cv->end(); ++comp) {
+      const Epetra_MultiVector& vec = *cv->ViewComponent(*comp, false);
+      for (int j=0; j!=vec.NumVectors(); ++j) {
+        values.insert(values.end(), vec[j], vec[j] + vec.MyLength());
+      }
+    }
+
+    // bitwise, so that NaNs compare equal to themselves
+    identical = identical && values.size() == last_[k].size() &&
+        (values.empty() ||
+         std::memcmp(&values[0], &last_[k][0], values.size()*sizeof(double)) == 0);
+    last_[k].swap(values);
+  }
+  if (identical) profile_->identical++;
+}
+
+
+void
+ProfiledFieldEvaluator::ProfileEvaluators(Teuchos::ParameterList& fe_list,
+        const std::vector<std::string>& keys,
+        const std::vector<std::string>& excluded_keys)
+{
+  bool all = std::find(keys.begin(), keys.end(), "*") != keys.end();
+  if (!all) {
+    for (std::vector<std::string>::const_iterator key=keys.begin(); key!=keys.end(); ++key) {
+      if (!fe_list.isSublist(*key)) {
+        Errors::Message msg;
+        msg << "Cannot profile evaluator \"" << *key
+            << "\", which is not in the field evaluators list.";
+        Exceptions::amanzi_throw(msg);
+      }
+    }
+  }
+
+  for (Teuchos::ParameterList::ConstIterator entry=fe_list.begin();
+       entry!=fe_list.end(); ++entry) {
+    const std::string& key = fe_list.name(entry);
+    if (!fe_list.isSublist(key)) continue;
+    if (!all && std::find(keys.begin(), keys.end(), key) == keys.end()) continue;
+    if (std::find(excluded_keys.begin(), excluded_keys.end(), key) != excluded_keys.end()) continue;
+
+    Teuchos::ParameterList& sublist = fe_list.sublist(key);
+    if (!sublist.isParameter("field evaluator type")) continue;
+    std::string type = sublist.get<std::string>("field evaluator type");
+    if (type == "primary variable" || type == "primary variable with change sets" ||
+        type == "profiled") continue;
+
+    sublist.set("profiled evaluator type", type);
+    sublist.set("field evaluator type", "profiled");
+  }
+}
+
+
+void
+ProfiledFieldEvaluator::WriteProfiles(const Epetra_Comm& comm, std::ostream& os,
+        bool write)
+{
+  // Records are matched across processes by name.  Evaluators are created
+  // from the same list on all processes, so all have the same records.
+  std::vector<Teuchos::RCP<EvaluatorProfile> > local(profiles_());
+  std::stable_sort(local.begin(), local.end(), compare_name);
+
+  int n_local = local.size(), n_min(0), n_max(0);
+  comm.MinAll(&n_local, &n_min, 1);
+  comm.MaxAll(&n_local, &n_max, 1);
+  if (n_min != n_max) {
+    Errors::Message msg("ProfiledFieldEvaluator: processes have different numbers of profiled evaluators.");
+    Exceptions::amanzi_throw(msg);
+  }
+
+  // counts are summed over processes, and times are the max, i.e. those of
+  // the slowest process
+  int n = n_local;
+  std::vector<int> counts_l(4*n), counts(4*n, 0);
+  std::vector<double> times_l(n+1, 0.), times(n+1, 0.);
+  for (int i=0; i!=n; ++i) {
+    counts_l[4*i] = local[i]->queries;
+    counts_l[4*i+1] = local[i]->derivative_queries;
+    counts_l[4*i+2] = local[i]->recomputes;
+    counts_l[4*i+3] = local[i]->identical;
+    times_l[i] = local[i]->time;
+    times_l[n] += local[i]->time;
+  }
+  if (n > 0) comm.SumAll(&counts_l[0], &counts[0], 4*n);
+  comm.MaxAll(&times_l[0], &times[0], n+1);
+  if (!write) return;
+
+  std::vector<Teuchos::RCP<EvaluatorProfile> > profiles(n);
+  for (int i=0; i!=n; ++i) {
+    profiles[i] = Teuchos::rcp(new EvaluatorProfile(local[i]->name));
+    profiles[i]->queries = counts[4*i];
+    profiles[i]->derivative_queries = counts[4*i+1];
+    profiles[i]->recomputes = counts[4*i+2];
+    profiles[i]->identical = counts[4*i+3];
+    profiles[i]->time = times[i];
+  }
+  std::stable_sort(profiles.begin(), profiles.end(), compare_time);
+
+  os << "Evaluator profile (time excludes nested evaluators; counts are summed"
+     << " over processes, times are the max):" << std::endl
+     << std::left << std::setw(40) << "  evaluator" << std::right
+     << std::setw(10) << "queries"
+     << std::setw(12) << "deriv qrys"
+     << std::setw(12) << "recomputes"
+     << std::setw(12) << "identical"
+     << std::setw(14) << "time [s]" << std::endl;
+
+  int queries(0), derivative_queries(0), recomputes(0), identical(0);
+  for (int i=0; i!=profiles.size(); ++i) {
+    const EvaluatorProfile& p = *profiles[i];
+    os << std::left << std::setw(40) << "  " + p.name << std::right
+       << std::setw(10) << p.queries
+       << std::setw(12) << p.derivative_queries
+       << std::setw(12) << p.recomputes
+       << std::setw(12) << p.identical
+       << std::setw(14) << std::setprecision(4) << p.time << std::endl;
+    queries += p.queries;
+    derivative_queries += p.derivative_queries;
+    recomputes += p.recomputes;
+    identical += p.identical;
+  }
+  os << std::left << std::setw(40) << "  total" << std::right
+     << std::setw(10) << queries
+     << std::setw(12) << derivative_queries
+     << std::setw(12) << recomputes
+     << std::setw(12) << identical
+     << std::setw(14) << std::setprecision(4) << times[n] << std::endl;
+}
+
+
+void
+ProfiledFieldEvaluator::ClearProfiles()
+{
+  profiles_().clear();
+}
+
+
+std::vector<Teuchos::RCP<EvaluatorProfile> >&
+ProfiledFieldEvaluator::profiles_()
+{
+  static std::vector<Teuchos::RCP<EvaluatorProfile> > profiles;
+  return profiles;
+}
+
+
+Teuchos::RCP<FieldEvaluator>
+get_wrapped(const Teuchos::RCP<FieldEvaluator>& fe)
+{
+  Teuchos::RCP<ProfiledFieldEvaluator> profiled =
+      Teuchos::rcp_dynamic_cast<ProfiledFieldEvaluator>(fe);
+  return profiled == Teuchos::null ? fe : profiled->get_evaluator();
+}
+
+} // namespace
+} // namespace
@@ -0,0 +1,148 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! ProfiledFieldEvaluator counts and times the updates of another evaluator.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+/*!
+
+HasFieldChanged() is called with many different request names, by PKs, MPCs,
+delegates and other evaluators, and each evaluator recomputes when any
+dependency has changed since its own last request.  This evaluator wraps
+another, created from the same parameter list, and records:
+
+* queries: calls to HasFieldChanged(), and separately to
+  HasFieldDerivativeChanged(),
+* recomputes: how many of these actually evaluated the field,
+* identical: how many recomputes gave a result bit-identical to the previous
+  one, i.e. were redundant,
+* time: wall time spent in the evaluator, excluding the evaluators it called.
+
+Records are shared by all copies of the evaluator in the states, and are
+written by the coordinator when the simulation finishes, sorted by time.
+Counts are summed over processes, and times are those of the slowest process.
+
+Evaluators are profiled by listing their keys in the `"cycle driver`" list
+(see coordinator-spec_), which switches their `"field evaluator type`" to
+`"profiled`".  Recomputes are detected by also requesting the field under a
+private name, and previous results are copied to detect identical ones, so
+profiling itself costs time and memory.
+
+PKs and their delegates downcast some evaluators to their type to get at
+their models, e.g. Richards gets the WRMs from WRMEvaluator, and the EWC
+delegates and energy PKs get the WRM, EOS and IEM models.  These casts go
+through get_wrapped(), which returns the evaluator wrapped by a profiled
+one, so these evaluators may be profiled too.  Calls made by a PK directly
+on the unwrapped evaluator are not counted.
+
+* `"profiled evaluator type`" ``[string]`` The `"field evaluator type`" of
+  the wrapped evaluator, set by the coordinator.
+
+*/
+
+#ifndef AMANZI_RELATIONS_PROFILED_FIELD_EVALUATOR_
+#define AMANZI_RELATIONS_PROFILED_FIELD_EVALUATOR_
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Epetra_Comm.h"
+
+#include "Factory.hh"
+#include "FieldEvaluator.hh"
+
+namespace Amanzi {
+namespace Relations {
+
+struct EvaluatorProfile {
+  explicit
+  EvaluatorProfile(const std::string& name_) :
+      name(name_),
+      queries(0),
+      derivative_queries(0),
+      recomputes(0),
+      identical(0),
+      time(0.) {}
+
+  std::string name;
+  int queries;
+  int derivative_queries;
+  int recomputes;
+  int identical;
+  double time;
+};
+
+
+class ProfiledFieldEvaluator : public FieldEvaluator {
+
+ public:
+  explicit
+  ProfiledFieldEvaluator(Teuchos::ParameterList& plist);
+  ProfiledFieldEvaluator(const ProfiledFieldEvaluator& other);
+
+  virtual Teuchos::RCP<FieldEvaluator> Clone() const;
+  virtual void operator=(const FieldEvaluator& other);
+
+  virtual bool HasFieldChanged(const Teuchos::Ptr<State>& S, Key request);
+  virtual bool HasFieldDerivativeChanged(const Teuchos::Ptr<State>& S,
+          Key request, Key wrt_key);
+  virtual bool IsDependency(const Teuchos::Ptr<State>& S, Key key) const;
+  virtual bool ProvidesKey(Key key) const;
+  virtual void EnsureCompatibility(const Teuchos::Ptr<State>& S);
+  virtual std::string WriteToString() const;
+
+  Teuchos::RCP<FieldEvaluator> get_evaluator() { return evaluator_; }
+  Teuchos::RCP<const EvaluatorProfile> get_profile() const { return profile_; }
+
+  // Switch the evaluators of the given keys in the evaluator list to this
+  // type.  A key "*" profiles all but primary variables.
+  static void ProfileEvaluators(Teuchos::ParameterList& fe_list,
+          const std::vector<std::string>& keys,
+          const std::vector<std::string>& excluded_keys);
+
+  // Write the records of all profiled evaluators, by decreasing time.  This
+  // is collective: records are reduced over comm, and written to os only if
+  // write is true.
+  static void WriteProfiles(const Epetra_Comm& comm, std::ostream& os,
+                            bool write);
+
+  // Drop all records, e.g. those of a previous simulation.
+  static void ClearProfiles();
+
+ protected:
+  // Count a recompute, comparing its result to the previous one.
+  void RecordRecompute_(const Teuchos::Ptr<State>& S);
+
+  static std::vector<Teuchos::RCP<EvaluatorProfile> >& profiles_();
+
+ protected:
+  Teuchos::RCP<FieldEvaluator> evaluator_;
+  Teuchos::RCP<EvaluatorProfile> profile_;
+  Key probe_request_;
+  std::vector<Key> my_keys_;
+
+  // values of the last result in this state, one entry per field
+  std::vector<std::vector<double> > last_;
+
+ private:
+  static Utils::RegisteredFactory<FieldEvaluator,ProfiledFieldEvaluator> factory_;
+};
+
+
+// The evaluator wrapped by fe if it is profiled, otherwise fe itself.  Use
+// before downcasting an evaluator to its type.
+Teuchos::RCP<FieldEvaluator>
+get_wrapped(const Teuchos::RCP<FieldEvaluator>& fe);
+
+} // namespace
+} // namespace
+
+#endif
@@ -0,0 +1,18 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  ProfiledFieldEvaluator counts and times the updates of another evaluator.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include "ProfiledFieldEvaluator.hh"
+
+namespace Amanzi {
+namespace Relations {
+
+// registry of method
+Utils::RegisteredFactory<FieldEvaluator,ProfiledFieldEvaluator> ProfiledFieldEvaluator::factory_("profiled");
+
+} // namespace
+} // namespace
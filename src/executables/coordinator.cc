@@ -33,6 +33,9 @@ including Vis and restart/checkpoint dumps.  It contains one and only one PK
 #include "PK.hh"
 #include "TreeVector.hh"
 #include "PK_Factory.hh"
+#include "PreconditionerSinglePrecision.hh"
+#include "parallel_for.hh"
+#include "ProfiledFieldEvaluator.hh"
 
 #include "coordinator.hh"
 
@@ -46,7 +49,8 @@ Coordinator::Coordinator(Teuchos::ParameterList& parameter_list,
     parameter_list_(Teuchos::rcp(new Teuchos::ParameterList(parameter_list))),
     S_(S),
     comm_(comm),
-    restart_(false) {
+    restart_(false),
+    profile_evaluators_(false) {
 
   // create and start the global timer
   timer_ = Teuchos::rcp(new Teuchos::Time("wallclock_monitor",true));
@@ -140,6 +144,20 @@ void Coordinator::setup() {
   S_->set_cycle(cycle0_);
   S_->RequireScalar("dt", "coordinator");
 
+  // wrap evaluators to be profiled before they are created, dropping the
+  // records of any previous coordinator
+  Amanzi::Relations::ProfiledFieldEvaluator::ClearProfiles();
+  if (coordinator_list_->isParameter("profile evaluators")) {
+    Teuchos::Array<std::string> keys =
+        coordinator_list_->get<Teuchos::Array<std::string> >("profile evaluators");
+    Teuchos::Array<std::string> excluded =
+        coordinator_list_->get<Teuchos::Array<std::string> >("do not profile evaluators",
+                Teuchos::Array<std::string>());
+    Amanzi::Relations::ProfiledFieldEvaluator::ProfileEvaluators(S_->FEList(),
+            keys.toVector(), excluded.toVector());
+    profile_evaluators_ = true;
+  }
+
   pk_->Setup(S_.ptr());  
   S_->Setup();
 }
@@ -330,6 +348,13 @@ void Coordinator::finalize() {
 
   // flush observations to make sure they are saved
   observations_->Flush();
+
+  // collective, written from one process
+  if (profile_evaluators_) {
+    Teuchos::OSTab tab = vo_->getOSTab();
+    Amanzi::Relations::ProfiledFieldEvaluator::WriteProfiles(*comm_, *vo_->os(),
+            vo_->os_OK(Teuchos::VERB_LOW));
+  }
 }
 
 
@@ -382,6 +407,8 @@ void Coordinator::report_memory() {
     Teuchos::OSTab tab = vo_->getOSTab();
     *vo_->os() << "======================================================================" << std::endl;
     *vo_->os() << "All meshes combined have " << global_ncells << " cells." << std::endl;
+    *vo_->os() << "Cell and face loops use " << Amanzi::Threading::num_threads()
+               << " threads per process." << std::endl;
     *vo_->os() << "Memory usage (high water mark):" << std::endl;
     *vo_->os() << std::fixed << std::setprecision(1);
     *vo_->os() << "  Maximum per core:   " << std::setw(7) << max_mem 
@@ -415,6 +442,20 @@ void Coordinator::report_memory() {
              << min_doubles_count*8/1024/1024 << " MBytes" << std::endl; 
   *vo_->os() << "  Total:              " << std::setw(7)
              << global_doubles_count*8/1024/1024 << " MBytes" << std::endl;
+
+  // single precision preconditioner factors, and their double precision size
+  double pc_bytes[2] = { Amanzi::Operators::PreconditionerSinglePrecision::total_bytes(),
+                         Amanzi::Operators::PreconditionerSinglePrecision::total_bytes_double() };
+  double global_pc_bytes[2] = { 0., 0. };
+  comm_->SumAll(pc_bytes, global_pc_bytes, 2);
+  if (global_pc_bytes[0] > 0.) {
+    *vo_->os() << "Single precision preconditioners" << std::endl;
+    *vo_->os() << "  Total:              " << std::setw(7)
+               << global_pc_bytes[0]/1024/1024 << " MBytes,  in double precision: "
+               << std::setw(7) << global_pc_bytes[1]/1024/1024 << " MBytes,  saved: "
+               << std::setw(7) << (global_pc_bytes[1] - global_pc_bytes[0])/1024/1024
+               << " MBytes" << std::endl;
+  }
 }
 
 
@@ -446,6 +487,10 @@ void Coordinator::read_parameter_list() {
   cycle1_ = coordinator_list_->get<int>("end cycle",-1);
   duration_ = coordinator_list_->get<double>("wallclock duration [hrs]", -1.0);
 
+  // threading of cell and face loops
+  Amanzi::Threading::set_num_threads(coordinator_list_->get<int>("threads per process", -1));
+  Amanzi::Threading::set_chunk_size(coordinator_list_->get<int>("thread chunk size", 1024));
+
   // restart control
   restart_ = coordinator_list_->isParameter("restart from checkpoint file");
   if (restart_) {
@@ -36,6 +36,18 @@ simulation, including starting and ending times and restart options.
       specifies a path to the checkpoint file to continue a stopped simulation.
     * `"wallclock duration [hrs]`" ``[double]`` **optional** After this time, the
       simulation will checkpoint and end.
+    * `"threads per process`" ``[int]`` **-1** Threads used by cell and face
+      loops, see threading-spec_.  -1 uses the OpenMP default.
+    * `"thread chunk size`" ``[int]`` **1024** Minimum number of entities per
+      thread chunk.
+    * `"profile evaluators`" ``[Array(string)]`` **optional** Keys of
+      evaluators whose queries, recomputes and time are recorded and written
+      at the end of the simulation, see ProfiledFieldEvaluator.  `"*`"
+      profiles all evaluators in the `"field evaluators`" list but primary
+      variables.
+    * `"do not profile evaluators`" ``[Array(string)]`` **optional** Keys
+      excluded from `"profile evaluators`", e.g. to keep the profiling
+      overhead out of cheap, frequently queried evaluators.
     * `"required times`" ``[io-event-spec]`` **optional** An IOEvent_ spec that
       sets a collection of times/cycles at which the simulation is guaranteed to
       hit exactly.  This is useful for situations such as where data is provided at
@@ -155,6 +167,7 @@ private:
   std::vector<Teuchos::RCP<Amanzi::Visualization> > failed_visualization_;
   Teuchos::RCP<Amanzi::Checkpoint> checkpoint_;
   bool restart_;
+  bool profile_evaluators_;
   std::string restart_filename_;
 
   // observations
@@ -0,0 +1,234 @@
+/*
+  ATS is released under the three-clause BSD License. 
+  The terms of use and "as is" disclaimer for this license are 
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+//! A column-line preconditioner for extruded meshes.
+
+#include "errors.hh"
+#include "dbc.hh"
+
+#include "PreconditionerColumnLine.hh"
+
+namespace Amanzi {
+namespace Operators {
+
+PreconditionerColumnLine::PreconditionerColumnLine(Teuchos::ParameterList& plist,
+        const Teuchos::RCP<const AmanziMesh::Mesh>& mesh) :
+    mesh_(mesh)
+{
+  Teuchos::ParameterList& cl_list = plist.sublist("column line parameters");
+  std::string lateral = cl_list.get<std::string>("lateral coupling", "multiplicative");
+  if (lateral == "none") {
+    lateral_ = LATERAL_NONE;
+  } else if (lateral == "additive") {
+    lateral_ = LATERAL_ADDITIVE;
+  } else if (lateral == "multiplicative") {
+    lateral_ = LATERAL_MULTIPLICATIVE;
+  } else {
+    Errors::Message msg;
+    msg << "PreconditionerColumnLine: invalid \"lateral coupling\" \"" << lateral
+        << "\", valid are \"none\", \"additive\", and \"multiplicative\".";
+    Exceptions::amanzi_throw(msg);
+  }
+
+  if (lateral_ != LATERAL_NONE) {
+    coarse_plist_ = cl_list.sublist("lateral preconditioner");
+    coarse_plist_.get<std::string>("preconditioner", "ML");
+  }
+
+  // lines from the mesh's columns
+  int ncells = mesh_->num_entities(AmanziMesh::CELL, AmanziMesh::Parallel_type::OWNED);
+  mesh_->build_columns();
+  line_of_cell_.assign(ncells, -1);
+
+  int ncols = mesh_->num_columns(false);
+  for (int col=0; col!=ncols; ++col) {
+    AmanziMesh::Entity_ID_List line;
+    for (auto c : mesh_->cells_of_column(col)) {
+      if (c >= ncells) {
+        Errors::Message msg("PreconditionerColumnLine: columns may not be split across processes.");
+        Exceptions::amanzi_throw(msg);
+      }
+      line.push_back(c);
+    }
+    for (auto c : line) line_of_cell_[c] = lines_.size();
+    lines_.push_back(line);
+  }
+
+  // remaining cells are lines of one cell
+  for (int c=0; c!=ncells; ++c) {
+    if (line_of_cell_[c] < 0) {
+      line_of_cell_[c] = lines_.size();
+      lines_.push_back(AmanziMesh::Entity_ID_List(1, c));
+    }
+  }
+
+  lower_.resize(ncells, 0.);
+  diag_.resize(ncells, 0.);
+  upper_.resize(ncells, 0.);
+}
+
+
+// -----------------------------------------------------------------------------
+// Maps and work space, which depend only on the matrix structure.
+// -----------------------------------------------------------------------------
+void PreconditionerColumnLine::InitializeStructure_() {
+  int ncells = line_of_cell_.size();
+  if (A_->NumMyRows() != ncells) {
+    Errors::Message msg("PreconditionerColumnLine: matrix rows do not match the owned cells -- a cell-centered discretization is required.");
+    Exceptions::amanzi_throw(msg);
+  }
+
+  b_work_ = Teuchos::rcp(new Epetra_MultiVector(A_->RowMap(), 1));
+  x_work_ = Teuchos::rcp(new Epetra_MultiVector(A_->RowMap(), 1));
+  r_work_ = Teuchos::rcp(new Epetra_MultiVector(A_->RowMap(), 1));
+  p_work_ = Teuchos::rcp(new Epetra_MultiVector(A_->RowMap(), 1));
+
+  if (lateral_ != LATERAL_NONE) {
+    coarse_map_ = Teuchos::rcp(new Epetra_Map(-1, lines_.size(), 0, A_->Comm()));
+    bc_work_ = Teuchos::rcp(new Epetra_MultiVector(*coarse_map_, 1));
+    xc_work_ = Teuchos::rcp(new Epetra_MultiVector(*coarse_map_, 1));
+
+    // coarse GID of each matrix column, including off-process neighbors
+    Epetra_MultiVector coarse_gid_row(A_->RowMap(), 1);
+    for (int c=0; c!=ncells; ++c) {
+      coarse_gid_row[0][c] = coarse_map_->GID(line_of_cell_[c]);
+    }
+    coarse_gid_col_ = Teuchos::rcp(new Epetra_MultiVector(A_->ColMap(), 1));
+    Epetra_Import importer(A_->ColMap(), A_->RowMap());
+    coarse_gid_col_->Import(coarse_gid_row, importer, Insert);
+
+    coarse_pc_ = Teuchos::rcp(new Matrix_PreconditionerDelegate(coarse_plist_));
+  }
+}
+
+
+// -----------------------------------------------------------------------------
+// Factor the lines and form the coarse system.
+// -----------------------------------------------------------------------------
+void PreconditionerColumnLine::Update(const Teuchos::RCP<const Epetra_CrsMatrix>& A) {
+  A_ = A;
+  if (b_work_ == Teuchos::null) InitializeStructure_();
+
+  const Epetra_Map& row_map = A_->RowMap();
+  const Epetra_Map& col_map = A_->ColMap();
+
+  // entry (c, c_nbr) of the matrix
+  auto entry = [&](int c, int c_nbr) {
+    int n;
+    double* vals;
+    int* inds;
+    A_->ExtractMyRowView(c, n, vals, inds);
+    int lid = col_map.LID(row_map.GID(c_nbr));
+    for (int k=0; k!=n; ++k) {
+      if (inds[k] == lid) return vals[k];
+    }
+    return 0.;
+  };
+
+  // Thomas algorithm, storing the factors
+  for (const auto& line : lines_) {
+    int n = line.size();
+    diag_[line[0]] = entry(line[0], line[0]);
+    lower_[line[0]] = 0.;
+    for (int k=1; k!=n; ++k) {
+      upper_[line[k-1]] = entry(line[k-1], line[k]);
+      lower_[line[k]] = entry(line[k], line[k-1]) / diag_[line[k-1]];
+      diag_[line[k]] = entry(line[k], line[k]) - lower_[line[k]] * upper_[line[k-1]];
+    }
+    upper_[line[n-1]] = 0.;
+  }
+
+  // coarse system R A R^T, summing entries into the line's row
+  if (lateral_ != LATERAL_NONE) {
+    coarse_A_ = Teuchos::rcp(new Epetra_CrsMatrix(Copy, *coarse_map_, 0));
+    int ncells = line_of_cell_.size();
+    for (int c=0; c!=ncells; ++c) {
+      int I = coarse_map_->GID(line_of_cell_[c]);
+      int n;
+      double* vals;
+      int* inds;
+      A_->ExtractMyRowView(c, n, vals, inds);
+      for (int k=0; k!=n; ++k) {
+        int J = (int) (*coarse_gid_col_)[0][inds[k]];
+        if (coarse_A_->SumIntoGlobalValues(I, 1, &vals[k], &J) != 0) {
+          coarse_A_->InsertGlobalValues(I, 1, &vals[k], &J);
+        }
+      }
+    }
+    coarse_A_->FillComplete();
+    coarse_pc_->set_matrix(coarse_A_);
+    coarse_pc_->InitializePreconditioner();
+  }
+}
+
+
+// -----------------------------------------------------------------------------
+// Tridiagonal solves on each line.
+// -----------------------------------------------------------------------------
+void PreconditionerColumnLine::SolveLines_(const Epetra_MultiVector& b,
+        Epetra_MultiVector& x) const {
+  for (const auto& line : lines_) {
+    int n = line.size();
+    x[0][line[0]] = b[0][line[0]];
+    for (int k=1; k!=n; ++k) {
+      x[0][line[k]] = b[0][line[k]] - lower_[line[k]] * x[0][line[k-1]];
+    }
+    x[0][line[n-1]] /= diag_[line[n-1]];
+    for (int k=n-2; k>=0; --k) {
+      x[0][line[k]] = (x[0][line[k]] - upper_[line[k]] * x[0][line[k+1]]) / diag_[line[k]];
+    }
+  }
+}
+
+
+// -----------------------------------------------------------------------------
+// Coarse solve: x = R^T A_c^{-1} R b
+// -----------------------------------------------------------------------------
+void PreconditionerColumnLine::SolveLateral_(const Epetra_MultiVector& b,
+        Epetra_MultiVector& x) const {
+  bc_work_->PutScalar(0.);
+  int ncells = line_of_cell_.size();
+  for (int c=0; c!=ncells; ++c) (*bc_work_)[0][line_of_cell_[c]] += b[0][c];
+
+  xc_work_->PutScalar(0.);
+  coarse_pc_->ApplyInverse(*bc_work_, *xc_work_);
+  for (int c=0; c!=ncells; ++c) x[0][c] = (*xc_work_)[0][line_of_cell_[c]];
+}
+
+
+int PreconditionerColumnLine::ApplyInverse(const Epetra_MultiVector& b,
+        Epetra_MultiVector& x) const {
+  AMANZI_ASSERT(A_ != Teuchos::null);
+
+  // work in the matrix's maps
+  int ncells = line_of_cell_.size();
+  for (int c=0; c!=ncells; ++c) (*b_work_)[0][c] = b[0][c];
+
+  if (lateral_ == LATERAL_NONE) {
+    SolveLines_(*b_work_, *x_work_);
+
+  } else if (lateral_ == LATERAL_ADDITIVE) {
+    SolveLateral_(*b_work_, *r_work_);
+    SolveLines_(*b_work_, *x_work_);
+    x_work_->Update(1., *r_work_, 1.);
+
+  } else {
+    // coarse correction, then line solves on the remaining residual
+    SolveLateral_(*b_work_, *p_work_);
+    A_->Multiply(false, *p_work_, *r_work_);
+    r_work_->Update(1., *b_work_, -1.);
+    SolveLines_(*r_work_, *x_work_);
+    x_work_->Update(1., *p_work_, 1.);
+  }
+
+  for (int c=0; c!=ncells; ++c) x[0][c] = (*x_work_)[0][c];
+  return 0;
+}
+
+} // namespace
+} // namespace
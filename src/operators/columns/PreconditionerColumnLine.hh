@@ -0,0 +1,126 @@
+/*
+  ATS is released under the three-clause BSD License. 
+  The terms of use and "as is" disclaimer for this license are 
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+//! A column-line preconditioner for extruded meshes.
+
+/*!
+
+On meshes extruded from a surface mesh, vertical coupling within a column is
+typically orders of magnitude stronger than lateral coupling, and generic AMG
+spends most of its effort resolving it.  This preconditioner uses the columns
+of the mesh (see `"build columns from set`" in the Mesh_ spec) and solves
+each column's tridiagonal system exactly.
+
+The lateral coupling is approximated by a coarse system with one unknown per
+column, :math:`A_c = R A R^T`, where R sums over the cells of a column.  This
+is a system on the surface mesh, and is solved with an AMG preconditioner.
+The two are combined either:
+
+- `"multiplicative`" :math:`x = x_c + T^{-1} (b - A x_c)`, where
+  :math:`x_c = R^T A_c^{-1} R b`.
+- `"additive`" :math:`x = T^{-1} b + R^T A_c^{-1} R b`.
+- `"none`" :math:`x = T^{-1} b`, line solves only.
+
+where T is the block diagonal (over columns) tridiagonal part of A.
+
+This requires a cell-centered discretization (`"fv: default`"), and columns
+that are not split across processes.  Cells that are not in a column are
+treated as columns of one cell.
+
+Use this by setting `"preconditioner type`" to `"column line`" in the
+`"preconditioner`" list of a PK that supports it (the `Richards PK`_ and the
+`Energy PK`_).
+
+.. _preconditioner-column-line-spec:
+.. admonition:: preconditioner-column-line-spec
+
+    * `"preconditioner type`" ``[string]`` `"column line`"
+
+    * `"column line parameters`" ``[list]``
+
+      * `"lateral coupling`" ``[string]`` **multiplicative** One of the above.
+
+      * `"lateral preconditioner`" ``[list]`` The coarse solve, see
+        Matrix_PreconditionerDelegate.  `"preconditioner`" is one of `"ML`",
+        `"HYPRE AMG`", etc, with options in the corresponding `"ML
+        Parameters`" or `"HYPRE AMG Parameters`" sublist.  Default is `"ML`".
+
+*/
+
+#ifndef ATS_OPERATORS_PRECONDITIONER_COLUMN_LINE_HH_
+#define ATS_OPERATORS_PRECONDITIONER_COLUMN_LINE_HH_
+
+#include <vector>
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Epetra_CrsMatrix.h"
+#include "Epetra_MultiVector.h"
+#include "Epetra_Import.h"
+
+#include "Mesh.hh"
+#include "Matrix_PreconditionerDelegate.hh"
+
+namespace Amanzi {
+namespace Operators {
+
+class PreconditionerColumnLine {
+ public:
+  PreconditionerColumnLine(Teuchos::ParameterList& plist,
+                           const Teuchos::RCP<const AmanziMesh::Mesh>& mesh);
+
+  // Factor the column systems and form the lateral coarse system, given the
+  // assembled cell-cell matrix.
+  void Update(const Teuchos::RCP<const Epetra_CrsMatrix>& A);
+
+  // Apply the inverse.  b and x are cell vectors.
+  int ApplyInverse(const Epetra_MultiVector& b, Epetra_MultiVector& x) const;
+
+  // number of lines, including single-cell lines
+  int num_lines() const { return lines_.size(); }
+
+ protected:
+  void InitializeStructure_();
+  void SolveLines_(const Epetra_MultiVector& b, Epetra_MultiVector& x) const;
+  void SolveLateral_(const Epetra_MultiVector& b, Epetra_MultiVector& x) const;
+
+ protected:
+  enum LateralCoupling {
+    LATERAL_NONE = 0,
+    LATERAL_ADDITIVE,
+    LATERAL_MULTIPLICATIVE
+  };
+  LateralCoupling lateral_;
+
+  Teuchos::RCP<const AmanziMesh::Mesh> mesh_;
+  Teuchos::RCP<const Epetra_CrsMatrix> A_;
+
+  // lines (columns), ordered top to bottom
+  std::vector<AmanziMesh::Entity_ID_List> lines_;
+  std::vector<int> line_of_cell_;
+
+  // factored tridiagonal systems, indexed by cell
+  std::vector<double> lower_;   // elimination multipliers
+  std::vector<double> diag_;    // pivots
+  std::vector<double> upper_;   // super-diagonal
+
+  // lateral coarse system
+  Teuchos::RCP<Epetra_Map> coarse_map_;
+  Teuchos::RCP<Epetra_CrsMatrix> coarse_A_;
+  Teuchos::RCP<Matrix_PreconditionerDelegate> coarse_pc_;
+  Teuchos::RCP<Epetra_MultiVector> coarse_gid_col_;
+  Teuchos::ParameterList coarse_plist_;
+
+  // work space
+  Teuchos::RCP<Epetra_MultiVector> b_work_, x_work_, r_work_, p_work_;
+  Teuchos::RCP<Epetra_MultiVector> bc_work_, xc_work_;
+};
+
+} // namespace
+} // namespace
+
+#endif
@@ -0,0 +1,191 @@
+/*
+  ATS is released under the three-clause BSD License. 
+  The terms of use and "as is" disclaimer for this license are 
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+//! An ILU(0) preconditioner whose factors are stored in single precision.
+
+#include <algorithm>
+#include <utility>
+
+#include "errors.hh"
+#include "dbc.hh"
+
+#include "PreconditionerSinglePrecision.hh"
+
+namespace Amanzi {
+namespace Operators {
+
+double PreconditionerSinglePrecision::total_bytes_ = 0.;
+double PreconditionerSinglePrecision::total_bytes_double_ = 0.;
+
+PreconditionerSinglePrecision::PreconditionerSinglePrecision(Teuchos::ParameterList& plist) :
+    n_(0)
+{
+  Teuchos::ParameterList& sp_list = plist.sublist("single precision ILU parameters");
+  shift_ = sp_list.get<double>("relative diagonal shift", 0.);
+  if (shift_ < 0.) {
+    Errors::Message msg("PreconditionerSinglePrecision: \"relative diagonal shift\" must be non-negative.");
+    Exceptions::amanzi_throw(msg);
+  }
+}
+
+
+PreconditionerSinglePrecision::~PreconditionerSinglePrecision() {
+  Account_(-1.);
+}
+
+
+double PreconditionerSinglePrecision::bytes() const {
+  return (lu_.size() + inv_diag_.size()) * sizeof(float) +
+      (row_ptr_.size() + col_.size() + diag_.size() + col_from_A_.size()) * sizeof(int);
+}
+
+
+double PreconditionerSinglePrecision::bytes_double() const {
+  return (lu_.size() + inv_diag_.size()) * sizeof(double) +
+      (row_ptr_.size() + col_.size() + diag_.size() + col_from_A_.size()) * sizeof(int);
+}
+
+
+void PreconditionerSinglePrecision::Account_(double sign) {
+  total_bytes_ += sign * bytes();
+  total_bytes_double_ += sign * bytes_double();
+}
+
+
+// -----------------------------------------------------------------------------
+// Local CSR structure of the on-process block, with sorted columns.
+// -----------------------------------------------------------------------------
+void PreconditionerSinglePrecision::InitializeStructure_() {
+  Account_(-1.);
+
+  const Epetra_Map& row_map = A_->RowMap();
+  const Epetra_Map& col_map = A_->ColMap();
+  n_ = A_->NumMyRows();
+
+  row_ptr_.assign(n_+1, 0);
+  col_.clear();
+  diag_.assign(n_, -1);
+  col_from_A_.assign(A_->NumMyNonzeros(), -1);
+
+  int offset = 0;
+  std::vector<std::pair<int,int> > row;
+  for (int i=0; i!=n_; ++i) {
+    int n;
+    double* vals;
+    int* inds;
+    A_->ExtractMyRowView(i, n, vals, inds);
+
+    row.clear();
+    for (int k=0; k!=n; ++k) {
+      int j = row_map.LID(col_map.GID(inds[k]));
+      if (j >= 0) row.push_back(std::make_pair(j, offset+k));
+    }
+    std::sort(row.begin(), row.end());
+
+    for (const auto& e : row) {
+      if ((int) col_.size() == row_ptr_[i] || col_.back() != e.first) {
+        if (e.first == i) diag_[i] = col_.size();
+        col_.push_back(e.first);
+      }
+      col_from_A_[e.second] = col_.size() - 1;
+    }
+    row_ptr_[i+1] = col_.size();
+    offset += n;
+
+    if (diag_[i] < 0) {
+      Errors::Message msg("PreconditionerSinglePrecision: matrix row is missing its diagonal entry.");
+      Exceptions::amanzi_throw(msg);
+    }
+  }
+
+  lu_.resize(col_.size());
+  inv_diag_.resize(n_);
+
+  Account_(1.);
+}
+
+
+// -----------------------------------------------------------------------------
+// ILU(0) in double precision, stored in single precision.
+// -----------------------------------------------------------------------------
+void PreconditionerSinglePrecision::Update(const Teuchos::RCP<const Epetra_CrsMatrix>& A) {
+  bool new_structure = A_ == Teuchos::null || A->NumMyRows() != n_ ||
+      A->NumMyNonzeros() != (int) col_from_A_.size();
+  A_ = A;
+  if (new_structure) InitializeStructure_();
+
+  // gather values, factored in double precision in a temporary
+  std::vector<double> w(col_.size(), 0.);
+  int offset = 0;
+  for (int i=0; i!=n_; ++i) {
+    int n;
+    double* vals;
+    int* inds;
+    A_->ExtractMyRowView(i, n, vals, inds);
+    for (int k=0; k!=n; ++k) {
+      int p = col_from_A_[offset+k];
+      if (p >= 0) w[p] += vals[k];
+    }
+    offset += n;
+    w[diag_[i]] *= 1. + shift_;
+  }
+
+  // factor, row by row (IKJ variant)
+  std::vector<int> pos(n_, -1);
+  for (int i=0; i!=n_; ++i) {
+    for (int p=row_ptr_[i]; p!=row_ptr_[i+1]; ++p) pos[col_[p]] = p;
+
+    for (int p=row_ptr_[i]; p!=diag_[i]; ++p) {
+      int k = col_[p];
+      w[p] /= w[diag_[k]];
+      for (int q=diag_[k]+1; q!=row_ptr_[k+1]; ++q) {
+        if (pos[col_[q]] >= 0) w[pos[col_[q]]] -= w[p] * w[q];
+      }
+    }
+
+    // a zero pivot leaves the row unpreconditioned
+    if (w[diag_[i]] == 0.) w[diag_[i]] = 1.;
+
+    for (int p=row_ptr_[i]; p!=row_ptr_[i+1]; ++p) pos[col_[p]] = -1;
+  }
+
+  for (int p=0; p!=(int) w.size(); ++p) lu_[p] = (float) w[p];
+  for (int i=0; i!=n_; ++i) inv_diag_[i] = (float) (1. / w[diag_[i]]);
+}
+
+
+// -----------------------------------------------------------------------------
+// Triangular solves, accumulating in double precision.  Both are done in place
+// in x, which keeps this reentrant and allows x and b to be the same vector.
+// -----------------------------------------------------------------------------
+int PreconditionerSinglePrecision::ApplyInverse(const Epetra_MultiVector& b,
+        Epetra_MultiVector& x) const {
+  AMANZI_ASSERT(A_ != Teuchos::null);
+  AMANZI_ASSERT(b.MyLength() == n_ && x.MyLength() == n_);
+
+  for (int v=0; v!=b.NumVectors(); ++v) {
+    const double* bv = b[v];
+    double* xv = x[v];
+
+    for (int i=0; i!=n_; ++i) {
+      double s = bv[i];
+      for (int p=row_ptr_[i]; p!=diag_[i]; ++p) s -= lu_[p] * xv[col_[p]];
+      xv[i] = s;
+    }
+
+    for (int i=n_-1; i>=0; --i) {
+      double s = xv[i];
+      for (int p=diag_[i]+1; p!=row_ptr_[i+1]; ++p) s -= lu_[p] * xv[col_[p]];
+      xv[i] = s * inv_diag_[i];
+    }
+  }
+  return 0;
+}
+
+} // namespace
+} // namespace
@@ -0,0 +1,102 @@
+/*
+  ATS is released under the three-clause BSD License. 
+  The terms of use and "as is" disclaimer for this license are 
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+//! An ILU(0) preconditioner whose factors are stored in single precision.
+
+/*!
+
+Applying a preconditioner is limited by memory bandwidth rather than by
+floating point work, and our preconditioners are approximate anyway (see the
+suppressed Jacobian terms of the PKs).  This preconditioner factors the
+assembled matrix in double precision, but stores the factors in single
+precision.  Applying it streams half the bytes per value, while the
+triangular solves accumulate in double precision, so it may be used inside
+the double precision Krylov and Newton iterations without further changes.
+
+The factorization is ILU(0) of each process's diagonal block, i.e. block
+Jacobi across processes.  Memory held by the single precision factors and
+their structure, and what the same would take in double precision, are
+written in the memory report at the end of a simulation.
+
+This requires a cell-centered discretization (`"fv: default`").  Use this by
+setting `"preconditioner type`" to `"single precision ILU`" in the
+`"preconditioner`" list of a PK that supports it (the `Richards PK`_ and the
+`Energy PK`_).
+
+.. _preconditioner-single-precision-spec:
+.. admonition:: preconditioner-single-precision-spec
+
+    * `"preconditioner type`" ``[string]`` `"single precision ILU`"
+
+    * `"single precision ILU parameters`" ``[list]``
+
+      * `"relative diagonal shift`" ``[double]`` **0.0** Diagonal entries are
+        scaled by one plus this before factoring, which may stabilize the
+        factorization of non-diagonally dominant matrices.
+
+*/
+
+#ifndef ATS_OPERATORS_PRECONDITIONER_SINGLE_PRECISION_HH_
+#define ATS_OPERATORS_PRECONDITIONER_SINGLE_PRECISION_HH_
+
+#include <vector>
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Epetra_CrsMatrix.h"
+#include "Epetra_MultiVector.h"
+
+namespace Amanzi {
+namespace Operators {
+
+class PreconditionerSinglePrecision {
+ public:
+  explicit PreconditionerSinglePrecision(Teuchos::ParameterList& plist);
+  ~PreconditionerSinglePrecision();
+
+  // Factor the assembled matrix.
+  void Update(const Teuchos::RCP<const Epetra_CrsMatrix>& A);
+
+  // Apply the inverse.  b and x are in the matrix's row ordering.
+  int ApplyInverse(const Epetra_MultiVector& b, Epetra_MultiVector& x) const;
+
+  // bytes held by the factors and their structure, and what they would hold
+  // in double precision
+  double bytes() const;
+  double bytes_double() const;
+
+  // totals over all instances on this process, for the memory report
+  static double total_bytes() { return total_bytes_; }
+  static double total_bytes_double() { return total_bytes_double_; }
+
+ protected:
+  void InitializeStructure_();
+  void Account_(double sign);
+
+ protected:
+  double shift_;
+  Teuchos::RCP<const Epetra_CrsMatrix> A_;
+
+  // local CSR structure, columns sorted, diagonal position of each row
+  int n_;
+  std::vector<int> row_ptr_;
+  std::vector<int> col_;
+  std::vector<int> diag_;
+  std::vector<int> col_from_A_;   // position in the CSR for each entry of A
+
+  // factors: unit lower L and U, U's diagonal stored inverted
+  std::vector<float> lu_;
+  std::vector<float> inv_diag_;
+
+  static double total_bytes_;
+  static double total_bytes_double_;
+};
+
+} // namespace
+} // namespace
+
+#endif
@@ -0,0 +1,174 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/* -------------------------------------------------------------------------
+ATS
+
+License: see $ATS_DIR/COPYRIGHT
+Author: Ethan Coon
+
+Split-phase scatter of owned values into ghost entries.
+------------------------------------------------------------------------- */
+
+#include <algorithm>
+#include <numeric>
+
+#include "Epetra_Import.h"
+#include "Epetra_MpiComm.h"
+
+#include "errors.hh"
+#include "ghost_scatter.hh"
+
+namespace Amanzi {
+namespace Operators {
+
+namespace {
+
+// Sort lids by the process in pids, keeping the order of each process's lids,
+// into lists contiguous by process.
+void
+GroupByProcess(const int* lids, const int* pids, int n,
+               std::vector<int>& procs, std::vector<int>& starts,
+               std::vector<int>& sorted_lids)
+{
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [pids](int a, int b) { return pids[a] < pids[b]; });
+
+  procs.clear();
+  starts.assign(1, 0);
+  sorted_lids.resize(n);
+  for (int k=0; k!=n; ++k) {
+    sorted_lids[k] = lids[order[k]];
+    if (procs.empty() || procs.back() != pids[order[k]]) {
+      if (!procs.empty()) starts.push_back(k);
+      procs.push_back(pids[order[k]]);
+    }
+  }
+  if (!procs.empty()) starts.push_back(n);
+}
+
+} // namespace
+
+
+GhostScatter::GhostScatter(const Epetra_BlockMap& owned_map,
+                           const Epetra_BlockMap& ghosted_map) :
+    comm_(MPI_COMM_NULL),
+    tag_(0),
+    v_(NULL)
+{
+  Epetra_Import importer(ghosted_map, owned_map);
+
+  // Owned entries of the ghosted vector alias the owned vector, so only the
+  // remote entries are communicated.
+  if (importer.NumSameIDs() != owned_map.NumMyElements() ||
+      importer.NumPermuteIDs() != 0 ||
+      owned_map.MaxElementSize() != 1) {
+    Errors::Message msg("GhostScatter: the ghosted map must extend the owned map by ghost entries of size 1.");
+    Exceptions::amanzi_throw(msg);
+  }
+
+  // The messages pair each process's exports with the importing process's
+  // remote entries in the order of the import, as Epetra's own does.
+  GroupByProcess(importer.ExportLIDs(), importer.ExportPIDs(), importer.NumExportIDs(),
+                 send_procs_, send_starts_, send_lids_);
+
+  int nremote = importer.NumRemoteIDs();
+  std::vector<int> remote_gids(nremote), remote_pids(nremote), owner_lids(nremote);
+  for (int k=0; k!=nremote; ++k) {
+    remote_gids[k] = ghosted_map.GID(importer.RemoteLIDs()[k]);
+  }
+  owned_map.RemoteIDList(nremote, remote_gids.data(), remote_pids.data(), owner_lids.data());
+  GroupByProcess(importer.RemoteLIDs(), remote_pids.data(), nremote,
+                 recv_procs_, recv_starts_, recv_lids_);
+
+  const Epetra_MpiComm* mpi_comm = dynamic_cast<const Epetra_MpiComm*>(&owned_map.Comm());
+  if (mpi_comm != NULL) {
+    comm_ = mpi_comm->Comm();
+    tag_ = mpi_comm->GetMpiTag();
+  } else if (!send_procs_.empty() || !recv_procs_.empty()) {
+    Errors::Message msg("GhostScatter: ghost entries on more than one process require an MPI communicator.");
+    Exceptions::amanzi_throw(msg);
+  }
+}
+
+
+GhostScatter::~GhostScatter() {
+  if (!requests_.empty()) {
+    MPI_Waitall(requests_.size(), requests_.data(), MPI_STATUSES_IGNORE);
+  }
+}
+
+
+// -----------------------------------------------------------------------------
+// Post the receives, pack the exported owned values and post the sends.
+// -----------------------------------------------------------------------------
+void GhostScatter::Begin(Epetra_MultiVector& v) {
+  if (in_progress()) {
+    Errors::Message msg("GhostScatter: Begin() called on an unfinished scatter.");
+    Exceptions::amanzi_throw(msg);
+  }
+  v_ = &v;
+
+  int nvecs = v.NumVectors();
+  send_buf_.resize(send_lids_.size() * nvecs);
+  recv_buf_.resize(recv_lids_.size() * nvecs);
+  requests_.resize(recv_procs_.size() + send_procs_.size());
+
+  int ierr = MPI_SUCCESS;
+  for (int i=0; i!=(int) recv_procs_.size(); ++i) {
+    int count = (recv_starts_[i+1] - recv_starts_[i]) * nvecs;
+    ierr |= MPI_Irecv(&recv_buf_[recv_starts_[i] * nvecs], count, MPI_DOUBLE,
+                      recv_procs_[i], tag_, comm_, &requests_[i]);
+  }
+
+  for (int k=0; k!=(int) send_lids_.size(); ++k) {
+    for (int j=0; j!=nvecs; ++j) {
+      send_buf_[k*nvecs + j] = v[j][send_lids_[k]];
+    }
+  }
+
+  for (int i=0; i!=(int) send_procs_.size(); ++i) {
+    int count = (send_starts_[i+1] - send_starts_[i]) * nvecs;
+    ierr |= MPI_Isend(&send_buf_[send_starts_[i] * nvecs], count, MPI_DOUBLE,
+                      send_procs_[i], tag_, comm_, &requests_[recv_procs_.size() + i]);
+  }
+
+  if (ierr != MPI_SUCCESS) {
+    Errors::Message msg("GhostScatter: posting the ghost exchange failed.");
+    Exceptions::amanzi_throw(msg);
+  }
+}
+
+
+// -----------------------------------------------------------------------------
+// Wait for the messages and unpack into the ghost entries.
+// -----------------------------------------------------------------------------
+void GhostScatter::End() {
+  if (!in_progress()) {
+    Errors::Message msg("GhostScatter: End() called before Begin().");
+    Exceptions::amanzi_throw(msg);
+  }
+  Epetra_MultiVector& v = *v_;
+  v_ = NULL;
+
+  int ierr = MPI_SUCCESS;
+  if (!requests_.empty()) {
+    ierr = MPI_Waitall(requests_.size(), requests_.data(), MPI_STATUSES_IGNORE);
+    requests_.clear();
+  }
+  if (ierr != MPI_SUCCESS) {
+    Errors::Message msg("GhostScatter: completing the ghost exchange failed.");
+    Exceptions::amanzi_throw(msg);
+  }
+
+  int nvecs = v.NumVectors();
+  for (int k=0; k!=(int) recv_lids_.size(); ++k) {
+    for (int j=0; j!=nvecs; ++j) {
+      v[j][recv_lids_[k]] = recv_buf_[k*nvecs + j];
+    }
+  }
+}
+
+} // namespace
+} // namespace
@@ -0,0 +1,93 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! Split-phase scatter of owned values into ghost entries.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+
+/*!
+
+CompositeVector::ScatterMasterToGhosted() is blocking: no work is done while
+the ghost values are in flight.  Most kernels, however, only need ghost values
+on the entities adjacent to a process boundary, which are a small fraction of
+the local mesh.  This scatter is split into two phases, so that the messages
+are posted, the entities that need no ghost data are computed, and only then
+the scatter is finished and the remaining entities are computed:
+
+.. code-block:: c++
+
+    scatter.Begin(*tcc->ViewComponent("cell", true));
+    // ... work on owned entries only ...
+    scatter.End();
+    // ... work that reads ghost entries ...
+
+Begin() only posts nonblocking sends and receives, and End() waits for them,
+so the exchange progresses while the work in between is done.  That work
+should not include collectives (e.g. global sums), which would wait on all
+processes and serialize the exchange again.
+
+The vector passed to Begin() is the ghosted view of a component, whose first
+entries alias the owned view.  Owned entries must not be modified between
+Begin() and End().
+
+*/
+
+#ifndef ATS_OPERATORS_GHOST_SCATTER_HH_
+#define ATS_OPERATORS_GHOST_SCATTER_HH_
+
+#include <vector>
+#include "mpi.h"
+
+#include "Epetra_BlockMap.h"
+#include "Epetra_MultiVector.h"
+
+namespace Amanzi {
+namespace Operators {
+
+class GhostScatter {
+
+ public:
+  GhostScatter(const Epetra_BlockMap& owned_map,
+               const Epetra_BlockMap& ghosted_map);
+  ~GhostScatter();
+
+  // Post the sends and receives of the ghost values of v.
+  void Begin(Epetra_MultiVector& v);
+
+  // Wait for the ghost values and write them into v.
+  void End();
+
+  // Blocking scatter, equivalent to ScatterMasterToGhosted().
+  void Scatter(Epetra_MultiVector& v) { Begin(v); End(); }
+
+  bool in_progress() const { return v_ != NULL; }
+
+ protected:
+  MPI_Comm comm_;
+  int tag_;
+
+  // owned local ids sent to each neighbor, contiguous by neighbor
+  std::vector<int> send_procs_;
+  std::vector<int> send_starts_;
+  std::vector<int> send_lids_;
+
+  // ghost local ids received from each neighbor, contiguous by neighbor
+  std::vector<int> recv_procs_;
+  std::vector<int> recv_starts_;
+  std::vector<int> recv_lids_;
+
+  Epetra_MultiVector* v_;
+  std::vector<double> send_buf_;
+  std::vector<double> recv_buf_;
+  std::vector<MPI_Request> requests_;
+};
+
+} // namespace
+} // namespace
+
+#endif
@@ -0,0 +1,94 @@
+/*
+  GhostScatter against CompositeVector::ScatterMasterToGhosted(), on cells and
+  faces of a mesh partitioned over all processes.  Run on more than one
+  process, e.g. mpirun -np 3.
+*/
+
+#include <string>
+#include <vector>
+#include "UnitTest++.h"
+
+#include "Teuchos_RCP.hpp"
+
+#include "AmanziComm.hh"
+#include "CompositeVector.hh"
+#include "CompositeVectorSpace.hh"
+#include "MeshFactory.hh"
+
+#include "ghost_scatter.hh"
+
+namespace {
+
+using namespace Amanzi;
+
+// owned entries from their global ids, ghost entries invalid
+void
+Fill(CompositeVector& cv)
+{
+  for (const auto& comp : cv) {
+    Epetra_MultiVector& v = *cv.ViewComponent(comp, true);
+    const Epetra_BlockMap& map = v.Map();
+    int nowned = cv.size(comp, false);
+    for (int j=0; j!=v.NumVectors(); ++j) {
+      for (int i=0; i!=v.MyLength(); ++i) {
+        v[j][i] = i < nowned ? 10. * map.GID(i) + j : -1.;
+      }
+    }
+  }
+}
+
+
+void
+CheckEqual(const Epetra_MultiVector& expected, const Epetra_MultiVector& v)
+{
+  CHECK_EQUAL(expected.MyLength(), v.MyLength());
+  for (int j=0; j!=v.NumVectors(); ++j) {
+    for (int i=0; i!=v.MyLength(); ++i) {
+      CHECK_EQUAL(expected[j][i], v[j][i]);
+    }
+  }
+}
+
+} // namespace
+
+
+TEST(GHOST_SCATTER_MATCHES_SCATTER_MASTER_TO_GHOSTED) {
+  using namespace Amanzi;
+
+  auto comm = getDefaultComm();
+  AmanziMesh::MeshFactory factory(comm);
+  Teuchos::RCP<AmanziMesh::Mesh> mesh = factory.create(0., 0., 0., 1., 1., 1., 4, 4, 4);
+
+  std::vector<std::string> names = { "cell", "face" };
+  std::vector<AmanziMesh::Entity_kind> locations = { AmanziMesh::CELL, AmanziMesh::FACE };
+  std::vector<int> num_dofs = { 2, 1 };
+  CompositeVectorSpace cvs;
+  cvs.SetMesh(mesh)->SetGhosted()->SetComponents(names, locations, num_dofs);
+
+  CompositeVector expected(cvs), cv(cvs);
+  Fill(expected);
+  Fill(cv);
+  expected.ScatterMasterToGhosted();
+
+  Operators::GhostScatter cell_scatter(mesh->cell_map(false), mesh->cell_map(true));
+  Operators::GhostScatter face_scatter(mesh->face_map(false), mesh->face_map(true));
+
+  // both exchanges in flight at once, finished in the opposite order
+  cell_scatter.Begin(*cv.ViewComponent("cell", true));
+  face_scatter.Begin(*cv.ViewComponent("face", true));
+  CHECK(cell_scatter.in_progress() && face_scatter.in_progress());
+  face_scatter.End();
+  cell_scatter.End();
+  CHECK(!cell_scatter.in_progress() && !face_scatter.in_progress());
+
+  CheckEqual(*expected.ViewComponent("cell", true), *cv.ViewComponent("cell", true));
+  CheckEqual(*expected.ViewComponent("face", true), *cv.ViewComponent("face", true));
+
+  // a scatter may be reused, and a second Begin() waits for its End()
+  Fill(cv);
+  cell_scatter.Begin(*cv.ViewComponent("cell", true));
+  CHECK_THROW(cell_scatter.Begin(*cv.ViewComponent("cell", true)), std::exception);
+  cell_scatter.End();
+  CheckEqual(*expected.ViewComponent("cell", true), *cv.ViewComponent("cell", true));
+}
+
@@ -0,0 +1,164 @@
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+//! Threaded loops over cells and faces within an MPI process.
+
+/*!
+
+ATS is parallelized by domain decomposition.  On many-core nodes, one MPI
+rank per core gives a large ratio of ghost to owned entities and little memory
+per rank.  Fewer ranks, each running its loops over entities with several
+threads, avoids both.  These loops are used by evaluators, PK residual
+assembly and upwinding, wherever each iteration writes only its own entries.
+
+When ATS is configured with `ATS_ENABLE_OPENMP`, loops are split into
+contiguous chunks of at least `"thread chunk size`" entities, scheduled
+statically over OpenMP threads.  Otherwise they run serially and the layer
+costs nothing.  Loop bodies must only read shared data.  In particular, each
+chunk must own its work space (see parallel_for_chunks()), and mesh queries
+that lazily build caches must not be called from loop bodies.
+
+An exception thrown by a loop body stops its chunk and is rethrown after the
+loop (the first one, in chunk order, if several chunks throw), so errors may
+be thrown as usual.  Output from loop bodies would interleave, so loops flag
+failures and report them after the loop.
+
+Sums (see parallel_sum()) add partial sums over fixed blocks of `"thread
+chunk size`" entities, so they are reproducible for any number of threads.
+
+The number of threads defaults to `OMP_NUM_THREADS` and may be overridden in
+the coordinator list.  Threads are wall-clock parallel, so run with one rank
+per NUMA domain or socket and bind threads to cores
+(e.g. `OMP_PROC_BIND=close`).
+
+.. _threading-spec:
+.. admonition:: threading-spec
+
+    * `"threads per process`" ``[int]`` **-1** Number of threads used by
+      cell and face loops.  -1 uses the OpenMP default.
+
+    * `"thread chunk size`" ``[int]`` **1024** Minimum number of entities
+      per chunk.  Loops shorter than this run serially.
+
+*/
+
+#ifndef ATS_OPERATORS_PARALLEL_FOR_HH_
+#define ATS_OPERATORS_PARALLEL_FOR_HH_
+
+#include <algorithm>
+#include <exception>
+#include <vector>
+
+#ifdef ATS_ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+namespace Amanzi {
+namespace Threading {
+
+namespace Impl {
+inline int& chunk_size() { static int chunk = 1024; return chunk; }
+
+// Calls g(k) for each k in [0, count), scheduled statically on nthreads
+// threads.  Exceptions are caught, and the first in order of k rethrown
+// after the loop.
+template<class G>
+void for_each_index(int count, int nthreads, const G& g) {
+  std::vector<std::exception_ptr> errors(count);
+#ifdef ATS_ENABLE_OPENMP
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+#endif
+  for (int k=0; k<count; ++k) {
+    try {
+      g(k);
+    } catch (...) {
+      errors[k] = std::current_exception();
+    }
+  }
+
+  for (const auto& error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+}
+}
+
+// Number of threads available to loops.
+inline int num_threads() {
+#ifdef ATS_ENABLE_OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+// Set the number of threads.  Values less than 1 leave the default.
+inline void set_num_threads(int n) {
+#ifdef ATS_ENABLE_OPENMP
+  if (n > 0) omp_set_num_threads(n);
+#endif
+}
+
+inline int chunk_size() { return Impl::chunk_size(); }
+inline void set_chunk_size(int n) { Impl::chunk_size() = std::max(n, 1); }
+
+// Number of chunks a loop of n entities is split into.
+inline int num_chunks(int n) {
+  return std::max(1, std::min(num_threads(), n / chunk_size()));
+}
+
+
+// Calls f(begin, end) on contiguous chunks covering [0, n).  Use this form
+// when the loop body needs work space, allocating it once per chunk.
+template<class F>
+void parallel_for_chunks(int n, const F& f) {
+  int nchunks = num_chunks(n);
+  if (nchunks == 1) {
+    if (n > 0) f(0, n);
+    return;
+  }
+
+  Impl::for_each_index(nchunks, nchunks, [&f, n, nchunks](int k) {
+      f((long)n * k / nchunks, (long)n * (k+1) / nchunks);
+    });
+}
+
+
+// Calls f(i) for each i in [0, n).
+template<class F>
+void parallel_for(int n, const F& f) {
+  parallel_for_chunks(n, [&f](int begin, int end) {
+      for (int i=begin; i!=end; ++i) f(i);
+    });
+}
+
+
+// Returns the sum of f(i) for i in [0, n).  Partial sums over blocks of
+// chunk_size() entities are added in block order, so the result depends on
+// the chunk size but not on the number of threads or on their timing.
+template<class F>
+double parallel_sum(int n, const F& f) {
+  int chunk = chunk_size();
+  int nblocks = n / chunk + (n % chunk ? 1 : 0);
+  std::vector<double> partial(nblocks, 0.);
+
+  Impl::for_each_index(nblocks, std::min(num_threads(), std::max(nblocks, 1)),
+                       [&](int k) {
+      double sum = 0.;
+      int last = std::min((long)n, (long)chunk * (k+1));
+      for (int i=chunk * k; i!=last; ++i) sum += f(i);
+      partial[k] = sum;
+    });
+
+  double sum = 0.;
+  for (int k=0; k!=nblocks; ++k) sum += partial[k];
+  return sum;
+}
+
+} // namespace
+} // namespace
+
+#endif
@@ -52,14 +52,23 @@ void UpwindArithmeticMean::CalculateCoefficientsOnFaces(
   // making the local matrices in MFD, so there is no need to
   // communicate the resulting face coeficients.
 
-  // communicate ghosted cells
-  cell_coef.ScatterMasterToGhosted("cell");
+  // Communicate ghosted cells, while owned cells are summed.  Like
+  // ScatterMasterToGhosted(), this writes only ghost entries of a const
+  // vector.
+  if (cell_scatter_ == Teuchos::null || scatter_mesh_ != mesh) {
+    cell_scatter_ = Teuchos::rcp(new GhostScatter(*cell_coef.ComponentMap("cell",false),
+                                                  *cell_coef.ComponentMap("cell",true)));
+    scatter_mesh_ = mesh;
+  }
+  const Epetra_MultiVector& cell_coef_c = *cell_coef.ViewComponent("cell",true);
+  cell_scatter_->Begin(const_cast<Epetra_MultiVector&>(cell_coef_c));
 
   Epetra_MultiVector& face_coef_f = *face_coef->ViewComponent("face",true);
-  const Epetra_MultiVector& cell_coef_c = *cell_coef.ViewComponent("cell",true);
 
+  int c_owned = cell_coef.size("cell", false);
   int c_used = cell_coef.size("cell", true);
   for (int c=0; c!=c_used; ++c) {
+    if (c == c_owned) cell_scatter_->End();
     mesh->cell_get_faces(c, &faces);
 
     for (unsigned int n=0; n!=faces.size(); ++n) {
@@ -67,6 +76,7 @@ void UpwindArithmeticMean::CalculateCoefficientsOnFaces(
       face_coef_f[0][f] += cell_coef_c[0][c] / 2.0;
     }
   }
+  if (cell_scatter_->in_progress()) cell_scatter_->End();
 
   // rescale boundary faces, as these had only one cell neighbor
   unsigned int f_owned = mesh->num_entities(AmanziMesh::FACE, AmanziMesh::Parallel_type::OWNED);
@@ -15,6 +15,7 @@
 
 #include "Key.hh"
 #include "upwinding.hh"
+#include "ghost_scatter.hh"
 
 namespace Amanzi {
 
@@ -57,6 +58,10 @@ private:
   Key pkname_;
   Key cell_coef_;
   Key face_coef_;
+
+  // split-phase exchange of the cell coefficients, built on first use
+  Teuchos::RCP<GhostScatter> cell_scatter_;
+  Teuchos::RCP<const AmanziMesh::Mesh> scatter_mesh_;
 };
 
 } // namespace
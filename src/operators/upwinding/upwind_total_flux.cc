@@ -10,11 +10,14 @@
 // faces.
 // -----------------------------------------------------------------------------
 
+#include <vector>
+
 #include "Mesh.hh"
 #include "CompositeVector.hh"
 #include "State.hh"
 #include "Debugger.hh"
 #include "VerboseObject.hh"
+#include "parallel_for.hh"
 #include "upwind_total_flux.hh"
 #include "Epetra_IntVector.h"
 
@@ -55,13 +58,21 @@ void UpwindTotalFlux::CalculateCoefficientsOnFaces(
     face_coef->ViewComponent("cell",true)->PutScalar(1.0);
   }
 
-  // communicate needed ghost values
-  cell_coef.ScatterMasterToGhosted("cell");
+  // Communicate needed ghost values.  Upwind directions do not depend on
+  // them, so the exchange progresses while they are identified.  Like
+  // ScatterMasterToGhosted(), this writes only ghost entries of a const
+  // vector.
+  if (cell_scatter_ == Teuchos::null || scatter_mesh_ != mesh) {
+    cell_scatter_ = Teuchos::rcp(new GhostScatter(*cell_coef.ComponentMap("cell",false),
+                                                  *cell_coef.ComponentMap("cell",true)));
+    scatter_mesh_ = mesh;
+  }
+  const Epetra_MultiVector& coef_cells = *cell_coef.ViewComponent("cell",true);
+  cell_scatter_->Begin(const_cast<Epetra_MultiVector&>(coef_cells));
 
   // pull out vectors
   const Epetra_MultiVector& flux_v = *flux.ViewComponent("face",false);
   Epetra_MultiVector& coef_faces = *face_coef->ViewComponent("face",false);
-  const Epetra_MultiVector& coef_cells = *cell_coef.ViewComponent("cell",true);
 
   // Identify upwind/downwind cells for each local face.  Note upwind/downwind
   // may be a ghost cell.
@@ -81,10 +92,6 @@ void UpwindTotalFlux::CalculateCoefficientsOnFaces(
     for (unsigned int n=0; n!=faces.size(); ++n) {
       int f = faces[n];
 
-      if  (face_coef->HasComponent("cell")) {        
-        (*face_coef->ViewComponent("cell",true))[0][c] = coef_cells[0][c];
-      }
-
       if (f < nfaces_local) {
         if (flux_v[0][f] * fdirs[n] > 0) {
           upwind_cell[f] = c;
@@ -103,17 +110,30 @@ void UpwindTotalFlux::CalculateCoefficientsOnFaces(
     }
   }
 
+  cell_scatter_->End();
+
+  if (face_coef->HasComponent("cell")) {
+    Epetra_MultiVector& coef_face_cells = *face_coef->ViewComponent("cell",true);
+    for (int c=0; c!=ncells; ++c) coef_face_cells[0][c] = coef_cells[0][c];
+  }
+
   // Determine the face coefficient of local faces.
   // These parameters may be key to a smooth convergence rate near zero flux.
   //  double flow_eps_factor = 1.;
   //  double min_flow_eps = 1.e-8;
-  double coefs[2];
-
+  //
+  // Faces with a bad flux are only flagged in the threaded loop, and reported
+  // after it.
   int nfaces = face_coef->size("face",false);
-  for (int f=0; f!=nfaces; ++f) {
+  std::vector<char> bad_flux(nfaces, 0);
+  Threading::parallel_for(nfaces, [&](int f) {
+    double coefs[2];
     int uw = upwind_cell[f];
     int dw = downwind_cell[f];
-    AMANZI_ASSERT(!((uw == -1) && (dw == -1)));
+    if ((uw == -1) && (dw == -1)) {
+      bad_flux[f] = 1;
+      return;
+    }
 
    
     // Teuchos::RCP<VerboseObject> dcvo_dw = Teuchos::null;
@@ -151,24 +171,30 @@ void UpwindTotalFlux::CalculateCoefficientsOnFaces(
     } else {
       // Parameterization of a linear scaling between upwind and downwind.
       double param = std::abs(flux_v[0][f]) / (2*flow_eps) + 0.5;
-      if (!(param >= 0.5) || !(param <= 1.0)) {
-        std::cout << "BAD FLUX! on face " << f << std::endl;
-        std::cout << "  flux = " << flux_v[0][f] << std::endl;
-        std::cout << "  param = " << param << std::endl;
-        std::cout << "  flow_eps = " << flow_eps << std::endl;
-      }
+      if (!(param >= 0.5) || !(param <= 1.0)) bad_flux[f] = 1;
 
       // if (dcvo_uw != Teuchos::null)
       //   *dcvo_uw->os() << "  AVG param = " << param << std::endl;
       // if (dcvo_dw != Teuchos::null)
       //   *dcvo_dw->os() << "  AVG param = " << param << std::endl;
 
-      AMANZI_ASSERT(param >= 0.5);
-      AMANZI_ASSERT(param <= 1.0);
-
       coef_faces[0][f] = coefs[0] * param + coefs[1] * (1. - param);
     }
+  });
+
+  int nbad = 0;
+  for (int f=0; f!=nfaces; ++f) {
+    if (bad_flux[f]) {
+      std::cout << "BAD FLUX! on face " << f << std::endl;
+      std::cout << "  flux = " << flux_v[0][f] << std::endl;
+      std::cout << "  param = " << std::abs(flux_v[0][f]) / (2*flux_eps_) + 0.5 << std::endl;
+      std::cout << "  upwind cell = " << upwind_cell[f]
+                << ", downwind cell = " << downwind_cell[f] << std::endl;
+      std::cout << "  flow_eps = " << flux_eps_ << std::endl;
+      nbad++;
+    }
   }
+  AMANZI_ASSERT(nbad == 0);
 };
 
 
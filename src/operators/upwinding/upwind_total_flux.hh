@@ -14,6 +14,7 @@
 #define AMANZI_UPWINDING_TOTALFLUX_SCHEME_
 
 #include "upwinding.hh"
+#include "ghost_scatter.hh"
 
 namespace Amanzi {
 
@@ -60,6 +61,10 @@ private:
   std::string face_coef_;
   std::string flux_;
   double flux_eps_;
+
+  // split-phase exchange of the cell coefficients, built on first use
+  Teuchos::RCP<GhostScatter> cell_scatter_;
+  Teuchos::RCP<const AmanziMesh::Mesh> scatter_mesh_;
 };
 
 } // namespace
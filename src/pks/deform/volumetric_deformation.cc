@@ -17,6 +17,8 @@
    /FIXME
    
    ------------------------------------------------------------------------- */
+#include <algorithm>
+
 #include "Teuchos_XMLParameterListHelpers.hpp"
 
 #include "LinearOperatorFactory.hh"
@@ -37,7 +39,8 @@ VolumetricDeformation::VolumetricDeformation(Teuchos::ParameterList& pk_tree,
                         const Teuchos::RCP<TreeVector>& solution):
   PK(pk_tree, glist,  S, solution),
   PK_Physical_Default(pk_tree, glist,  S, solution),
-  surf_mesh_(Teuchos::null)
+  surf_mesh_(Teuchos::null),
+  deform_count_(0)
 {
 
   dt_ = plist_->get<double>("max time step [s]", 1.e80);
@@ -116,6 +119,12 @@ void VolumetricDeformation::Setup(const Teuchos::Ptr<State>& S) {
   Teuchos::RCP<CompositeVectorSpace> cv_fac =  S->RequireField(Keys::getKey(domain_,"cell_volume_change"), name_);
   cv_fac->SetMesh(mesh_)->SetComponent("cell", AmanziMesh::CELL, 1);
 
+  // Create storage for the index of the last deformation that moved a node of
+  // each cell, so that consumers of the geometry can update only when needed.
+  deformed_key_ = Keys::getKey(domain_,"cell_deformation_index");
+  S->RequireField(deformed_key_, name_)->SetMesh(mesh_)
+      ->SetComponent("cell", AmanziMesh::CELL, 1);
+
   switch(deform_mode_) {
     case (DEFORM_MODE_DVDT): {
       // Create the deformation function
@@ -218,6 +227,8 @@ void VolumetricDeformation::Initialize(const Teuchos::Ptr<State>& S) {
   // initialize the deformation
   S->GetFieldData(Keys::getKey(domain_,"cell_volume_change"),name_)->PutScalar(0.);
   S->GetField(Keys::getKey(domain_,"cell_volume_change"),name_)->set_initialized();
+  S->GetFieldData(deformed_key_,name_)->PutScalar(0.);
+  S->GetField(deformed_key_,name_)->set_initialized();
 
   switch (strategy_) {
     case (DEFORM_STRATEGY_GLOBAL_OPTIMIZATION) : {
@@ -457,7 +468,13 @@ bool VolumetricDeformation::AdvanceStep(double t_old, double t_new, bool reinit)
   dcell_vol_vec->Norm2(&dcell_vol_norm);
   //  if (dcell_vol_norm > 0.) {
   if (true) {
-  
+    // save the node coordinates to find the cells that moved
+    int nnodes_all = mesh_->num_entities(AmanziMesh::NODE,
+            AmanziMesh::Parallel_type::ALL);
+    AmanziGeometry::Point_List old_positions(nnodes_all);
+    for (int n=0; n!=nnodes_all; ++n)
+      mesh_->node_get_coordinates(n, &old_positions[n]);
+
     // Deform the subsurface mesh
     switch (strategy_) {
     case (DEFORM_STRATEGY_MSTK) : {
@@ -664,6 +681,8 @@ bool VolumetricDeformation::AdvanceStep(double t_old, double t_new, bool reinit)
     default :
       AMANZI_ASSERT(0);
     }
+
+    MarkDeformedCells_(old_positions);
   }
 
   
@@ -774,5 +793,53 @@ bool VolumetricDeformation::AdvanceStep(double t_old, double t_new, bool reinit)
 }
 
 
+// -----------------------------------------------------------------------------
+// Stamp the cells with a node that moved in this deformation.
+//
+// Deformation is columnar and local, so typically only a few columns move.
+// Consumers (e.g. the flow PK's diffusion operators) compare these stamps to
+// the last deformation they processed, and skip geometry-dependent updates
+// when nothing has moved.
+//
+// Stamps must never repeat, including after a restart, where the stamps are
+// read from the checkpoint but this count starts over, so the count
+// continues from the largest stamp in the state.
+// -----------------------------------------------------------------------------
+void VolumetricDeformation::MarkDeformedCells_(const AmanziGeometry::Point_List& old_positions) {
+  Epetra_MultiVector& deformed = *S_next_->GetFieldData(deformed_key_, name_)
+      ->ViewComponent("cell",false);
+  double latest(0.);
+  deformed.MaxValue(&latest);
+  deform_count_ = std::max(deform_count_, (int) latest) + 1;
+
+  int nnodes = old_positions.size();
+  std::vector<bool> moved(nnodes, false);
+  AmanziGeometry::Point coords(mesh_->space_dimension());
+  for (int n=0; n!=nnodes; ++n) {
+    mesh_->node_get_coordinates(n, &coords);
+    moved[n] = AmanziGeometry::norm(coords - old_positions[n]) > 0.;
+  }
+
+  int n_deformed_l = 0;
+  int ncells = deformed.MyLength();
+  for (int c=0; c!=ncells; ++c) {
+    Entity_ID_List nodes;
+    mesh_->cell_get_nodes(c, &nodes);
+    for (auto n : nodes) {
+      if (moved[n]) {
+        deformed[0][c] = deform_count_;
+        n_deformed_l++;
+        break;
+      }
+    }
+  }
+
+  int n_deformed = 0;
+  mesh_->get_comm()->SumAll(&n_deformed_l, &n_deformed, 1);
+  if (vo_->os_OK(Teuchos::VERB_HIGH))
+    *vo_->os() << "Deformation " << deform_count_ << " moved nodes of "
+               << n_deformed << " cells" << std::endl;
+}
+
 } // namespace
 } // namespace
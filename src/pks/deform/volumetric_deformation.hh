@@ -88,6 +88,12 @@ node coordinate changes.  Three options are available:
     * `"Solver`" ``[linear-operator-typed-spec]`` Solver for the optimization
       problem. Only used if "deformation strategy" == "global optimization"
 
+    PUBLISHES:
+    - `"cell_deformation_index`" For each cell, the index of the last
+      deformation (counted from 1) that moved one of its nodes, or 0 if it has
+      never moved.  Used by flow to only recompute geometry-dependent operator
+      data when the mesh actually changed.
+
     EVALUATORS:
     - `"saturation_ice`"
     - `"saturation_liquid`"
@@ -154,6 +160,9 @@ class VolumetricDeformation : public PK_Physical_Default {
     dt_ = dt;
   }
 
+ private:
+  void MarkDeformedCells_(const AmanziGeometry::Point_List& old_positions);
+
  private:
 
   // strategy for calculating nodal deformation from cell volume change
@@ -193,6 +202,10 @@ class VolumetricDeformation : public PK_Physical_Default {
   Teuchos::RCP<AmanziMesh::Mesh> surf_mesh_nc_;
   Teuchos::RCP<AmanziMesh::Mesh> surf3d_mesh_nc_;
 
+  // cells moved by each deformation
+  Key deformed_key_;
+  int deform_count_;
+
   // operator
   bool global_solve_;
   Teuchos::RCP<CompositeMatrix> operator_;
@@ -10,6 +10,8 @@ Energy for a three-phase, gas+liquid+ice evaluator.
 #ifndef AMANZI_ENERGY_THREE_PHASE_ENERGY_EVALUATOR_HH_
 #define AMANZI_ENERGY_THREE_PHASE_ENERGY_EVALUATOR_HH_
 
+#include <vector>
+
 #include "Factory.hh"
 #include "secondary_variable_field_evaluator.hh"
 
@@ -34,11 +36,24 @@ class ThreePhaseEnergyEvaluator : public SecondaryVariableFieldEvaluator {
   virtual void EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
           Key wrt_key, const Teuchos::Ptr<CompositeVector>& result);
 
+  // Partial derivatives with respect to several dependencies, computed
+  // together in one pass.
+  void EvaluateFieldPartialDerivatives_(const Teuchos::Ptr<State>& S,
+          const std::vector<Key>& wrt_keys,
+          const std::vector<Teuchos::Ptr<CompositeVector> >& results);
+
   Teuchos::RCP<ThreePhaseEnergyModel> get_model() { return model_; }
 
  protected:
   void InitializeFromPlist_();
 
+  // index of a dependency in the model's argument list, or -1
+  int DependencyIndex_(const Key& key) const;
+
+  void EvaluatePartials_(const Teuchos::Ptr<State>& S,
+          const std::vector<int>& wrt,
+          const std::vector<Teuchos::Ptr<CompositeVector> >& results);
+
   Key phi_key_;
   Key phi0_key_;
   Key sl_key_;
@@ -56,6 +71,11 @@ class ThreePhaseEnergyEvaluator : public SecondaryVariableFieldEvaluator {
 
   Teuchos::RCP<ThreePhaseEnergyModel> model_;
 
+  // partial derivatives with respect to each dependency requested so far,
+  // by dependency index, valid until a dependency changes
+  std::vector<Teuchos::RCP<CompositeVector> > partials_;
+  Key partials_request_;
+
  private:
   static Utils::RegisteredFactory<FieldEvaluator,ThreePhaseEnergyEvaluator> reg_;
 
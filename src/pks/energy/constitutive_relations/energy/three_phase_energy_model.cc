@@ -121,6 +121,39 @@ ThreePhaseEnergyModel::DEnergyDCellVolume(double phi, double phi0, double sl, do
   return phi*(ng*sg*ug + ni*si*ui + nl*sl*ul) + rho_r*ur*(-phi0 + 1);
 }
 
+// value and all partial derivatives
+double
+ThreePhaseEnergyModel::EnergyAndDerivatives(double phi, double phi0, double sl, double nl, double ul, double si, double ni, double ui, double sg, double ng, double ug, double rho_r, double ur, double cv, double* dEnergy) const
+{
+  double tmp0 = 1 - phi0;
+  double tmp1 = rho_r*ur;
+  double tmp2 = ng*ug;
+  double tmp3 = ni*ui;
+  double tmp4 = nl*ul;
+  double tmp5 = sg*tmp2 + si*tmp3 + sl*tmp4;
+  double tmp6 = phi*tmp5 + tmp0*tmp1;
+  double tmp7 = cv*phi;
+  double tmp8 = sl*tmp7;
+  double tmp9 = si*tmp7;
+  double tmp10 = sg*tmp7;
+  double tmp11 = cv*tmp0;
+  dEnergy[0] = cv*tmp5;
+  dEnergy[1] = -cv*tmp1;
+  dEnergy[2] = tmp4*tmp7;
+  dEnergy[3] = tmp8*ul;
+  dEnergy[4] = nl*tmp8;
+  dEnergy[5] = tmp3*tmp7;
+  dEnergy[6] = tmp9*ui;
+  dEnergy[7] = ni*tmp9;
+  dEnergy[8] = tmp2*tmp7;
+  dEnergy[9] = tmp10*ug;
+  dEnergy[10] = ng*tmp10;
+  dEnergy[11] = tmp11*ur;
+  dEnergy[12] = rho_r*tmp11;
+  dEnergy[13] = tmp6;
+  return cv*tmp6;
+}
+
 } //namespace
 } //namespace
 } //namespace
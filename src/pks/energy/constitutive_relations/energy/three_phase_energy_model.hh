@@ -36,6 +36,10 @@ class ThreePhaseEnergyModel {
   double DEnergyDDensityRock(double phi, double phi0, double sl, double nl, double ul, double si, double ni, double ui, double sg, double ng, double ug, double rho_r, double ur, double cv) const;
   double DEnergyDInternalEnergyRock(double phi, double phi0, double sl, double nl, double ul, double si, double ni, double ui, double sg, double ng, double ug, double rho_r, double ur, double cv) const;
   double DEnergyDCellVolume(double phi, double phi0, double sl, double nl, double ul, double si, double ni, double ui, double sg, double ng, double ug, double rho_r, double ur, double cv) const;
+
+  // value, and the partial derivative with respect to each argument, in
+  // argument order, written to dEnergy
+  double EnergyAndDerivatives(double phi, double phi0, double sl, double nl, double ul, double si, double ni, double ui, double sg, double ng, double ug, double rho_r, double ur, double cv, double* dEnergy) const;
   
  protected:
   void InitializeFromPlist_(Teuchos::ParameterList& plist);
@@ -65,6 +65,10 @@ Solves an advection-diffusion equation for energy:
       terms, as all the rest default to those values from `"diffusion`".
 
     * `"preconditioner`" ``[preconditioner-typed-spec]`` The Preconditioner_
+      `"preconditioner type`" may also be `"column line`", see
+      preconditioner-column-line-spec_, or `"single precision ILU`", see
+      preconditioner-single-precision-spec_.  These require a `"fv:
+      default`" discretization.
 
     * `"linear solver`" ``[linear-solver-typed-spec]`` A `LinearOperator`_
       
@@ -169,7 +173,7 @@ Solves an advection-diffusion equation for energy:
 namespace Amanzi {
 
 // forward declarations
-namespace Operators { class Advection; }
+namespace Operators { class Advection; class PreconditionerColumnLine; class PreconditionerSinglePrecision; }
 namespace Functions { class BoundaryFunction; }
 
 namespace Energy {
@@ -198,9 +202,10 @@ public:
   virtual void CalculateDiagnostics(const Teuchos::RCP<State>& S) override {}
 
   // Default implementations of BDFFnBase methods.
-  // -- Compute a norm on u-du and return the result.
-  virtual double ErrorNorm(Teuchos::RCP<const TreeVector> u,
-                       Teuchos::RCP<const TreeVector> du) override;
+  // -- Compute the local part of a norm on u-du.
+  virtual void ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
+                              Teuchos::RCP<const TreeVector> du,
+                              std::vector<double>& norms) override;
 
   // EnergyBase is a BDFFnBase
   // computes the non-linear functional f = f(t,u,udot)
@@ -293,6 +298,8 @@ public:
   Teuchos::RCP<Operators::PDE_Accumulation> preconditioner_acc_;
   Teuchos::RCP<Operators::PDE_AdvectionUpwind> preconditioner_adv_;
   Teuchos::RCP<Operators::Operator> lin_solver_;
+  Teuchos::RCP<Operators::PreconditionerColumnLine> column_pc_;
+  Teuchos::RCP<Operators::PreconditionerSinglePrecision> single_pc_;
 
   // flags and control
   bool modify_predictor_with_consistent_faces_;
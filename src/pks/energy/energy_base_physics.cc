@@ -15,6 +15,7 @@ de/dt + q dot grad h = div Ke grad T + S?
 #include "FieldEvaluator.hh"
 #include "energy_base.hh"
 #include "Op.hh"
+#include "parallel_for.hh"
 
 namespace Amanzi {
 namespace Energy {
@@ -122,9 +123,9 @@ void EnergyBase::AddSources_(const Teuchos::Ptr<State>& S,
 
     // Add into residual
     unsigned int ncells = g_c.MyLength();
-    for (unsigned int c=0; c!=ncells; ++c) {
-      g_c[0][c] -= source1[0][c] * cv[0][c];
-    }
+    Threading::parallel_for(ncells, [&](int c) {
+        g_c[0][c] -= source1[0][c] * cv[0][c];
+      });
 
     if (vo_->os_OK(Teuchos::VERB_EXTREME))
       *vo_->os() << "Adding external source term" << std::endl;
@@ -15,6 +15,8 @@ Author: Ethan Coon
 #include "PDE_Diffusion.hh"
 #include "PDE_AdvectionUpwind.hh"
 #include "LinearOperatorFactory.hh"
+#include "PreconditionerColumnLine.hh"
+#include "PreconditionerSinglePrecision.hh"
 #include "upwind_cell_centered.hh"
 #include "upwind_arithmetic_mean.hh"
 #include "upwind_total_flux.hh"
@@ -171,6 +173,8 @@ void EnergyBase::SetupEnergy_(const Teuchos::Ptr<State>& S) {
   //    derivative.
   jacobian_ = mfd_pc_plist.get<std::string>("Newton correction", "none") != "none";
   if (jacobian_) {
+    newton_control_ = Teuchos::rcp(new NewtonCorrectionControl(mfd_pc_plist, vo_));
+
     // if (preconditioner_->RangeMap().HasComponent("face")) {
     if (mfd_pc_plist.get<std::string>("discretization primary") != "fv: default"){
       // MFD -- upwind required
@@ -218,8 +222,22 @@ void EnergyBase::SetupEnergy_(const Teuchos::Ptr<State>& S) {
   //    symbolic assemble
   precon_used_ = plist_->isSublist("preconditioner");
   if (precon_used_) {
-    preconditioner_->SymbolicAssembleMatrix();
-    preconditioner_->InitializePreconditioner(plist_->sublist("preconditioner"));
+    pc_structure_->SymbolicAssemble(name_, *preconditioner_);
+    std::string pc_type = plist_->sublist("preconditioner").get<std::string>("preconditioner type", "");
+    if (pc_type == "column line" || pc_type == "single precision ILU") {
+      if (mfd_pc_plist.get<std::string>("discretization primary") != "fv: default") {
+        Errors::Message msg;
+        msg << "Energy PK: the \"" << pc_type << "\" preconditioner requires an \"fv: default\" discretization.";
+        Exceptions::amanzi_throw(msg);
+      }
+      if (pc_type == "column line") {
+        column_pc_ = Teuchos::rcp(new Operators::PreconditionerColumnLine(plist_->sublist("preconditioner"), mesh_));
+      } else {
+        single_pc_ = Teuchos::rcp(new Operators::PreconditionerSinglePrecision(plist_->sublist("preconditioner")));
+      }
+    } else {
+      preconditioner_->InitializePreconditioner(plist_->sublist("preconditioner"));
+    }
 
     //    Potentially create a linear solver
     if (plist_->isSublist("linear solver")) {
@@ -305,6 +323,12 @@ void EnergyBase::SetupEnergy_(const Teuchos::Ptr<State>& S) {
   S->RequireField(adv_energy_flux_key_, name_)->SetMesh(mesh_)->SetGhosted()
       ->SetComponent("face", AmanziMesh::FACE, 1);
 
+  // -- history-based predictors, extrapolating in energy is not supported
+  if (predictor_ != Teuchos::null && predictor_->type() == "conserved variable") {
+    Errors::Message msg("EnergyBase: \"predictor type\" \"conserved variable\" is not supported.");
+    Exceptions::amanzi_throw(msg);
+  }
+
   // -- simply limit to close to 0
   modify_predictor_for_freezing_ =
       plist_->get<bool>("modify predictor for freezing", false);
@@ -722,13 +746,18 @@ bool EnergyBase::ModifyPredictor(double h, Teuchos::RCP<const TreeVector> u0,
   bc_temperature_->Compute(S_next_->time());
   bc_flux_->Compute(S_next_->time());
   UpdateBoundaryConditions_(S_next_.ptr());
-  
+
+  // history-based predictors replace the linear extrapolant
+  bool modified = false;
+  if (predictor_ != Teuchos::null) {
+    modified |= predictor_->ModifyPredictor(S_next_->time(), u);
+  }
+
   // push Dirichlet data into predictor
   if (u->Data()->HasComponent("boundary_cell")) {
     ApplyBoundaryConditions_(u->Data().ptr());
   }
 
-  bool modified = false;
   if (modify_predictor_for_freezing_) {
     const Epetra_MultiVector& u0_c = *u0->Data()->ViewComponent("cell",false);
     Epetra_MultiVector& u_c = *u->Data()->ViewComponent("cell",false);
@@ -747,6 +776,8 @@ bool EnergyBase::ModifyPredictor(double h, Teuchos::RCP<const TreeVector> u0,
     CalculateConsistentFaces(u->Data().ptr());
     modified = true;
   }
+
+  if (predictor_ != Teuchos::null) predictor_->RecordPredictor(*u);
   return modified;
 }
 
@@ -15,6 +15,8 @@ Author: Ethan Coon
 #include "FieldEvaluator.hh"
 #include "energy_base.hh"
 #include "Op.hh"
+#include "PreconditionerColumnLine.hh"
+#include "PreconditionerSinglePrecision.hh"
 
 namespace Amanzi {
 namespace Energy {
@@ -131,7 +133,20 @@ int EnergyBase::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u, Teuchos::R
 #endif
 
   // apply the preconditioner
-  int ierr = preconditioner_->ApplyInverse(*u->Data(), *Pu->Data());
+  int ierr = 0;
+  if (column_pc_ != Teuchos::null) {
+    Pu->PutScalar(0.);
+    column_pc_->ApplyInverse(*u->Data()->ViewComponent("cell",false),
+                             *Pu->Data()->ViewComponent("cell",false));
+    ierr = 1;
+  } else if (single_pc_ != Teuchos::null) {
+    Pu->PutScalar(0.);
+    single_pc_->ApplyInverse(*u->Data()->ViewComponent("cell",false),
+                             *Pu->Data()->ViewComponent("cell",false));
+    ierr = 1;
+  } else {
+    ierr = preconditioner_->ApplyInverse(*u->Data(), *Pu->Data());
+  }
 
 #if DEBUG_FLAG
   db_->WriteVector("PC*T_res", Pu->Data().ptr(), true);
@@ -150,8 +165,10 @@ void EnergyBase::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> u
   if (vo_->os_OK(Teuchos::VERB_HIGH))
     *vo_->os() << "Precon update at t = " << t << std::endl;
 
-  // update state with the solution up.
+  // decide whether to include the Newton correction in this update
+  bool newton = jacobian_ && newton_control_->UpdatePreconditioner(t);
 
+  // update state with the solution up.
   AMANZI_ASSERT(std::abs(S_next_->time() - t) <= 1.e-4*t);
   PK_PhysicalBDF_Default::Solution_to_State(*up, S_next_);
 
@@ -165,14 +182,14 @@ void EnergyBase::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> u
 
   // div K_e grad u
   UpdateConductivityData_(S_next_.ptr());
-  if (jacobian_) UpdateConductivityDerivativeData_(S_next_.ptr());
+  if (newton) UpdateConductivityDerivativeData_(S_next_.ptr());
 
   Teuchos::RCP<const CompositeVector> conductivity =
       S_next_->GetFieldData(uw_conductivity_key_);
 
   // jacobian term
   Teuchos::RCP<const CompositeVector> dKdT = Teuchos::null;
-  if (jacobian_) {
+  if (newton) {
     if (!duw_conductivity_key_.empty()) {
       dKdT = S_next_->GetFieldData(duw_conductivity_key_);
     } else {
@@ -186,7 +203,7 @@ void EnergyBase::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> u
   preconditioner_diff_->UpdateMatrices(Teuchos::null, temp.ptr());
   preconditioner_diff_->ApplyBCs(true, true, true);
 
-  if (jacobian_) {
+  if (newton) {
     Teuchos::RCP<CompositeVector> flux = Teuchos::null;
 
     flux = S_next_->GetFieldData(energy_flux_key_, name_);
@@ -258,15 +275,23 @@ void EnergyBase::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> u
   preconditioner_diff_->ApplyBCs(true, true, true);
   if (precon_used_) {
     preconditioner_->AssembleMatrix();
-    preconditioner_->UpdatePreconditioner();
+    pc_structure_->Check(name_, *preconditioner_);
+    if (column_pc_ != Teuchos::null) {
+      column_pc_->Update(preconditioner_->A());
+    } else if (single_pc_ != Teuchos::null) {
+      single_pc_->Update(preconditioner_->A());
+    } else {
+      preconditioner_->UpdatePreconditioner();
+    }
   }
 };
 
 // -----------------------------------------------------------------------------
 // Default enorm that uses an abs and rel tolerance to monitor convergence.
+// This is the local part, reduced by PK_PhysicalBDF_Default::ErrorNorm().
 // -----------------------------------------------------------------------------
-double EnergyBase::ErrorNorm(Teuchos::RCP<const TreeVector> u,
-        Teuchos::RCP<const TreeVector> res) {
+void EnergyBase::ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
+        Teuchos::RCP<const TreeVector> res, std::vector<double>& norms) {
   // Abs tol based on old conserved quantity -- we know these have been vetted
   // at some level whereas the new quantity is some iterate, and may be
   // anything from negative to overflow.
@@ -325,14 +350,12 @@ double EnergyBase::ErrorNorm(Teuchos::RCP<const TreeVector> u,
     } else if (*comp == std::string("face")) {
       // error in flux -- relative to cell's extensive conserved quantity
       int nfaces = dvec->size(*comp, false);
+      const auto& face_cells = ErrorNormFaceCells_();
 
       for (unsigned int f=0; f!=nfaces; ++f) {
-        AmanziMesh::Entity_ID_List cells;
-        mesh_->face_get_cells(f, AmanziMesh::Parallel_type::OWNED, &cells);
-        double cv_min = cells.size() == 1 ? cv[0][cells[0]]
-            : std::min(cv[0][cells[0]],cv[0][cells[1]]);
-        double mass_min = cells.size() == 1 ? wc[0][cells[0]]/cv[0][cells[0]]
-          : std::min(wc[0][cells[0]]/cv[0][cells[0]], wc[0][cells[1]]/cv[0][cells[1]]);
+        int c0 = face_cells[2*f], c1 = face_cells[2*f+1];
+        double cv_min = std::min(cv[0][c0], cv[0][c1]);
+        double mass_min = std::min(wc[0][c0]/cv[0][c0], wc[0][c1]/cv[0][c1]);
         mass_min = std::max(mass_min, mass_atol_);
 
         double energy = mass_min * atol_ + soil_atol_;
@@ -372,12 +395,7 @@ double EnergyBase::ErrorNorm(Teuchos::RCP<const TreeVector> u,
     enorm_val = std::max(enorm_val, enorm_comp);
   }
 
-  double enorm_val_l = enorm_val;
-
-  int ierr;
-  ierr = MPI_Allreduce(&enorm_val_l, &enorm_val, 1, MPI_DOUBLE, MPI_MAX, comm);
-  AMANZI_ASSERT(!ierr);
-  return enorm_val;
+  norms.push_back(enorm_val);
 };
 
 
@@ -132,7 +132,13 @@ InterfrostEnergy::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector>
   preconditioner_diff_->ApplyBCs(true, true, true);
   if (precon_used_) {
     preconditioner_->AssembleMatrix();
-    preconditioner_->UpdatePreconditioner();
+    if (column_pc_ != Teuchos::null) {
+      column_pc_->Update(preconditioner_->A());
+    } else if (single_pc_ != Teuchos::null) {
+      single_pc_->Update(preconditioner_->A());
+    } else {
+      preconditioner_->UpdatePreconditioner();
+    }
   }
 };
 
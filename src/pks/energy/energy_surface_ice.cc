@@ -13,6 +13,7 @@ Process kernel for energy equation for overland flow.
 #include "Debugger.hh"
 #include "eos_evaluator.hh"
 #include "iem_evaluator.hh"
+#include "ProfiledFieldEvaluator.hh"
 #include "thermal_conductivity_surface_evaluator.hh"
 #include "enthalpy_evaluator.hh"
 #include "energy_bc_factory.hh"
@@ -197,7 +198,7 @@ void EnergySurfaceIce::Initialize(const Teuchos::Ptr<State>& S) {
     S->GetFieldEvaluator(Keys::getKey(domain_,"molar_density_liquid"));
 
   Teuchos::RCP<Relations::EOSEvaluator> eos_eval =
-    Teuchos::rcp_dynamic_cast<Relations::EOSEvaluator>(eos_fe);
+    Teuchos::rcp_dynamic_cast<Relations::EOSEvaluator>(Relations::get_wrapped(eos_fe));
   AMANZI_ASSERT(eos_eval != Teuchos::null);
   eos_liquid_ = eos_eval->get_EOS();
 
@@ -205,7 +206,7 @@ void EnergySurfaceIce::Initialize(const Teuchos::Ptr<State>& S) {
     S->GetFieldEvaluator(Keys::getKey(domain_,"internal_energy_liquid"));
 
   Teuchos::RCP<Energy::IEMEvaluator> iem_eval =
-    Teuchos::rcp_dynamic_cast<Energy::IEMEvaluator>(iem_fe);
+    Teuchos::rcp_dynamic_cast<Energy::IEMEvaluator>(Relations::get_wrapped(iem_fe));
 
   AMANZI_ASSERT(iem_eval != Teuchos::null);
   iem_liquid_ = iem_eval->get_IEM();
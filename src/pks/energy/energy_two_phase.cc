@@ -12,6 +12,7 @@ Process kernel for energy equation for Richard's flow.
 
 #include "eos_evaluator_tp.hh"
 #include "iem_evaluator.hh"
+#include "ProfiledFieldEvaluator.hh"
 #include "thermal_conductivity_twophase_evaluator.hh"
 #include "enthalpy_evaluator.hh"
 #include "energy_bc_factory.hh"
@@ -72,14 +73,14 @@ void TwoPhase::Initialize(const Teuchos::Ptr<State>& S) {
   Teuchos::RCP<FieldEvaluator> eos_fe =
     S->GetFieldEvaluator(Keys::getKey(domain_, "molar_density_liquid"));
   Teuchos::RCP<Relations::EOSEvaluator> eos_eval =
-    Teuchos::rcp_dynamic_cast<Relations::EOSEvaluator>(eos_fe);
+    Teuchos::rcp_dynamic_cast<Relations::EOSEvaluator>(Relations::get_wrapped(eos_fe));
   AMANZI_ASSERT(eos_eval != Teuchos::null);
   eos_liquid_ = eos_eval->get_EOS();
 
   Teuchos::RCP<FieldEvaluator> iem_fe =
     S->GetFieldEvaluator(Keys::getKey(domain_, "internal_energy_liquid"));
   Teuchos::RCP<Energy::IEMEvaluator> iem_eval =
-    Teuchos::rcp_dynamic_cast<Energy::IEMEvaluator>(iem_fe);
+    Teuchos::rcp_dynamic_cast<Energy::IEMEvaluator>(Relations::get_wrapped(iem_fe));
   AMANZI_ASSERT(iem_eval != Teuchos::null);
   iem_liquid_ = iem_eval->get_IEM();
 
@@ -0,0 +1,164 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/* -------------------------------------------------------------------------
+ATS
+
+License: see $ATS_DIR/COPYRIGHT
+Author: Ethan Coon
+
+Concurrent update of independent branches of the evaluator DAG.
+------------------------------------------------------------------------- */
+
+#include <algorithm>
+#include <exception>
+
+#include "Teuchos_ConfigDefs.hpp"
+
+#include "errors.hh"
+#include "parallel_for.hh"
+
+#include "evaluator_scheduler.hh"
+
+namespace Amanzi {
+
+EvaluatorScheduler::EvaluatorScheduler(const std::string& name,
+        const std::vector<Key>& roots,
+        const KeySet& excluded) :
+    request_(name + " scheduler"),
+    roots_(roots),
+    excluded_(excluded),
+    concurrent_(false),
+    setup_(false) {}
+
+
+int
+EvaluatorScheduler::FindLabel_(const std::vector<int>& label, int i)
+{
+  while (label[i] != i) i = label[i];
+  return i;
+}
+
+
+void
+EvaluatorScheduler::Setup(const Teuchos::Ptr<State>& S)
+{
+  // The closure of each root: the root and every field it depends upon.
+  std::vector<Key> roots;
+  std::vector<KeySet> closures;
+  for (std::vector<Key>::const_iterator root=roots_.begin(); root!=roots_.end(); ++root) {
+    if (!S->HasFieldEvaluator(*root)) {
+      Errors::Message msg;
+      msg << "EvaluatorScheduler: root \"" << *root << "\" has no evaluator.";
+      Exceptions::amanzi_throw(msg);
+    }
+
+    Teuchos::RCP<FieldEvaluator> fe = S->GetFieldEvaluator(*root);
+    KeySet closure;
+    closure.insert(*root);
+    for (State::field_iterator field=S->field_begin(); field!=S->field_end(); ++field) {
+      if (fe->IsDependency(S, field->first)) closure.insert(field->first);
+    }
+
+    bool excluded = false;
+    for (KeySet::const_iterator key=closure.begin(); key!=closure.end(); ++key) {
+      if (excluded_.count(*key)) excluded = true;
+    }
+    if (!excluded) {
+      roots.push_back(*root);
+      closures.push_back(closure);
+    }
+  }
+
+  // Roots sharing a field are in the same group.  Groups are the sets of a
+  // union-find, each labeled by its first root.
+  int nroots = roots.size();
+  std::vector<int> label(nroots);
+  for (int i=0; i!=nroots; ++i) label[i] = i;
+  for (int i=0; i!=nroots; ++i) {
+    for (int j=0; j!=i; ++j) {
+      bool shared = false;
+      for (KeySet::const_iterator key=closures[i].begin(); key!=closures[i].end(); ++key) {
+        if (closures[j].count(*key)) { shared = true; break; }
+      }
+      if (shared) {
+        int li = FindLabel_(label, i);
+        int lj = FindLabel_(label, j);
+        label[std::max(li, lj)] = std::min(li, lj);
+      }
+    }
+  }
+
+  groups_.clear();
+  std::vector<int> group_of_label(nroots, -1);
+  for (int i=0; i!=nroots; ++i) {
+    int l = FindLabel_(label, i);
+    if (group_of_label[l] < 0) {
+      group_of_label[l] = groups_.size();
+      groups_.push_back(std::vector<Key>());
+    }
+    groups_[group_of_label[l]].push_back(roots[i]);
+  }
+
+  // Evaluators are looked up once, as RCP copies outside of a group would
+  // race on their reference counts.
+  evaluators_.resize(groups_.size());
+  for (int g=0; g!=groups_.size(); ++g) {
+    for (std::vector<Key>::const_iterator root=groups_[g].begin(); root!=groups_[g].end(); ++root) {
+      evaluators_[g].push_back(S->GetFieldEvaluator(*root));
+    }
+  }
+
+  int nprocs = S->GetMesh()->get_comm()->NumProc();
+  concurrent_ = groups_.size() > 1 && nprocs == 1 && Threading::num_threads() > 1;
+#ifndef HAVE_TEUCHOS_THREAD_SAFE
+  // Evaluators still share the meshes, whose reference counts are only
+  // atomic in thread safe builds of Teuchos.
+  concurrent_ = false;
+#endif
+  setup_ = true;
+}
+
+
+bool
+EvaluatorScheduler::Update(const Teuchos::Ptr<State>& S)
+{
+  if (!setup_) Setup(S);
+
+  int ngroups = groups_.size();
+  std::vector<int> changed(ngroups, 0);
+
+  if (!concurrent_) {
+    for (int g=0; g!=ngroups; ++g) {
+      for (int r=0; r!=evaluators_[g].size(); ++r) {
+        changed[g] |= evaluators_[g][r]->HasFieldChanged(S, request_);
+      }
+    }
+  } else {
+    // Exceptions may not leave a parallel region, so the first of each group
+    // is kept and rethrown, in order of the groups, once all are done.
+    std::vector<std::exception_ptr> errors(ngroups);
+
+#ifdef ATS_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic,1)
+#endif
+    for (int g=0; g<ngroups; ++g) {
+      try {
+        for (int r=0; r!=evaluators_[g].size(); ++r) {
+          changed[g] |= evaluators_[g][r]->HasFieldChanged(S, request_);
+        }
+      } catch (...) {
+        errors[g] = std::current_exception();
+      }
+    }
+
+    for (int g=0; g!=ngroups; ++g) {
+      if (errors[g]) std::rethrow_exception(errors[g]);
+    }
+  }
+
+  bool any_changed = false;
+  for (int g=0; g!=ngroups; ++g) any_changed |= (changed[g] != 0);
+  return any_changed;
+}
+
+} // namespace
@@ -0,0 +1,94 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! Concurrent update of independent branches of the evaluator DAG.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+
+/*!
+
+HasFieldChanged() updates the dependencies of an evaluator depth-first, one
+after the other, so independent branches of the DAG, e.g. the subsurface and
+surface water contents, are never evaluated at the same time.  This
+scheduler is given a list of root keys, which PKs will request later.  At
+setup it finds the evaluators each root depends upon, and splits the roots
+into groups sharing no evaluator, primary variables included.  Update() then
+brings every root up to date, running the groups concurrently and the roots
+of a group in order.
+
+Evaluators are not thread safe, but an evaluator is only ever called from
+within its own group, so the results are identical to a serial update.
+Roots depending upon one of the excluded keys, e.g. a field that is set
+between the PKs' residuals, are dropped, as they would be out of date.
+
+Groups run concurrently only when ATS is configured with
+`ATS_ENABLE_OPENMP` against a thread safe build of Teuchos (the groups still
+share meshes, and so their reference counts), more than one thread is
+available, and the run is on a single MPI process: evaluators scatter ghost
+values, and concurrent scatters between the same processes may not be
+matched.  Otherwise Update() is a
+serial update of the roots.  Loops within evaluators (see parallel_for.hh)
+run on one thread while groups are concurrent, so this pays off when there
+are more independent groups than loops long enough to be threaded.
+
+*/
+
+#ifndef ATS_PK_EVALUATOR_SCHEDULER_HH_
+#define ATS_PK_EVALUATOR_SCHEDULER_HH_
+
+#include <string>
+#include <vector>
+
+#include "Teuchos_Ptr.hpp"
+
+#include "Key.hh"
+#include "FieldEvaluator.hh"
+#include "State.hh"
+
+namespace Amanzi {
+
+class EvaluatorScheduler {
+
+ public:
+  // The name is used to request the roots, and must be unique.
+  EvaluatorScheduler(const std::string& name,
+                     const std::vector<Key>& roots,
+                     const KeySet& excluded);
+
+  // Find the groups.  Called by the first Update() if needed, once all
+  // evaluators exist.
+  void Setup(const Teuchos::Ptr<State>& S);
+
+  // Bring all roots up to date.  Returns true if any of them changed.
+  bool Update(const Teuchos::Ptr<State>& S);
+
+  bool is_setup() const { return setup_; }
+
+  // Groups of roots, in order of their first root.
+  const std::vector<std::vector<Key> >& get_groups() const { return groups_; }
+
+  // True if groups are run concurrently.
+  bool concurrent() const { return concurrent_; }
+
+ protected:
+  static int FindLabel_(const std::vector<int>& label, int i);
+
+ protected:
+  std::string request_;
+  std::vector<Key> roots_;
+  KeySet excluded_;
+
+  std::vector<std::vector<Key> > groups_;
+  std::vector<std::vector<Teuchos::RCP<FieldEvaluator> > > evaluators_;
+  bool concurrent_;
+  bool setup_;
+};
+
+} // namespace
+
+#endif
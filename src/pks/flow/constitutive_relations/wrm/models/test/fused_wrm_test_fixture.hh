@@ -0,0 +1,178 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+/* -------------------------------------------------------------------------
+   ATS
+
+   License: see $ATS_DIR/COPYRIGHT
+
+   Helpers shared by the unit tests of the fused WRM saturation and relative
+   permeability chain: a mesh with two regions, their WRM parameters, and a
+   state computing the chain fused or unfused.
+   ------------------------------------------------------------------------- */
+
+#ifndef FUSED_WRM_TEST_FIXTURE_HH_
+#define FUSED_WRM_TEST_FIXTURE_HH_
+
+#include <string>
+#include <vector>
+
+#include "Teuchos_ParameterList.hpp"
+#include "Teuchos_RCP.hpp"
+
+#include "AmanziComm.hh"
+#include "GeometricModel.hh"
+#include "MeshFactory.hh"
+#include "State.hh"
+
+#include "FusedPointwiseEvaluator.hh"
+#include "PrimaryVariableChangeSetEvaluator.hh"
+#include "rel_perm_evaluator.hh"
+#include "wrm_evaluator.hh"
+
+namespace FusedWRMTest {
+
+using namespace Amanzi;
+
+const Key pc_key("capillary_pressure_gas_liq");
+
+
+// 40 cells, in a bottom and a top region
+inline Teuchos::RCP<AmanziMesh::Mesh>
+CreateMesh()
+{
+  auto comm = getDefaultComm();
+  Teuchos::ParameterList region_list;
+  Teuchos::Array<double> low(3, -1.e10), high(3, 1.e10);
+  high[2] = 5.;
+  region_list.sublist("bottom").sublist("region: box").set("low coordinate", low);
+  region_list.sublist("bottom").sublist("region: box").set("high coordinate", high);
+  low[2] = 5.;
+  high[2] = 1.e10;
+  region_list.sublist("top").sublist("region: box").set("low coordinate", low);
+  region_list.sublist("top").sublist("region: box").set("high coordinate", high);
+  auto gm = Teuchos::rcp(new AmanziGeometry::GeometricModel(3, region_list, *comm));
+
+  AmanziMesh::MeshFactory factory(comm, gm);
+  return factory.create(0., 0., 0., 2., 1., 10., 2, 1, 20);
+}
+
+
+// van Genuchten, different in the bottom and top halves of the domain
+inline Teuchos::ParameterList
+WRMParameters()
+{
+  Teuchos::ParameterList plist;
+  Teuchos::ParameterList& bottom = plist.sublist("bottom");
+  bottom.set<std::string>("region", "bottom");
+  bottom.set<std::string>("WRM Type", "van Genuchten");
+  bottom.set("van Genuchten alpha", 2.e-4);
+  bottom.set("van Genuchten m", 0.4);
+  bottom.set("residual saturation", 0.1);
+
+  Teuchos::ParameterList& top = plist.sublist("top");
+  top.set<std::string>("region", "top");
+  top.set<std::string>("WRM Type", "van Genuchten");
+  top.set("van Genuchten alpha", 5.e-4);
+  top.set("van Genuchten m", 0.6);
+  top.set("residual saturation", 0.05);
+  top.set("smoothing interval width [saturation]", 0.05);
+  return plist;
+}
+
+
+// A state with capillary pressure, density and viscosity as primary
+// variables with change sets, initialized from saturated to dry through both
+// regions, and saturation and relative permeability computed either by one
+// fused evaluator, evaluated incrementally or not, or by WRMEvaluator and
+// RelPermEvaluator.
+inline Teuchos::RCP<State>
+CreateState(const Teuchos::RCP<AmanziMesh::Mesh>& mesh, bool fused,
+            bool incremental=false)
+{
+  Teuchos::ParameterList state_plist;
+  Teuchos::RCP<State> S = Teuchos::rcp(new State(state_plist));
+  S->RegisterDomainMesh(mesh);
+
+  std::vector<std::string> names = { "cell", "boundary_face" };
+  std::vector<AmanziMesh::Entity_kind> locations = { AmanziMesh::CELL, AmanziMesh::BOUNDARY_FACE };
+  std::vector<int> num_dofs(2, 1);
+
+  std::vector<Key> deps = { pc_key, "molar_density_liquid", "viscosity_liquid" };
+  for (const auto& key : deps) {
+    S->RequireField(key, key)->SetMesh(mesh)->SetGhosted()
+        ->SetComponents(names, locations, num_dofs);
+    Teuchos::ParameterList pv_plist;
+    pv_plist.set<std::string>("evaluator name", key);
+    S->SetFieldEvaluator(key,
+            Teuchos::rcp(new Relations::PrimaryVariableChangeSetEvaluator(pv_plist)));
+  }
+
+  if (fused) {
+    Teuchos::ParameterList plist("saturation_liquid");
+    Teuchos::Array<std::string> outputs(2);
+    outputs[0] = "saturation_liquid";
+    outputs[1] = "relative_permeability";
+    plist.set("output keys", outputs);
+    // tiles not dividing the number of entities
+    plist.set("tile size", 7);
+    plist.set("incremental evaluation", incremental);
+
+    Teuchos::ParameterList& sat_plist = plist.sublist("kernels").sublist("saturation");
+    sat_plist.set<std::string>("kernel type", "WRM saturation");
+    sat_plist.set("WRM parameters", WRMParameters());
+    Teuchos::ParameterList& kr_plist = plist.sublist("kernels").sublist("relative permeability");
+    kr_plist.set<std::string>("kernel type", "WRM relative permeability");
+    kr_plist.set("permeability rescaling", 1.e7);
+    kr_plist.set("WRM parameters", WRMParameters());
+
+    Teuchos::RCP<FieldEvaluator> fe = Teuchos::rcp(new Relations::FusedPointwiseEvaluator(plist));
+    S->SetFieldEvaluator("saturation_liquid", fe);
+    S->SetFieldEvaluator("relative_permeability", fe);
+
+  } else {
+    Teuchos::ParameterList wrm_plist("saturation_liquid");
+    wrm_plist.set("WRM parameters", WRMParameters());
+    Teuchos::RCP<FieldEvaluator> wrm = Teuchos::rcp(new Flow::WRMEvaluator(wrm_plist));
+    S->SetFieldEvaluator("saturation_liquid", wrm);
+    S->SetFieldEvaluator("saturation_gas", wrm);
+
+    Teuchos::ParameterList kr_plist("relative_permeability");
+    kr_plist.set("permeability rescaling", 1.e7);
+    kr_plist.set("WRM parameters", WRMParameters());
+    S->SetFieldEvaluator("relative_permeability",
+                         Teuchos::rcp(new Flow::RelPermEvaluator(kr_plist)));
+  }
+
+  std::vector<Key> keys = { "saturation_liquid", "relative_permeability" };
+  for (const auto& key : keys) {
+    S->RequireField(key, key)->SetMesh(mesh)->SetGhosted()
+        ->SetComponents(names, locations, num_dofs);
+    S->RequireFieldEvaluator(key)->EnsureCompatibility(S.ptr());
+  }
+  S->Setup();
+
+  for (const auto& key : deps) {
+    CompositeVector& dep = *S->GetFieldData(key, key);
+    for (const auto& comp : names) {
+      Epetra_MultiVector& dep_v = *dep.ViewComponent(comp, false);
+      int n = dep_v.MyLength();
+      for (int i=0; i!=n; ++i) {
+        double x = (double) i / n;
+        if (key == pc_key) {
+          dep_v[0][i] = -2.e3 + 1.e5 * x;
+        } else if (key == "molar_density_liquid") {
+          dep_v[0][i] = 5.5e4 + 1.e2 * x;
+        } else {
+          dep_v[0][i] = 8.9e-4 * (1. + 0.1 * x);
+        }
+      }
+    }
+    S->GetField(key, key)->set_initialized();
+    Teuchos::rcp_dynamic_cast<Relations::PrimaryVariableChangeSetEvaluator>(
+        S->GetFieldEvaluator(key))->SetFieldAsChanged(S.ptr());
+  }
+  return S;
+}
+
+} // namespace FusedWRMTest
+
+#endif
@@ -0,0 +1,97 @@
+/*
+  Cost and accuracy of a tabulated van Genuchten WRM against the analytic
+  model, pointwise and batched.  Run as:
+
+    tabulated_benchmark [ncells] [repeats] [accuracy bound]
+
+  Errors are max absolute errors over the evaluated pressures.
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include "Teuchos_ParameterList.hpp"
+
+#include "wrm_van_genuchten.hh"
+#include "wrm_tabulated.hh"
+
+
+// time of repeats of f(), per evaluation in ns
+template<class F>
+double time_ns(const F& f, int repeats, int n) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (int k=0; k!=repeats; ++k) f();
+  std::chrono::duration<double, std::nano> t = std::chrono::steady_clock::now() - t0;
+  return t.count() / repeats / n;
+}
+
+
+int main(int argc, char *argv[])
+{
+  using namespace Amanzi::Flow;
+
+  int ncells = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  int repeats = argc > 2 ? std::atoi(argv[2]) : 20;
+  double tol = argc > 3 ? std::atof(argv[3]) : 1.e-6;
+
+  Teuchos::ParameterList plist;
+  plist.set("WRM Type", std::string("tabulated"));
+  plist.set("accuracy bound", tol);
+  Teuchos::ParameterList& model_plist = plist.sublist("tabulated model");
+  model_plist.set("WRM Type", std::string("van Genuchten"));
+  model_plist.set("van Genuchten m", 0.3);
+  model_plist.set("van Genuchten alpha", 5.e-4);
+  model_plist.set("residual saturation", 0.1);
+
+  WRMVanGenuchten vG(model_plist);
+  WRMTabulated tab(plist);
+
+  // unsaturated pressures, log-spaced over the table
+  std::vector<double> pc(ncells), s(ncells), ds(ncells), kr(ncells), dkr(ncells);
+  std::vector<double> s_t(ncells), ds_t(ncells), kr_t(ncells), dkr_t(ncells);
+  for (int c=0; c!=ncells; ++c) pc[c] = std::pow(10., 1. + 6. * c / ncells);
+
+  std::cout << "Tabulated van Genuchten: " << tab.num_nodes_saturation() << " saturation nodes, "
+            << tab.num_nodes_k_relative() << " relative permeability nodes, bound "
+            << tol << std::endl
+            << "  setup error: saturation " << tab.error_saturation()
+            << ", relative permeability " << tab.error_k_relative() << std::endl;
+
+  auto pointwise = [&](WRM& wrm, std::vector<double>& s, std::vector<double>& ds,
+                       std::vector<double>& kr, std::vector<double>& dkr) {
+    for (int c=0; c!=ncells; ++c) {
+      s[c] = wrm.saturation(pc[c]);
+      ds[c] = wrm.d_saturation(pc[c]);
+      kr[c] = wrm.k_relative(s[c]);
+      dkr[c] = wrm.d_k_relative(s[c]);
+    }
+  };
+
+  double t_vg = time_ns([&]() { pointwise(vG, s, ds, kr, dkr); }, repeats, ncells);
+  double t_vg_b = time_ns([&]() {
+      vG.evaluate_batch(ncells, &pc[0], &s[0], &ds[0], &kr[0], &dkr[0]); }, repeats, ncells);
+  double t_tab = time_ns([&]() { pointwise(tab, s_t, ds_t, kr_t, dkr_t); }, repeats, ncells);
+  double t_tab_b = time_ns([&]() {
+      tab.evaluate_batch(ncells, &pc[0], &s_t[0], &ds_t[0], &kr_t[0], &dkr_t[0]); }, repeats, ncells);
+
+  double err_s = 0., err_ds = 0., err_kr = 0., err_dkr = 0.;
+  for (int c=0; c!=ncells; ++c) {
+    err_s = std::max(err_s, std::abs(s[c] - s_t[c]));
+    err_ds = std::max(err_ds, std::abs(ds[c] - ds_t[c]) / std::abs(ds[c]));
+    err_kr = std::max(err_kr, std::abs(vG.k_relative(s_t[c]) - kr_t[c]));
+    err_dkr = std::max(err_dkr, std::abs(vG.d_k_relative(s_t[c]) - dkr_t[c]));
+  }
+
+  std::cout << std::setw(24) << "" << std::setw(14) << "pointwise" << std::setw(14) << "batched"
+            << "   [ns per cell]" << std::endl
+            << std::setw(24) << "van Genuchten" << std::setw(14) << t_vg << std::setw(14) << t_vg_b << std::endl
+            << std::setw(24) << "tabulated" << std::setw(14) << t_tab << std::setw(14) << t_tab_b << std::endl
+            << "  max error: saturation " << err_s << ", relative permeability " << err_kr << std::endl
+            << "  max relative error: d saturation " << err_ds << std::endl
+            << "  max error: d relative permeability " << err_dkr << std::endl;
+  return 0;
+}
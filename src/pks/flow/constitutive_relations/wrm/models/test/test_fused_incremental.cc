@@ -0,0 +1,167 @@
+/*
+  Incremental evaluation of the fused chain of the WRM saturation and
+  relative permeability kernels, against full evaluation, after capillary
+  pressure is changed on a few cells, on most cells, twice between
+  evaluations, and after the state is copied.
+*/
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include "UnitTest++.h"
+
+#include "ats_relations_registration.hh"
+#include "ats_flow_relations_registration.hh"
+
+#include "fused_wrm_test_fixture.hh"
+
+namespace {
+
+using namespace Amanzi;
+using namespace FusedWRMTest;
+
+// Change capillary pressure on the given cells, marking them.
+void
+ChangeCapillaryPressure(const Teuchos::RCP<State>& S, const std::vector<int>& cells, double dpc)
+{
+  Epetra_MultiVector& pc = *S->GetFieldData(pc_key, pc_key)->ViewComponent("cell", false);
+  for (int c : cells) pc[0][c] += dpc;
+
+  auto pv = Teuchos::rcp_dynamic_cast<Relations::PrimaryVariableChangeSetEvaluator>(
+      S->GetFieldEvaluator(pc_key));
+  pv->MarkChanged("cell", cells);
+  pv->SetFieldAsChanged(S.ptr());
+}
+
+
+// Evaluate S, then S_full from the same primary variables, and compare.
+void
+CheckAgainstFull(const Teuchos::RCP<State>& S, const Teuchos::RCP<State>& S_full)
+{
+  std::vector<Key> keys = { "saturation_liquid", "relative_permeability" };
+  for (const auto& key : keys) S->GetFieldEvaluator(key)->HasFieldChanged(S.ptr(), "test");
+
+  std::vector<Key> deps = { pc_key, "molar_density_liquid", "viscosity_liquid" };
+  for (const auto& key : deps) {
+    *S_full->GetFieldData(key, key) = *S->GetFieldData(key);
+    Teuchos::rcp_dynamic_cast<Relations::PrimaryVariableChangeSetEvaluator>(
+        S_full->GetFieldEvaluator(key))->SetFieldAsChanged(S_full.ptr());
+  }
+
+  std::vector<std::string> names = { "cell", "boundary_face" };
+  for (const auto& key : keys) {
+    S_full->GetFieldEvaluator(key)->HasFieldChanged(S_full.ptr(), "test");
+    for (const auto& comp : names) {
+      const Epetra_MultiVector& inc_v = *S->GetFieldData(key)->ViewComponent(comp, false);
+      const Epetra_MultiVector& full_v = *S_full->GetFieldData(key)->ViewComponent(comp, false);
+      for (int i=0; i!=inc_v.MyLength(); ++i) {
+        CHECK_CLOSE(full_v[0][i], inc_v[0][i], 1.e-14 * std::abs(full_v[0][i]) + 1.e-20);
+      }
+    }
+  }
+}
+
+
+const Relations::EntityChangeSet&
+FusedChanges(const Teuchos::RCP<State>& S)
+{
+  return Teuchos::rcp_dynamic_cast<Relations::FusedPointwiseEvaluator>(
+      S->GetFieldEvaluator("saturation_liquid"))->get_change_set();
+}
+
+} // namespace
+
+
+TEST(FUSED_INCREMENTAL_FEW_CELLS) {
+  auto mesh = CreateMesh();
+  auto S = CreateState(mesh, true, true);
+  auto S_full = CreateState(mesh, true, false);
+
+  // the first evaluation is full
+  CheckAgainstFull(S, S_full);
+  CHECK(FusedChanges(S).all);
+
+  std::vector<int> cells = { 3, 4, 17 };
+  ChangeCapillaryPressure(S, cells, 2.e4);
+  CheckAgainstFull(S, S_full);
+  CHECK(!FusedChanges(S).all);
+  CHECK(FusedChanges(S).entities.at("cell") == cells);
+
+  // and again, on other cells
+  std::vector<int> cells2 = { 0, 39 };
+  ChangeCapillaryPressure(S, cells2, -1.e4);
+  CheckAgainstFull(S, S_full);
+  CHECK(!FusedChanges(S).all);
+  CHECK(FusedChanges(S).entities.at("cell") == cells2);
+}
+
+
+TEST(FUSED_INCREMENTAL_MOST_CELLS) {
+  auto mesh = CreateMesh();
+  auto S = CreateState(mesh, true, true);
+  auto S_full = CreateState(mesh, true, false);
+  CheckAgainstFull(S, S_full);
+
+  // more than half of the 40 cells
+  std::vector<int> cells;
+  for (int c=0; c!=25; ++c) cells.push_back(c);
+  ChangeCapillaryPressure(S, cells, 2.e4);
+  CheckAgainstFull(S, S_full);
+  CHECK(FusedChanges(S).all);
+}
+
+
+TEST(FUSED_INCREMENTAL_ID_SKIPPED) {
+  auto mesh = CreateMesh();
+  auto S = CreateState(mesh, true, true);
+  auto S_full = CreateState(mesh, true, false);
+  CheckAgainstFull(S, S_full);
+
+  // Two changes between evaluations: the change set holds only the second,
+  // so recomputing it only would leave the first cells stale.
+  std::vector<int> cells = { 3, 4 };
+  ChangeCapillaryPressure(S, cells, 2.e4);
+  std::vector<int> cells2 = { 20, 21 };
+  ChangeCapillaryPressure(S, cells2, 2.e4);
+  CheckAgainstFull(S, S_full);
+  CHECK(FusedChanges(S).all);
+
+  // incremental again from there
+  ChangeCapillaryPressure(S, cells, -1.e4);
+  CheckAgainstFull(S, S_full);
+  CHECK(!FusedChanges(S).all);
+}
+
+
+TEST(FUSED_INCREMENTAL_AFTER_COPY) {
+  auto mesh = CreateMesh();
+  auto S = CreateState(mesh, true, true);
+  auto S_full = CreateState(mesh, true, false);
+  CheckAgainstFull(S, S_full);
+
+  auto S_next = Teuchos::rcp(new State(*S));
+  *S_next = *S;
+  CheckAgainstFull(S_next, S_full);
+
+  std::vector<int> cells = { 5, 6 };
+  ChangeCapillaryPressure(S_next, cells, 2.e4);
+  CheckAgainstFull(S_next, S_full);
+  CHECK(!FusedChanges(S_next).all);
+
+  // Capillary pressure changes in S without evaluating, so its saturation
+  // is stale on these cells, and S_next is copied from S.
+  std::vector<int> cells2 = { 12, 13 };
+  ChangeCapillaryPressure(S, cells2, 2.e4);
+  *S_next = *S;
+
+  // Recomputing only the cells changed next would leave those stale.
+  std::vector<int> cells3 = { 30 };
+  ChangeCapillaryPressure(S_next, cells3, 2.e4);
+  CheckAgainstFull(S_next, S_full);
+  CHECK(FusedChanges(S_next).all);
+
+  // incremental again from there
+  ChangeCapillaryPressure(S_next, cells3, -1.e4);
+  CheckAgainstFull(S_next, S_full);
+  CHECK(!FusedChanges(S_next).all);
+}
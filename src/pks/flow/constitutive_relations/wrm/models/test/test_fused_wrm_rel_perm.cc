@@ -0,0 +1,72 @@
+/*
+  The fused chain of the WRM saturation and relative permeability kernels,
+  against WRMEvaluator and RelPermEvaluator, on cells and boundary faces.
+*/
+
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+#include "UnitTest++.h"
+
+#include "ats_relations_registration.hh"
+#include "ats_flow_relations_registration.hh"
+
+#include "fused_wrm_test_fixture.hh"
+
+namespace {
+
+using namespace Amanzi;
+using namespace FusedWRMTest;
+
+void
+CheckClose(const CompositeVector& fused, const CompositeVector& unfused)
+{
+  std::vector<std::string> names = { "cell", "boundary_face" };
+  for (const auto& comp : names) {
+    const Epetra_MultiVector& fused_v = *fused.ViewComponent(comp, false);
+    const Epetra_MultiVector& unfused_v = *unfused.ViewComponent(comp, false);
+    CHECK_EQUAL(unfused_v.MyLength(), fused_v.MyLength());
+    for (int i=0; i!=fused_v.MyLength(); ++i) {
+      CHECK_CLOSE(unfused_v[0][i], fused_v[0][i], 1.e-12 * std::abs(unfused_v[0][i]) + 1.e-20);
+    }
+  }
+}
+
+} // namespace
+
+
+TEST(FUSED_WRM_REL_PERM) {
+  using namespace Amanzi;
+  using namespace FusedWRMTest;
+
+  auto mesh = CreateMesh();
+  Teuchos::RCP<State> S_fused = CreateState(mesh, true);
+  Teuchos::RCP<State> S = CreateState(mesh, false);
+
+  // values
+  std::vector<Key> keys = { "saturation_liquid", "relative_permeability" };
+  for (const auto& key : keys) {
+    S_fused->GetFieldEvaluator(key)->HasFieldChanged(S_fused.ptr(), "test");
+    S->GetFieldEvaluator(key)->HasFieldChanged(S.ptr(), "test");
+    CheckClose(*S_fused->GetFieldData(key), *S->GetFieldData(key));
+  }
+
+  // only the output keys are written
+  CHECK(!S_fused->HasField("saturation_gas"));
+
+  // partial derivatives, including through saturation by the chain rule
+  std::vector<std::pair<Key,Key> > derivs = {
+    { "saturation_liquid", "capillary_pressure_gas_liq" },
+    { "relative_permeability", "capillary_pressure_gas_liq" },
+    { "relative_permeability", "molar_density_liquid" },
+    { "relative_permeability", "viscosity_liquid" } };
+  for (const auto& deriv : derivs) {
+    S_fused->GetFieldEvaluator(deriv.first)
+        ->HasFieldDerivativeChanged(S_fused.ptr(), "test", deriv.second);
+    S->GetFieldEvaluator(deriv.first)
+        ->HasFieldDerivativeChanged(S.ptr(), "test", deriv.second);
+    Key dkey = Keys::getDerivKey(deriv.first, deriv.second);
+    CheckClose(*S_fused->GetFieldData(dkey), *S->GetFieldData(dkey));
+  }
+}
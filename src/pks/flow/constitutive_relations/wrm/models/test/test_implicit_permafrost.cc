@@ -1,4 +1,6 @@
+#include <cmath>
 #include <iostream>
+#include <vector>
 #include "UnitTest++.h"
 
 #include "wrm_van_genuchten.hh"
@@ -164,3 +166,176 @@ TEST(implicitPermafrost) {
   // CHECK_CLOSE(sats[2], sats2[2], std::abs(sats[2])/1.e3 + 1.e-10);
 
 }
+
+
+TEST(implicitPermafrost_lookup_table) {
+  using namespace Amanzi::Flow;
+
+  Teuchos::ParameterList plist;
+  plist.set("van Genuchten m", 0.8);
+  plist.set("van Genuchten alpha", 1.5e-4);
+  plist.set("residual saturation", 0.);
+  plist.set("smoothing interval width [saturation]", 0.0);
+  Teuchos::RCP<WRMVanGenuchten> wrm = Teuchos::rcp(new WRMVanGenuchten(plist));
+
+  Teuchos::ParameterList plist_implicit;
+  WRMImplicitPermafrostModel implicit(plist_implicit);
+  implicit.set_WRM(wrm);
+
+  Teuchos::ParameterList plist_table;
+  plist_table.set("use lookup table", true);
+  plist_table.set("lookup table min capillary pressure [Pa]", 10.);
+  plist_table.set("lookup table max capillary pressure [Pa]", 1.e7);
+  WRMImplicitPermafrostModel table(plist_table);
+  table.set_WRM(wrm);
+  CHECK(table.lookup_table_error() <= 1.e-6);
+  CHECK(table.lookup_table_derivative_error() <= 1.e-2);
+
+  // partially frozen, unsaturated points off the nodes, plus the unfrozen
+  // and saturated cases, which are not tabulated
+  std::vector<double> pcs = { -1.e3, 0., 13., 170., 2.345e3, 4.1e4, 6.7e5, 8.9e6 };
+  for (double pc_liq : pcs) {
+    for (double pc_ice : pcs) {
+      double sats[3], dsats_liq[3], dsats_ice[3];
+      double sats_t[3], dsats_liq_t[3], dsats_ice_t[3];
+      implicit.saturations(pc_liq, pc_ice, sats);
+      implicit.dsaturations_dpc_liq(pc_liq, pc_ice, dsats_liq);
+      implicit.dsaturations_dpc_ice(pc_liq, pc_ice, dsats_ice);
+      table.saturations_and_derivatives(pc_liq, pc_ice, sats_t, dsats_liq_t, dsats_ice_t);
+
+      // derivatives are those of the interpolant, less accurate than values
+      for (int k=0; k!=3; ++k) {
+        CHECK_CLOSE(sats[k], sats_t[k], 1.e-6);
+        CHECK_CLOSE(dsats_liq[k], dsats_liq_t[k], 1.e-2 * std::abs(dsats_liq[k]) + 1.e-7);
+        CHECK_CLOSE(dsats_ice[k], dsats_ice_t[k], 1.e-2 * std::abs(dsats_ice[k]) + 1.e-7);
+      }
+
+      // the one-call interface matches the separate calls
+      double sats2[3], dsats_liq2[3], dsats_ice2[3];
+      table.saturations(pc_liq, pc_ice, sats2);
+      table.dsaturations_dpc_liq(pc_liq, pc_ice, dsats_liq2);
+      table.dsaturations_dpc_ice(pc_liq, pc_ice, dsats_ice2);
+      for (int k=0; k!=3; ++k) {
+        CHECK_CLOSE(sats2[k], sats_t[k], 1.e-14);
+        CHECK_CLOSE(dsats_liq2[k], dsats_liq_t[k], 1.e-14 * std::abs(dsats_liq2[k]));
+        CHECK_CLOSE(dsats_ice2[k], dsats_ice_t[k], 1.e-14 * std::abs(dsats_ice2[k]));
+      }
+    }
+  }
+}
+
+
+TEST(implicitPermafrost_warm_newton) {
+  using namespace Amanzi::Flow;
+
+  Teuchos::ParameterList plist;
+  plist.set("van Genuchten m", 0.8);
+  plist.set("van Genuchten alpha", 1.5e-4);
+  plist.set("residual saturation", 0.);
+  plist.set("smoothing interval width [saturation]", 0.0);
+  Teuchos::RCP<WRMVanGenuchten> wrm = Teuchos::rcp(new WRMVanGenuchten(plist));
+
+  Teuchos::ParameterList plist_bisection;
+  WRMImplicitPermafrostModel bisection(plist_bisection);
+  bisection.set_WRM(wrm);
+
+  Teuchos::ParameterList plist_newton;
+  plist_newton.set("solver algorithm [bisection/toms]", std::string("newton"));
+  WRMImplicitPermafrostModel newton(plist_newton);
+  newton.set_WRM(wrm);
+
+  // cells freezing and drying slowly over a number of evaluations, warm
+  // started from the previous evaluation as in WRMPermafrostEvaluator
+  int ncells = 20;
+  std::vector<double> si(ncells, -1.);
+  for (int step=0; step!=50; ++step) {
+    if (step == 1) {
+      bisection.reset_solver_statistics();
+      newton.reset_solver_statistics();
+    }
+
+    for (int c=0; c!=ncells; ++c) {
+      double pc_liq = 1.e3 * (1 + c) * (1. + 0.01 * step);
+      double pc_ice = 2.e3 * (1 + 0.5 * c) * (1. + 0.02 * step);
+
+      double sats[3], sats_n[3];
+      bisection.saturations(pc_liq, pc_ice, sats);
+      newton.saturations_warm(pc_liq, pc_ice, sats_n, si[c]);
+      CHECK_CLOSE(sats[0], sats_n[0], 1.e-10);
+      CHECK_CLOSE(sats[1], sats_n[1], 1.e-10);
+      CHECK_CLOSE(sats[2], sats_n[2], 1.e-10);
+      CHECK_EQUAL(sats_n[2], si[c]);
+
+      double dsats[3], dsats_n[3];
+      bisection.dsaturations_dpc_liq(pc_liq, pc_ice, dsats);
+      newton.dsaturations_dpc_liq_warm(pc_liq, pc_ice, dsats_n, si[c]);
+      for (int k=0; k!=3; ++k) {
+        CHECK_CLOSE(dsats[k], dsats_n[k], 1.e-8 * std::abs(dsats[k]) + 1.e-14);
+      }
+    }
+  }
+
+  int solves, iterations, fallbacks;
+  bisection.solver_statistics(solves, iterations, fallbacks);
+  double mean_bisection = (double) iterations / solves;
+  newton.solver_statistics(solves, iterations, fallbacks);
+  double mean_newton = (double) iterations / solves;
+  std::cout << "mean iterations per ice saturation solve: bisection " << mean_bisection
+            << ", warm started newton " << mean_newton << " (" << fallbacks
+            << " fallbacks)" << std::endl;
+  CHECK(mean_bisection > 10.);
+  CHECK(mean_newton <= 4.);
+  CHECK_EQUAL(0, fallbacks);
+}
+
+
+TEST(implicitPermafrost_warm_shared_derivatives) {
+  using namespace Amanzi::Flow;
+
+  Teuchos::ParameterList plist;
+  plist.set("van Genuchten m", 0.8);
+  plist.set("van Genuchten alpha", 1.5e-4);
+  plist.set("residual saturation", 0.);
+  plist.set("smoothing interval width [saturation]", 0.0);
+  Teuchos::RCP<WRMVanGenuchten> wrm = Teuchos::rcp(new WRMVanGenuchten(plist));
+
+  Teuchos::ParameterList plist_model;
+  plist_model.set("solver algorithm [bisection/toms]", std::string("newton"));
+  WRMImplicitPermafrostModel separate(plist_model);
+  separate.set_WRM(wrm);
+  WRMImplicitPermafrostModel shared(plist_model);
+  shared.set_WRM(wrm);
+
+  // the derivatives as WRMPermafrostEvaluator computes them, in one call,
+  // against separate calls, all warm started
+  int ncells = 20;
+  std::vector<double> si(ncells, -1.), si_shared(ncells, -1.);
+  for (int step=0; step!=10; ++step) {
+    for (int c=0; c!=ncells; ++c) {
+      double pc_liq = 1.e3 * (1 + c) * (1. + 0.01 * step);
+      double pc_ice = 2.e3 * (1 + 0.5 * c) * (1. + 0.02 * step);
+
+      double sats[3], dsats_liq[3], dsats_ice[3];
+      separate.saturations_warm(pc_liq, pc_ice, sats, si[c]);
+      separate.dsaturations_dpc_liq_warm(pc_liq, pc_ice, dsats_liq, si[c]);
+      separate.dsaturations_dpc_ice_warm(pc_liq, pc_ice, dsats_ice, si[c]);
+
+      double sats_s[3], dsats_liq_s[3], dsats_ice_s[3];
+      shared.saturations_and_derivatives_warm(pc_liq, pc_ice, sats_s,
+              dsats_liq_s, dsats_ice_s, si_shared[c]);
+      CHECK_EQUAL(sats_s[2], si_shared[c]);
+      for (int k=0; k!=3; ++k) {
+        CHECK_CLOSE(sats[k], sats_s[k], 1.e-10);
+        CHECK_CLOSE(dsats_liq[k], dsats_liq_s[k], 1.e-8 * std::abs(dsats_liq[k]) + 1.e-14);
+        CHECK_CLOSE(dsats_ice[k], dsats_ice_s[k], 1.e-8 * std::abs(dsats_ice[k]) + 1.e-14);
+      }
+    }
+  }
+
+  // ice saturation is solved for once, not once per call
+  int solves, solves_shared, iterations, fallbacks;
+  separate.solver_statistics(solves, iterations, fallbacks);
+  shared.solver_statistics(solves_shared, iterations, fallbacks);
+  CHECK(solves_shared > 0);
+  CHECK(solves_shared < solves);
+}
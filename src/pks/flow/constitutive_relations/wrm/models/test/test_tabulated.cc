@@ -0,0 +1,71 @@
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "UnitTest++.h"
+
+#include "wrm_van_genuchten.hh"
+#include "wrm_tabulated.hh"
+
+TEST(tabulated_vanGenuchten) {
+  using namespace Amanzi::Flow;
+
+  Teuchos::ParameterList plist;
+  plist.set("WRM Type", std::string("tabulated"));
+  plist.set("accuracy bound", 1.e-7);
+  Teuchos::ParameterList& model_plist = plist.sublist("tabulated model");
+  model_plist.set("WRM Type", std::string("van Genuchten"));
+  model_plist.set("van Genuchten m", 0.3);
+  model_plist.set("van Genuchten alpha", 5.e-4);
+  model_plist.set("residual saturation", 0.1);
+  model_plist.set("smoothing interval width [saturation]", 0.0);
+
+  WRMTabulated tab(plist);
+  WRMVanGenuchten vG(model_plist);
+  CHECK(tab.error_saturation() <= 1.e-7);
+  CHECK(tab.error_k_relative() <= 1.e-7);
+  std::cout << "tabulated vG: " << tab.num_nodes_saturation() << " saturation nodes, "
+            << tab.num_nodes_k_relative() << " relative permeability nodes" << std::endl;
+
+  // pressures from saturated to beyond the table, log-spaced where dry
+  int n = 1000;
+  std::vector<double> pc(n), s(n), ds(n), kr(n), dkr(n);
+  for (int i=0; i!=n; ++i) pc[i] = i < 10 ? -1.e3 + 1.e2*i : std::pow(10., 10. * (i-10) / (n-10));
+
+  tab.evaluate_batch(n, &pc[0], &s[0], &ds[0], &kr[0], &dkr[0]);
+  for (int i=0; i!=n; ++i) {
+    // pointwise and batched lookups agree
+    CHECK_CLOSE(tab.saturation(pc[i]), s[i], 1.e-14);
+    CHECK_CLOSE(tab.d_saturation(pc[i]), ds[i], 1.e-14 * std::abs(ds[i]));
+    CHECK_CLOSE(tab.k_relative(s[i]), kr[i], 1.e-14);
+    CHECK_CLOSE(tab.d_k_relative(s[i]), dkr[i], 1.e-14 * std::abs(dkr[i]));
+
+    // tables are within the bound of the model
+    CHECK_CLOSE(vG.saturation(pc[i]), s[i], 1.e-7);
+    CHECK_CLOSE(vG.k_relative(s[i]), kr[i], 1.e-7);
+    CHECK_CLOSE(vG.d_saturation(pc[i]), ds[i], 1.e-3 * std::abs(vG.d_saturation(pc[i])) + 1.e-15);
+    CHECK_CLOSE(vG.d_k_relative(s[i]), dkr[i], 1.e-3 * std::abs(vG.d_k_relative(s[i])) + 1.e-6);
+  }
+
+  // monotone: saturation decreases with pc, and kr increases with s
+  for (int i=1; i!=n; ++i) {
+    CHECK(s[i] <= s[i-1]);
+    CHECK(kr[i] <= kr[i-1]);
+  }
+}
+
+
+TEST(tabulated_accuracy_bound) {
+  using namespace Amanzi::Flow;
+
+  // too few nodes for the bound throws
+  Teuchos::ParameterList plist;
+  plist.set("accuracy bound", 1.e-12);
+  plist.set("number of nodes", 16);
+  plist.set("max number of nodes", 64);
+  Teuchos::ParameterList& model_plist = plist.sublist("tabulated model");
+  model_plist.set("WRM Type", std::string("van Genuchten"));
+  model_plist.set("van Genuchten m", 0.3);
+  model_plist.set("van Genuchten alpha", 5.e-4);
+  model_plist.set("residual saturation", 0.1);
+  CHECK_THROW(WRMTabulated tab(plist), std::exception);
+}
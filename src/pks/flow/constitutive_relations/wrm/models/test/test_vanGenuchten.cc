@@ -1,4 +1,6 @@
+#include <cmath>
 #include <iostream>
+#include <vector>
 #include "UnitTest++.h"
 
 #include "wrm_van_genuchten.hh"
@@ -59,3 +61,31 @@ TEST(vanGenuchten) {
   CHECK_CLOSE(vG.d_capillaryPressure( vG.saturation(pc) ),
               1.0 / vG.d_saturation(pc), 1.);
 }
+
+
+TEST(vanGenuchten_batch) {
+  using namespace Amanzi::Flow;
+
+  for (int smooth=0; smooth!=2; ++smooth) {
+    Teuchos::ParameterList plist;
+    plist.set("van Genuchten m", 0.5);
+    plist.set("van Genuchten alpha", 1.e-4);
+    plist.set("residual saturation", 0.1);
+    plist.set("smoothing interval width [saturation]", smooth ? 0.05 : 0.0);
+    plist.set("saturation smoothing interval [Pa]", smooth ? 100. : 0.0);
+    WRMVanGenuchten vG(plist);
+
+    // pressures covering the saturated, smoothed and unsaturated ranges
+    int n = 200;
+    std::vector<double> pc(n), s(n), ds(n), kr(n), dkr(n);
+    for (int i=0; i!=n; ++i) pc[i] = -1.e3 + 2.e5 * i * i / (n*n);
+
+    vG.evaluate_batch(n, &pc[0], &s[0], &ds[0], &kr[0], &dkr[0]);
+    for (int i=0; i!=n; ++i) {
+      CHECK_CLOSE(vG.saturation(pc[i]), s[i], 1.e-12);
+      CHECK_CLOSE(vG.d_saturation(pc[i]), ds[i], 1.e-12 * std::abs(ds[i]) + 1.e-20);
+      CHECK_CLOSE(vG.k_relative(s[i]), kr[i], 1.e-12);
+      CHECK_CLOSE(vG.d_k_relative(s[i]), dkr[i], 1.e-10 * std::abs(dkr[i]) + 1.e-14);
+    }
+  }
+}
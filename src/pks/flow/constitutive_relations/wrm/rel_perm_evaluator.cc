@@ -150,10 +150,7 @@ void RelPermEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
         const Teuchos::Ptr<CompositeVector>& result) {
 
   // Initialize the MeshPartition
-  if (!wrms_->first->initialized()) {
-    wrms_->first->Initialize(result->Mesh(), -1);
-    wrms_->first->Verify();
-  }
+  wrms_->Initialize(result->Mesh());
 
   // Evaluate k_rel.
   // -- Evaluate the model to calculate krel on cells.
@@ -161,10 +158,14 @@ void RelPermEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
       ->ViewComponent("cell",false);
   Epetra_MultiVector& res_c = *result->ViewComponent("cell",false);
 
+  wrms_->ForEachRegion(sat_c[0], res_c[0], NULL,
+          [](WRM& wrm, int n, const double* s, double* kr, double*) {
+            wrm.k_relative_batch(n, s, kr, NULL);
+          });
+
   int ncells = res_c.MyLength();
   for (unsigned int c=0; c!=ncells; ++c) {
-    int index = (*wrms_->first)[c];
-    res_c[0][c] = std::max(wrms_->second[index]->k_relative(sat_c[0][c]), min_val_);
+    res_c[0][c] = std::max(res_c[0][c], min_val_);
   }
 
   // -- Potentially evaluate the model on boundary faces as well.
@@ -249,10 +250,7 @@ void RelPermEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>
         Key wrt_key, const Teuchos::Ptr<CompositeVector>& result) {
 
   // Initialize the MeshPartition
-  if (!wrms_->first->initialized()) {
-    wrms_->first->Initialize(result->Mesh(), -1);
-    wrms_->first->Verify();
-  }
+  wrms_->Initialize(result->Mesh());
 
   if (wrt_key == sat_key_) {
     // dkr / dsl = rho/mu * dkr/dpc * dpc/dsl
@@ -263,12 +261,14 @@ void RelPermEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>
         ->ViewComponent("cell",false);
     Epetra_MultiVector& res_c = *result->ViewComponent("cell",false);
 
+    wrms_->ForEachRegion(sat_c[0], res_c[0], NULL,
+            [](WRM& wrm, int n, const double* s, double* dkr, double*) {
+              wrm.k_relative_batch(n, s, NULL, dkr);
+            });
+#ifdef ENABLE_DBC
     int ncells = res_c.MyLength();
-    for (unsigned int c=0; c!=ncells; ++c) {
-      int index = (*wrms_->first)[c];
-      res_c[0][c] = wrms_->second[index]->d_k_relative(sat_c[0][c]);
-      AMANZI_ASSERT(res_c[0][c] >= 0.);
-    }
+    for (unsigned int c=0; c!=ncells; ++c) AMANZI_ASSERT(res_c[0][c] >= 0.);
+#endif
 
     // -- Potentially evaluate the model on boundary faces as well.
     if (result->HasComponent("boundary_face")) {
@@ -0,0 +1,102 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  Relative permeability, as a pointwise kernel.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include <algorithm>
+
+#include "errors.hh"
+#include "rel_perm_kernel.hh"
+
+namespace Amanzi {
+namespace Flow {
+
+RelPermKernel::RelPermKernel(Teuchos::ParameterList& plist) :
+    Relations::PointwiseKernel(plist) {
+  AMANZI_ASSERT(plist_.isSublist("WRM parameters"));
+  Teuchos::ParameterList wrm_plist = plist_.sublist("WRM parameters");
+  wrms_ = createWRMPartition(wrm_plist);
+
+  if (plist_.get<bool>("use surface rel perm", false)) {
+    Errors::Message msg("RelPermKernel: \"use surface rel perm\" is not pointwise, use RelPermEvaluator.");
+    Exceptions::amanzi_throw(msg);
+  }
+
+  results_.push_back(Keys::readKey(plist_, domain_, "rel perm", "relative_permeability"));
+  args_.push_back(Keys::readKey(plist_, domain_, "saturation", "saturation_liquid"));
+  is_dens_visc_ = plist_.get<bool>("use density on viscosity in rel perm", true);
+  if (is_dens_visc_) {
+    args_.push_back(Keys::readKey(plist_, domain_, "density", "molar_density_liquid"));
+    args_.push_back(Keys::readKey(plist_, domain_, "viscosity", "viscosity_liquid"));
+  }
+
+  min_val_ = plist_.get<double>("minimum rel perm cutoff", 0.);
+  perm_scale_ = plist_.get<double>("permeability rescaling", 1.e7);
+}
+
+
+void RelPermKernel::Setup(const Teuchos::RCP<const AmanziMesh::Mesh>& mesh,
+        const std::vector<std::string>& components) {
+  wrms_->Initialize(mesh);
+  for (const auto& comp : components) regions_[comp] = wrms_->EntityRegions(mesh, comp);
+}
+
+
+void RelPermKernel::Evaluate(const std::string& comp, int begin, int n,
+        const double* const* args, double* const* results) {
+  const double* s = args[0];
+  double* kr = results[0];
+  wrms_->ForEachRun(regions_.at(comp), begin, n,
+                    [=](WRM& wrm, int i, int m) {
+                      wrm.k_relative_batch(m, s+i, kr+i, NULL);
+                    });
+
+  double scale = 1. / perm_scale_;
+  if (is_dens_visc_) {
+    const double* dens = args[1];
+    const double* visc = args[2];
+    for (int i=0; i!=n; ++i) kr[i] = std::max(kr[i], min_val_) * dens[i] / visc[i] * scale;
+  } else {
+    for (int i=0; i!=n; ++i) kr[i] = std::max(kr[i], min_val_) * scale;
+  }
+}
+
+
+// As in RelPermEvaluator, the derivative with respect to saturation ignores
+// the cutoff.
+void RelPermKernel::EvaluateWithDerivatives(const std::string& comp, int begin, int n,
+        const double* const* args, double* const* results, double* const* jac) {
+  const double* s = args[0];
+  double* kr = results[0];
+  double* dkr_ds = jac[0];
+  wrms_->ForEachRun(regions_.at(comp), begin, n,
+                    [=](WRM& wrm, int i, int m) {
+                      wrm.k_relative_batch(m, s+i, kr+i, dkr_ds+i);
+                    });
+
+  double scale = 1. / perm_scale_;
+  if (is_dens_visc_) {
+    const double* dens = args[1];
+    const double* visc = args[2];
+    double* dkr_ddens = jac[1];
+    double* dkr_dvisc = jac[2];
+    for (int i=0; i!=n; ++i) {
+      double coef = dens[i] / visc[i] * scale;
+      kr[i] = std::max(kr[i], min_val_) * coef;
+      dkr_ds[i] *= coef;
+      dkr_ddens[i] = kr[i] / dens[i];
+      dkr_dvisc[i] = -kr[i] / visc[i];
+    }
+  } else {
+    for (int i=0; i!=n; ++i) {
+      kr[i] = std::max(kr[i], min_val_) * scale;
+      dkr_ds[i] *= scale;
+    }
+  }
+}
+
+} //namespace
+} //namespace
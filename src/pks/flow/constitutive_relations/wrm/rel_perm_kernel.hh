@@ -0,0 +1,72 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! RelPermKernel: relative permeability, as a pointwise kernel.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+/*!
+
+Computes what RelPermEvaluator does, on tiles of cells or boundary faces,
+for use in a FusedPointwiseEvaluator.  Its `"kernel type`" is `"WRM
+relative permeability`".  Surface relative permeability is not pointwise,
+and is not supported.
+
+* `"rel perm key`" ``[string]`` **DOMAIN-relative_permeability**
+* `"saturation key`" ``[string]`` **DOMAIN-saturation_liquid**
+* `"use density on viscosity in rel perm`" ``[bool]`` **true**
+* `"density key`" ``[string]`` **DOMAIN-molar_density_liquid**
+* `"viscosity key`" ``[string]`` **DOMAIN-viscosity_liquid**
+* `"minimum rel perm cutoff`" ``[double]`` **0**
+* `"permeability rescaling`" ``[double]`` **1.e7**
+* `"WRM parameters`" ``[wrm-partition-typed-spec-list]``
+
+*/
+
+#ifndef AMANZI_FLOW_RELATIONS_REL_PERM_KERNEL_
+#define AMANZI_FLOW_RELATIONS_REL_PERM_KERNEL_
+
+#include <map>
+
+#include "PointwiseKernel.hh"
+#include "wrm_partition.hh"
+
+namespace Amanzi {
+namespace Flow {
+
+class RelPermKernel : public Relations::PointwiseKernel {
+
+ public:
+  explicit
+  RelPermKernel(Teuchos::ParameterList& plist);
+
+  virtual void Setup(const Teuchos::RCP<const AmanziMesh::Mesh>& mesh,
+                     const std::vector<std::string>& components);
+
+  virtual void Evaluate(const std::string& comp, int begin, int n,
+                        const double* const* args, double* const* results);
+  virtual void EvaluateWithDerivatives(const std::string& comp, int begin, int n,
+          const double* const* args, double* const* results, double* const* jac);
+
+  Teuchos::RCP<WRMPartition> get_WRMs() { return wrms_; }
+
+ protected:
+  Teuchos::RCP<WRMPartition> wrms_;
+  std::map<std::string, std::vector<int> > regions_;
+
+  bool is_dens_visc_;
+  double perm_scale_;
+  double min_val_;
+
+ private:
+  static Utils::RegisteredFactory<Relations::PointwiseKernel,RelPermKernel> factory_;
+};
+
+} //namespace
+} //namespace
+
+#endif
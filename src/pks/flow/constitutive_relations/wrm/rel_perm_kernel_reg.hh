@@ -0,0 +1,10 @@
+#include "rel_perm_kernel.hh"
+
+namespace Amanzi {
+namespace Flow {
+
+// registry of method
+Utils::RegisteredFactory<Relations::PointwiseKernel,RelPermKernel> RelPermKernel::factory_("WRM relative permeability");
+
+} //namespace
+} //namespace
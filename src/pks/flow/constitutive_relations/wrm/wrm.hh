@@ -35,6 +35,33 @@ public:
   virtual double d_capillaryPressure(double saturation) = 0;
   virtual double residualSaturation() = 0;
 
+  // Batched methods, evaluating n values at once from contiguous arrays.
+  // These are called once per region by the evaluators, rather than calling
+  // the above once per cell.  Any output may be NULL, in which case it is
+  // not computed.  The defaults loop over the pointwise methods; models
+  // override them when values and derivatives share work.
+  virtual void saturation_batch(int n, const double* pc, double* s, double* ds_dpc) {
+    for (int i=0; i!=n; ++i) {
+      if (s) s[i] = saturation(pc[i]);
+      if (ds_dpc) ds_dpc[i] = d_saturation(pc[i]);
+    }
+  }
+
+  virtual void k_relative_batch(int n, const double* s, double* kr, double* dkr_ds) {
+    for (int i=0; i!=n; ++i) {
+      if (kr) kr[i] = k_relative(s[i]);
+      if (dkr_ds) dkr_ds[i] = d_k_relative(s[i]);
+    }
+  }
+
+  // Saturation, its derivative, and relative permeability and its
+  // derivative at that saturation.  s is required if kr or dkr_ds are.
+  void evaluate_batch(int n, const double* pc, double* s, double* ds_dpc,
+                      double* kr, double* dkr_ds) {
+    saturation_batch(n, pc, s, ds_dpc);
+    if (kr || dkr_ds) k_relative_batch(n, s, kr, dkr_ds);
+  }
+
 };
 
 typedef double(WRM::*KRelFn)(double pc);
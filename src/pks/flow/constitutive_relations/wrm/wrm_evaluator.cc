@@ -76,20 +76,17 @@ void WRMEvaluator::InitializeFromPlist_() {
 void WRMEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
         const std::vector<Teuchos::Ptr<CompositeVector> >& results) {
   // Initialize the MeshPartition
-  if (!wrms_->first->initialized()) {
-    wrms_->first->Initialize(results[0]->Mesh(), -1);
-    wrms_->first->Verify();
-  }
+  wrms_->Initialize(results[0]->Mesh());
 
   Epetra_MultiVector& sat_c = *results[0]->ViewComponent("cell",false);
   const Epetra_MultiVector& pres_c = *S->GetFieldData(cap_pres_key_)
       ->ViewComponent("cell",false);
 
-  // calculate cell values
-  AmanziMesh::Entity_ID ncells = sat_c.MyLength();
-  for (AmanziMesh::Entity_ID c=0; c!=ncells; ++c) {
-    sat_c[0][c] = wrms_->second[(*wrms_->first)[c]]->saturation(pres_c[0][c]);
-  }
+  // calculate cell values, one batch per region
+  wrms_->ForEachRegion(pres_c[0], sat_c[0], NULL,
+          [](WRM& wrm, int n, const double* pc, double* s, double*) {
+            wrm.saturation_batch(n, pc, s, NULL);
+          });
 
   // Potentially do face values as well.
   if (results[0]->HasComponent("boundary_face")) {
@@ -141,10 +138,7 @@ void WRMEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
 void WRMEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
         Key wrt_key, const std::vector<Teuchos::Ptr<CompositeVector> > & results) {
   // Initialize the MeshPartition
-  if (!wrms_->first->initialized()) {
-    wrms_->first->Initialize(results[0]->Mesh(), -1);
-    wrms_->first->Verify();
-  }
+  wrms_->Initialize(results[0]->Mesh());
 
   AMANZI_ASSERT(wrt_key == cap_pres_key_);
 
@@ -152,11 +146,11 @@ void WRMEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
   const Epetra_MultiVector& pres_c = *S->GetFieldData(cap_pres_key_)
       ->ViewComponent("cell",false);
 
-  // calculate cell values
-  AmanziMesh::Entity_ID ncells = sat_c.MyLength();
-  for (AmanziMesh::Entity_ID c=0; c!=ncells; ++c) {
-    sat_c[0][c] = wrms_->second[(*wrms_->first)[c]]->d_saturation(pres_c[0][c]);
-  }
+  // calculate cell values, one batch per region
+  wrms_->ForEachRegion(pres_c[0], sat_c[0], NULL,
+          [](WRM& wrm, int n, const double* pc, double* ds, double*) {
+            wrm.saturation_batch(n, pc, NULL, ds);
+          });
 
   // Potentially do face values as well.
   if (results[0]->HasComponent("boundary_face")) {
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "Epetra_SerialDenseMatrix.h"
 
@@ -21,6 +23,41 @@ WRMImplicitPermafrostModel::WRMImplicitPermafrostModel(Teuchos::ParameterList& p
   max_it_ = plist_.get<int>("max iterations", 100);
   deriv_regularization_ = plist_.get<double>("minimum dsi_dpressure magnitude", 1.e-10);
   solver_ = plist_.get<std::string>("solver algorithm [bisection/toms]", "bisection");
+  n_solves_ = 0;
+  n_iterations_ = 0;
+  n_fallbacks_ = 0;
+
+  use_table_ = plist_.get<bool>("use lookup table", false);
+  table_error_ = 0.;
+  table_deriv_error_ = 0.;
+  table_fraction_ = 0.;
+  if (use_table_) {
+    double pc_min = plist_.get<double>("lookup table min capillary pressure [Pa]", 1.0);
+    double pc_max = plist_.get<double>("lookup table max capillary pressure [Pa]", 1.e8);
+    double ratio = plist_.get<double>("lookup table max capillary pressure ratio [-]", 1.e3);
+    int per_decade = plist_.get<int>("lookup table nodes per decade", 16);
+    table_tol_ = plist_.get<double>("lookup table accuracy bound", 1.e-6);
+    table_deriv_tol_ = plist_.get<double>("lookup table derivative accuracy bound", 1.e-2);
+    if (pc_min <= 0. || pc_max <= pc_min || ratio <= 1. || per_decade < 1
+        || table_tol_ <= 0. || table_deriv_tol_ <= 0.) {
+      Errors::Message msg("WRMImplicitPermafrostModel: invalid lookup table range, nodes per decade or accuracy bounds.");
+      Exceptions::amanzi_throw(msg);
+    }
+    table_h_ = std::log(10.) / per_decade;
+    table_x0_ = std::log(pc_min);
+    table_nx_ = std::max(1, (int) std::ceil(std::log(pc_max / pc_min) / table_h_));
+
+    // the ratio pc_ice / pc_liq = 1 is a node
+    int ny_half = std::max(1, (int) std::ceil(std::log(ratio) / table_h_));
+    table_y0_ = -ny_half * table_h_;
+    table_ny_ = 2 * ny_half;
+  }
+}
+
+
+void WRMImplicitPermafrostModel::set_WRM(const Teuchos::RCP<WRM>& wrm) {
+  WRMPermafrostModel::set_WRM(wrm);
+  if (use_table_) BuildTable_();
 }
 
 // Above freezing calculation methods:
@@ -108,8 +145,11 @@ bool WRMImplicitPermafrostModel::dsats_dpc_ice_saturated_(double pc_liq,
 // partially frozen, unsaturated calculations
 // -- saturation calculation, partially frozen, unsaturated
 bool WRMImplicitPermafrostModel::sats_frozen_unsaturated_(double pc_liq,
-        double pc_ice, double (&sats)[3]) {
-  double si = si_frozen_unsaturated_(pc_liq, pc_ice);
+        double pc_ice, double (&sats)[3], double si_guess) {
+  double si, dsi_dpcliq, dsi_dpcice;
+  if (!LookupSi_(pc_liq, pc_ice, si, dsi_dpcliq, dsi_dpcice)) {
+    si = si_frozen_unsaturated_(pc_liq, pc_ice, si_guess);
+  }
   sats[2] = si;
   sats[1] = (1. - si) * wrm_->saturation(pc_liq);
   sats[0] = 1. - si - sats[1];
@@ -124,9 +164,12 @@ bool WRMImplicitPermafrostModel::sats_frozen_unsaturated_(double pc_liq,
 
 // -- ds_dpcliq calculation, partially frozen, unsaturated
 bool WRMImplicitPermafrostModel::dsats_dpc_liq_frozen_unsaturated_(double pc_liq,
-        double pc_ice, double (&dsats)[3]) {
-  double si = si_frozen_unsaturated_(pc_liq, pc_ice);
-  double dsi_dpcliq = dsi_dpc_liq_frozen_unsaturated_(pc_liq, pc_ice, si);
+        double pc_ice, double (&dsats)[3], double si_guess) {
+  double si, dsi_dpcliq, dsi_dpcice;
+  if (!LookupSi_(pc_liq, pc_ice, si, dsi_dpcliq, dsi_dpcice)) {
+    si = si_frozen_unsaturated_(pc_liq, pc_ice, si_guess);
+    dsi_dpcliq = dsi_dpc_liq_frozen_unsaturated_(pc_liq, pc_ice, si);
+  }
   dsats[2] = dsi_dpcliq;
   dsats[1] = (1. - si) * wrm_->d_saturation(pc_liq) - dsi_dpcliq * wrm_->saturation(pc_liq);
   dsats[0] = - dsats[1] - dsats[2];
@@ -135,9 +178,12 @@ bool WRMImplicitPermafrostModel::dsats_dpc_liq_frozen_unsaturated_(double pc_liq
 
 // -- ds_dpcice calculation, partially frozen, unsaturated
 bool WRMImplicitPermafrostModel::dsats_dpc_ice_frozen_unsaturated_(double pc_liq,
-        double pc_ice, double (&dsats)[3]) {
-  double si = si_frozen_unsaturated_(pc_liq, pc_ice);
-  double dsi_dpcice = dsi_dpc_ice_frozen_unsaturated_(pc_liq, pc_ice, si);
+        double pc_ice, double (&dsats)[3], double si_guess) {
+  double si, dsi_dpcliq, dsi_dpcice;
+  if (!LookupSi_(pc_liq, pc_ice, si, dsi_dpcliq, dsi_dpcice)) {
+    si = si_frozen_unsaturated_(pc_liq, pc_ice, si_guess);
+    dsi_dpcice = dsi_dpc_ice_frozen_unsaturated_(pc_liq, pc_ice, si);
+  }
   dsats[2] = dsi_dpcice;
   dsats[1] = - dsi_dpcice * wrm_->saturation(pc_liq);
   dsats[0] = - dsats[1] - dsats[2];
@@ -146,15 +192,16 @@ bool WRMImplicitPermafrostModel::dsats_dpc_ice_frozen_unsaturated_(double pc_liq
 
 
 // -- si calculation, partially frozen, unsaturated
-double WRMImplicitPermafrostModel::si_frozen_unsaturated_(double pc_liq, double pc_ice) {
+double WRMImplicitPermafrostModel::si_frozen_unsaturated_(double pc_liq, double pc_ice,
+        double si_guess) {
   double si(0.);
 
   // check if we are in the splined region
   double cutoff(0.), si_cutoff(0.);
-  DetermineSplineCutoff_(pc_liq, pc_ice, cutoff, si_cutoff);
+  DetermineSplineCutoff_(pc_liq, pc_ice, cutoff, si_cutoff, si_guess);
   if (pc_liq > cutoff) {
     // outside of the spline
-    si = si_frozen_unsaturated_nospline_(pc_liq, pc_ice);
+    si = si_frozen_unsaturated_nospline_(pc_liq, pc_ice, false, si_guess);
   } else {
     // fit spline, evaluate
     double spline[4];
@@ -175,7 +222,7 @@ double WRMImplicitPermafrostModel::dsi_dpc_liq_frozen_unsaturated_(double pc_liq
   double cutoff(0.), si_cutoff(0.);
   double dsi(0.);
 
-  DetermineSplineCutoff_(pc_liq, pc_ice, cutoff, si_cutoff);
+  DetermineSplineCutoff_(pc_liq, pc_ice, cutoff, si_cutoff, si);
   if (pc_liq > cutoff) {
     // outside of the spline
     dsi = dsi_dpc_liq_frozen_unsaturated_nospline_(pc_liq, pc_ice, si);
@@ -199,7 +246,7 @@ double WRMImplicitPermafrostModel::dsi_dpc_ice_frozen_unsaturated_(double pc_liq
         double pc_ice, double si) {
   // check if we are in the splined region
   double cutoff(0.), si_cutoff(0.);
-  DetermineSplineCutoff_(pc_liq, pc_ice, cutoff, si_cutoff);
+  DetermineSplineCutoff_(pc_liq, pc_ice, cutoff, si_cutoff, si);
   if (pc_liq > cutoff) {
     // outside of the spline
     return dsi_dpc_ice_frozen_unsaturated_nospline_(pc_liq, pc_ice, si);
@@ -211,7 +258,7 @@ double WRMImplicitPermafrostModel::dsi_dpc_ice_frozen_unsaturated_(double pc_liq
     double delta_pc_ice = std::max(.1, pc_ice / 100.);
 
     double pc_ice2 = pc_ice + delta_pc_ice;
-    double si_cutoff2 = si_frozen_unsaturated_nospline_(cutoff, pc_ice2);
+    double si_cutoff2 = si_frozen_unsaturated_nospline_(cutoff, pc_ice2, false, si_cutoff);
     FitSpline_(pc_ice2, cutoff, si_cutoff2, spline2);
 
     double dspline[4];
@@ -228,12 +275,12 @@ double WRMImplicitPermafrostModel::dsi_dpc_ice_frozen_unsaturated_(double pc_liq
 // Helper methods for spline
 // -- Determine the point beyond which the spline is not needed
 bool WRMImplicitPermafrostModel::DetermineSplineCutoff_(double pc_liq, double pc_ice,
-        double& cutoff, double& si) {
+        double& cutoff, double& si, double si_guess) {
   cutoff = std::exp(std::floor(std::log(pc_liq)));
   bool done(false);
   while (!done) {
     try {
-      si = si_frozen_unsaturated_nospline_(cutoff, pc_ice, true); // use the version that throws on error
+      si = si_frozen_unsaturated_nospline_(cutoff, pc_ice, true, si_guess); // use the version that throws on error
     } catch (const Errors::CutTimeStep& e) {
       cutoff = std::exp(std::log(cutoff) + 1.);
       continue;
@@ -298,7 +345,15 @@ bool WRMImplicitPermafrostModel::FitSpline_(double pc_ice, double cutoff,
 
 // -- si calculation, outside of the splined region
 double WRMImplicitPermafrostModel::si_frozen_unsaturated_nospline_(double pc_liq,
-        double pc_ice, bool throw_ok) {
+        double pc_ice, bool throw_ok, double si_guess) {
+  if (solver_ == "newton") {
+    bool converged(false);
+    double si = si_frozen_unsaturated_newton_(pc_liq, pc_ice, si_guess, converged);
+    if (converged) return si;
+    // the safeguard tripped, bracket from scratch
+    n_fallbacks_++;
+  }
+
   // solve implicit equation for s_i
   SatIceFunctor_ func(pc_liq, pc_ice, wrm_);
   Tol_ tol(eps_);
@@ -308,7 +363,7 @@ double WRMImplicitPermafrostModel::si_frozen_unsaturated_nospline_(double pc_liq
 
   std::pair<double,double> result;
   try {
-    if (solver_ == "bisection") {
+    if (solver_ == "bisection" || solver_ == "newton") {
       result = boost::math::tools::bisect(func, left, right, tol, max_it);
     } else if (solver_ == "toms") {
       result =
@@ -327,6 +382,8 @@ double WRMImplicitPermafrostModel::si_frozen_unsaturated_nospline_(double pc_liq
 
   double si = (result.first + result.second) / 2.;
   AMANZI_ASSERT(0. <= si && si <= 1.);
+  n_solves_++;
+  n_iterations_ += max_it;
 
   if (max_it >= max_it_) {
     // did not converge?  May be ABS converged but not REL converged!
@@ -343,6 +400,52 @@ double WRMImplicitPermafrostModel::si_frozen_unsaturated_nospline_(double pc_liq
 }
 
 
+// -- si calculation by Newton's method, safeguarded by bisection
+//    The residual decreases from F(0) > 0 to F(1) < 0, so each iterate
+//    shrinks a bracket of the root.  Steps leaving the bracket, or with a
+//    non-negative or non-finite derivative, are replaced by bisection.
+double WRMImplicitPermafrostModel::si_frozen_unsaturated_newton_(double pc_liq,
+        double pc_ice, double si_guess, bool& converged) {
+  double sstar = wrm_->saturation(pc_liq);
+  double left = 0.;
+  double right = 1.;
+  double si = (0. <= si_guess && si_guess <= 1.) ? si_guess : 0.5;
+
+  converged = false;
+  boost::uintmax_t it = 0;
+  while (!converged && it < max_it_) {
+    ++it;
+    double tmp = (1. - si) * sstar;
+    double pc = pc_ice + wrm_->capillaryPressure(tmp + si);
+    double res = tmp - wrm_->saturation(pc);
+    double dres = - sstar - wrm_->d_saturation(pc)
+        * wrm_->d_capillaryPressure(tmp + si) * (1. - sstar);
+
+    if (res == 0.) {
+      converged = true;
+      break;
+    } else if (res > 0.) {
+      left = si;
+    } else {
+      right = si;
+    }
+
+    double si_new = si - res / dres;
+    if (std::isfinite(si_new) && dres < 0. && left <= si_new && si_new <= right) {
+      converged = std::abs(si_new - si) <= eps_;
+    } else {
+      si_new = (left + right) / 2.;
+      converged = right - left <= eps_;
+    }
+    si = si_new;
+  }
+
+  n_solves_++;
+  n_iterations_ += it;
+  return si;
+}
+
+
 // -- dsi_dpcliq calculation, outside of the splined region
 double WRMImplicitPermafrostModel::dsi_dpc_liq_frozen_unsaturated_nospline_(double pc_liq,
         double pc_ice, double si) {
@@ -374,6 +477,163 @@ double WRMImplicitPermafrostModel::dsi_dpc_ice_frozen_unsaturated_nospline_(doub
 }
 
 
+// Lookup table methods
+// -- Tabulate si and its derivatives at the nodes, in x = log pc_liq and
+//    y = log (pc_ice / pc_liq).  Ice saturation changes sharply where the
+//    capillary pressures are equal, which is then a line of nodes.
+void WRMImplicitPermafrostModel::BuildTable_() {
+  int nx = table_nx_ + 1;
+  int ny = table_ny_ + 1;
+  table_.assign(4 * nx * ny, 0.);
+  for (int i=0; i!=nx; ++i) {
+    double pc_liq = std::exp(table_x0_ + i * table_h_);
+    for (int j=0; j!=ny; ++j) {
+      double pc_ice = pc_liq * std::exp(table_y0_ + j * table_h_);
+      double* node = &table_[4 * (i*ny + j)];
+      double si = si_frozen_unsaturated_(pc_liq, pc_ice);
+      double dsi_dpcliq = dsi_dpc_liq_frozen_unsaturated_(pc_liq, pc_ice, si);
+      double dsi_dpcice = dsi_dpc_ice_frozen_unsaturated_(pc_liq, pc_ice, si);
+      node[0] = si;
+      node[1] = dsi_dpcliq * pc_liq + dsi_dpcice * pc_ice;
+      node[2] = dsi_dpcice * pc_ice;
+    }
+  }
+
+  // cross derivatives, averaging differences of both first derivatives
+  for (int i=0; i!=nx; ++i) {
+    int il = std::max(i-1, 0), ir = std::min(i+1, nx-1);
+    for (int j=0; j!=ny; ++j) {
+      int jl = std::max(j-1, 0), jr = std::min(j+1, ny-1);
+      double d2_y = (table_[4*(i*ny + jr) + 1] - table_[4*(i*ny + jl) + 1])
+          / ((jr - jl) * table_h_);
+      double d2_x = (table_[4*(ir*ny + j) + 2] - table_[4*(il*ny + j) + 2])
+          / ((ir - il) * table_h_);
+      table_[4*(i*ny + j) + 3] = 0.5 * (d2_x + d2_y);
+    }
+  }
+
+  // Check against the implicit solve at the center and four interior points
+  // of each cell, in si and in the relative error of its derivatives.  Where
+  // the capillary pressures are large and nearly equal, or ice saturation
+  // nears 1, it varies too sharply to tabulate.  Cells failing the check, and
+  // their neighbors, fall back to the implicit solve.
+  const double check_pts[5][2] = { {0.5, 0.5}, {0.25, 0.25}, {0.25, 0.75},
+                                   {0.75, 0.25}, {0.75, 0.75} };
+  std::vector<double> errors(table_nx_ * table_ny_, 0.);
+  std::vector<double> deriv_errors(table_nx_ * table_ny_, 0.);
+  for (int i=0; i!=table_nx_; ++i) {
+    for (int j=0; j!=table_ny_; ++j) {
+      int n = i*table_ny_ + j;
+      for (int k=0; k!=5; ++k) {
+        double pc_liq = std::exp(table_x0_ + (i + check_pts[k][0]) * table_h_);
+        double pc_ice = pc_liq * std::exp(table_y0_ + (j + check_pts[k][1]) * table_h_);
+        double si, dsi_dpcliq, dsi_dpcice;
+        if (!LookupSi_(pc_liq, pc_ice, si, dsi_dpcliq, dsi_dpcice)) {
+          errors[n] = std::numeric_limits<double>::max();
+          deriv_errors[n] = std::numeric_limits<double>::max();
+          break;
+        }
+
+        double si_ex = si_frozen_unsaturated_(pc_liq, pc_ice);
+        double dsi_dpcliq_ex = dsi_dpc_liq_frozen_unsaturated_(pc_liq, pc_ice, si_ex);
+        double dsi_dpcice_ex = dsi_dpc_ice_frozen_unsaturated_(pc_liq, pc_ice, si_ex);
+        errors[n] = std::max(errors[n], std::abs(si - si_ex));
+        deriv_errors[n] = std::max(deriv_errors[n],
+                std::abs(dsi_dpcliq - dsi_dpcliq_ex)
+                / (std::abs(dsi_dpcliq_ex) + deriv_regularization_));
+        deriv_errors[n] = std::max(deriv_errors[n],
+                std::abs(dsi_dpcice - dsi_dpcice_ex)
+                / (std::abs(dsi_dpcice_ex) + deriv_regularization_));
+      }
+    }
+  }
+
+  table_cell_ok_.assign(table_nx_ * table_ny_, 1);
+  for (int i=0; i!=table_nx_; ++i) {
+    for (int j=0; j!=table_ny_; ++j) {
+      if (errors[i*table_ny_ + j] > table_tol_ ||
+          deriv_errors[i*table_ny_ + j] > table_deriv_tol_) {
+        for (int k=std::max(i-1, 0); k!=std::min(i+2, table_nx_); ++k) {
+          for (int l=std::max(j-1, 0); l!=std::min(j+2, table_ny_); ++l) {
+            table_cell_ok_[k*table_ny_ + l] = 0;
+          }
+        }
+      }
+    }
+  }
+
+  table_error_ = 0.;
+  table_deriv_error_ = 0.;
+  int nok = 0;
+  for (int k=0; k!=table_nx_ * table_ny_; ++k) {
+    if (table_cell_ok_[k]) {
+      table_error_ = std::max(table_error_, errors[k]);
+      table_deriv_error_ = std::max(table_deriv_error_, deriv_errors[k]);
+      nok++;
+    }
+  }
+  table_fraction_ = (double) nok / (table_nx_ * table_ny_);
+}
+
+
+// -- Bicubic Hermite interpolation of si, returning false outside the table
+bool WRMImplicitPermafrostModel::LookupSi_(double pc_liq, double pc_ice,
+        double& si, double& dsi_dpc_liq, double& dsi_dpc_ice) const {
+  if (!use_table_ || pc_liq <= 0. || pc_ice <= 0. || table_.empty()) return false;
+  double xi = (std::log(pc_liq) - table_x0_) / table_h_;
+  double yj = (std::log(pc_ice / pc_liq) - table_y0_) / table_h_;
+  if (xi < 0. || xi > table_nx_ || yj < 0. || yj > table_ny_) return false;
+
+  int i = std::min((int) xi, table_nx_ - 1);
+  int j = std::min((int) yj, table_ny_ - 1);
+  if (!table_cell_ok_.empty() && !table_cell_ok_[i*table_ny_ + j]) return false;
+  double t = xi - i;
+  double u = yj - j;
+
+  // Hermite basis functions and their derivatives: the value at 0, the value
+  // at 1, the slope at 0 and the slope at 1
+  double ht[4] = { (1. + 2.*t) * (1.-t) * (1.-t), t * t * (3. - 2.*t),
+                   t * (1.-t) * (1.-t), t * t * (t - 1.) };
+  double dht[4] = { 6.*t * (t - 1.), 6.*t * (1. - t),
+                    (1.-t) * (1. - 3.*t), t * (3.*t - 2.) };
+  double hu[4] = { (1. + 2.*u) * (1.-u) * (1.-u), u * u * (3. - 2.*u),
+                   u * (1.-u) * (1.-u), u * u * (u - 1.) };
+  double dhu[4] = { 6.*u * (u - 1.), 6.*u * (1. - u),
+                    (1.-u) * (1. - 3.*u), u * (3.*u - 2.) };
+
+  int ny = table_ny_ + 1;
+  double h = table_h_;
+  double f = 0., df_dt = 0., df_du = 0.;
+  for (int a=0; a!=2; ++a) {
+    for (int b=0; b!=2; ++b) {
+      const double* node = &table_[4 * ((i+a)*ny + j+b)];
+      double wt[2] = { ht[a], h * ht[2+a] };
+      double dwt[2] = { dht[a], h * dht[2+a] };
+      double wu[2] = { hu[b], h * hu[2+b] };
+      double dwu[2] = { dhu[b], h * dhu[2+b] };
+
+      f += node[0]*wt[0]*wu[0] + node[1]*wt[1]*wu[0] + node[2]*wt[0]*wu[1] + node[3]*wt[1]*wu[1];
+      df_dt += node[0]*dwt[0]*wu[0] + node[1]*dwt[1]*wu[0] + node[2]*dwt[0]*wu[1] + node[3]*dwt[1]*wu[1];
+      df_du += node[0]*wt[0]*dwu[0] + node[1]*wt[1]*dwu[0] + node[2]*wt[0]*dwu[1] + node[3]*wt[1]*dwu[1];
+    }
+  }
+
+  // back to derivatives in pc, with x = log pc_liq, y = log pc_ice - x
+  double dsi_dx = df_dt / h;
+  double dsi_dy = df_du / h;
+  si = std::min(std::max(f, 0.), 1.);
+  dsi_dpc_liq = (dsi_dx - dsi_dy) / pc_liq;
+  dsi_dpc_ice = dsi_dy / pc_ice;
+
+  // regularize, as in the implicit solve
+  if (std::abs(dsi_dpc_liq) < deriv_regularization_) {
+    dsi_dpc_liq = dsi_dpc_liq < 0. ? -deriv_regularization_ :
+        dsi_dpc_liq > 0. ? deriv_regularization_ : 0;
+  }
+  return true;
+}
+
+
 // PUBLIC METHODS
 // Calculate the saturation
 void WRMImplicitPermafrostModel::saturations(double pc_liq, double pc_ice,
@@ -398,6 +658,72 @@ void WRMImplicitPermafrostModel::dsaturations_dpc_ice(double pc_liq, double pc_i
   dsats_dpc_ice_frozen_unsaturated_(pc_liq, pc_ice, dsats);
 };
 
+void WRMImplicitPermafrostModel::saturations_warm(double pc_liq, double pc_ice,
+        double (&sats)[3], double& si) {
+  if (!sats_unfrozen_(pc_liq, pc_ice, sats) &&
+      !sats_saturated_(pc_liq, pc_ice, sats)) {
+    sats_frozen_unsaturated_(pc_liq, pc_ice, sats, si);
+  }
+  si = sats[2];
+}
+
+void WRMImplicitPermafrostModel::dsaturations_dpc_liq_warm(double pc_liq, double pc_ice,
+        double (&dsats)[3], double si) {
+  if (dsats_dpc_liq_unfrozen_(pc_liq, pc_ice, dsats)) return;
+  if (dsats_dpc_liq_saturated_(pc_liq, pc_ice, dsats)) return;
+  dsats_dpc_liq_frozen_unsaturated_(pc_liq, pc_ice, dsats, si);
+}
+
+void WRMImplicitPermafrostModel::dsaturations_dpc_ice_warm(double pc_liq, double pc_ice,
+        double (&dsats)[3], double si) {
+  if (dsats_dpc_ice_unfrozen_(pc_liq, pc_ice, dsats)) return;
+  if (dsats_dpc_ice_saturated_(pc_liq, pc_ice, dsats)) return;
+  dsats_dpc_ice_frozen_unsaturated_(pc_liq, pc_ice, dsats, si);
+}
+
+void WRMImplicitPermafrostModel::saturations_and_derivatives(double pc_liq, double pc_ice,
+        double (&sats)[3], double (&dsats_dpc_liq)[3], double (&dsats_dpc_ice)[3]) {
+  double si = -1.;
+  saturations_and_derivatives_warm(pc_liq, pc_ice, sats, dsats_dpc_liq, dsats_dpc_ice, si);
+}
+
+void WRMImplicitPermafrostModel::saturations_and_derivatives_warm(double pc_liq, double pc_ice,
+        double (&sats)[3], double (&dsats_dpc_liq)[3], double (&dsats_dpc_ice)[3],
+        double& si) {
+  if (sats_unfrozen_(pc_liq, pc_ice, sats)) {
+    dsats_dpc_liq_unfrozen_(pc_liq, pc_ice, dsats_dpc_liq);
+    dsats_dpc_ice_unfrozen_(pc_liq, pc_ice, dsats_dpc_ice);
+    si = sats[2];
+    return;
+  }
+  if (sats_saturated_(pc_liq, pc_ice, sats)) {
+    dsats_dpc_liq_saturated_(pc_liq, pc_ice, dsats_dpc_liq);
+    dsats_dpc_ice_saturated_(pc_liq, pc_ice, dsats_dpc_ice);
+    si = sats[2];
+    return;
+  }
+
+  // partially frozen, unsaturated: one solve (or lookup) for all
+  double dsi_dpcliq, dsi_dpcice;
+  if (!LookupSi_(pc_liq, pc_ice, si, dsi_dpcliq, dsi_dpcice)) {
+    si = si_frozen_unsaturated_(pc_liq, pc_ice, si);
+    dsi_dpcliq = dsi_dpc_liq_frozen_unsaturated_(pc_liq, pc_ice, si);
+    dsi_dpcice = dsi_dpc_ice_frozen_unsaturated_(pc_liq, pc_ice, si);
+  }
+  double sstar = wrm_->saturation(pc_liq);
+  sats[2] = si;
+  sats[1] = (1. - si) * sstar;
+  sats[0] = 1. - si - sats[1];
+
+  dsats_dpc_liq[2] = dsi_dpcliq;
+  dsats_dpc_liq[1] = (1. - si) * wrm_->d_saturation(pc_liq) - dsi_dpcliq * sstar;
+  dsats_dpc_liq[0] = - dsats_dpc_liq[1] - dsats_dpc_liq[2];
+
+  dsats_dpc_ice[2] = dsi_dpcice;
+  dsats_dpc_ice[1] = - dsi_dpcice * sstar;
+  dsats_dpc_ice[0] = - dsats_dpc_ice[1] - dsats_dpc_ice[2];
+}
+
 
 } // namespace
 } // namespace
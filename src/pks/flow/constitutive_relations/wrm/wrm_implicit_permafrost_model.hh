@@ -3,11 +3,40 @@ Author: Ethan Coon
 
 Painter's permafrost model.
 
+Partially frozen, unsaturated ice saturation is the root of an implicit
+equation, solved per call.  Optionally, ice saturation is instead tabulated
+at setup on a grid in (log pc_liq, log pc_ice/pc_liq), interpolated by
+bicubic Hermite polynomials through the solution and its derivatives at the
+nodes.  Outside the table, and in table cells where the interpolant is not
+accurate enough, the implicit equation is solved.
+
+Options:
+  "converged tolerance" [double] 1.e-12
+  "max iterations" [int] 100
+  "minimum dsi_dpressure magnitude" [double] 1.e-10
+  "solver algorithm [bisection/toms]" [string] "bisection"  One of
+      "bisection", "toms", or "newton".  Newton's method is safeguarded by
+      bisection steps, and starts from the last solution in each cell when
+      called by an evaluator, falling back to bisection if it does not
+      converge.
+  "use lookup table" [bool] false
+  "lookup table min capillary pressure [Pa]" [double] 1.0
+  "lookup table max capillary pressure [Pa]" [double] 1.e8  Range of pc_liq.
+  "lookup table max capillary pressure ratio [-]" [double] 1.e3  Range of
+      pc_ice / pc_liq is [1/ratio, ratio].
+  "lookup table nodes per decade" [int] 16
+  "lookup table accuracy bound" [double] 1.e-6  Max error in ice saturation,
+      checked against the implicit solve at five points in each table cell.
+      Table cells that fail the check use the implicit solve.
+  "lookup table derivative accuracy bound" [double] 1.e-2  Max relative
+      error in the derivatives of ice saturation, checked at the same points.
+
  */
 
 #ifndef AMANZI_FLOWRELATIONS_WRM_IMPLICIT_PERMAFROST_MODEL_
 #define AMANZI_FLOWRELATIONS_WRM_IMPLICIT_PERMAFROST_MODEL_
 
+#include <vector>
 #include "boost/cstdint.hpp"
 #include "boost/math/tools/roots.hpp"
 #include "boost/cstdint.hpp"
@@ -32,6 +61,40 @@ class WRMImplicitPermafrostModel : public WRMPermafrostModel {
   virtual void saturations(double pc_liq, double pc_ice, double (&sats)[3]);
   virtual void dsaturations_dpc_liq(double pc_liq, double pc_ice, double (&dsats)[3]);
   virtual void dsaturations_dpc_ice(double pc_liq, double pc_ice, double (&dsats)[3]);
+  virtual void saturations_and_derivatives(double pc_liq, double pc_ice,
+          double (&sats)[3], double (&dsats_dpc_liq)[3], double (&dsats_dpc_ice)[3]);
+
+  virtual void saturations_warm(double pc_liq, double pc_ice, double (&sats)[3],
+          double& si);
+  virtual void dsaturations_dpc_liq_warm(double pc_liq, double pc_ice,
+          double (&dsats)[3], double si);
+  virtual void dsaturations_dpc_ice_warm(double pc_liq, double pc_ice,
+          double (&dsats)[3], double si);
+  virtual void saturations_and_derivatives_warm(double pc_liq, double pc_ice,
+          double (&sats)[3], double (&dsats_dpc_liq)[3], double (&dsats_dpc_ice)[3],
+          double& si);
+
+  virtual void solver_statistics(int& solves, int& iterations, int& fallbacks) const {
+    solves = n_solves_;
+    iterations = n_iterations_;
+    fallbacks = n_fallbacks_;
+  }
+  virtual void reset_solver_statistics() {
+    n_solves_ = 0;
+    n_iterations_ = 0;
+    n_fallbacks_ = 0;
+  }
+
+  // builds the lookup table, if requested
+  virtual void set_WRM(const Teuchos::RCP<WRM>& wrm);
+
+  // max error of the lookup table in ice saturation, and max relative error
+  // in its derivatives, measured at setup, and the fraction of table cells
+  // used
+  bool use_lookup_table() const { return use_table_; }
+  double lookup_table_error() const { return table_error_; }
+  double lookup_table_derivative_error() const { return table_deriv_error_; }
+  double lookup_table_fraction() const { return table_fraction_; }
 
  protected:
   // calculation if unfrozen
@@ -45,25 +108,36 @@ class WRMImplicitPermafrostModel : public WRMPermafrostModel {
   bool dsats_dpc_ice_saturated_(double pc_liq, double pc_ice, double (&dsats)[3]);
 
   // calculation if unfrozen and saturated
-  bool sats_frozen_unsaturated_(double pc_liq, double pc_ice, double (&sats)[3]);
+  // si_guess, if in [0,1], is a starting point for Newton's method
+  bool sats_frozen_unsaturated_(double pc_liq, double pc_ice, double (&sats)[3],
+          double si_guess=-1.);
   bool dsats_dpc_liq_frozen_unsaturated_(double pc_liq, double pc_ice,
-          double (&dsats)[3]);
+          double (&dsats)[3], double si_guess=-1.);
   bool dsats_dpc_ice_frozen_unsaturated_(double pc_liq, double pc_ice,
-          double (&dsats)[3]);
+          double (&dsats)[3], double si_guess=-1.);
 
-  double si_frozen_unsaturated_(double pc_liq, double pc_ice);
+  double si_frozen_unsaturated_(double pc_liq, double pc_ice, double si_guess=-1.);
   double dsi_dpc_liq_frozen_unsaturated_(double pc_liq, double pc_ice, double si);
   double dsi_dpc_ice_frozen_unsaturated_(double pc_liq, double pc_ice, double si);
 
-  double si_frozen_unsaturated_nospline_(double pc_liq, double pc_ice, bool throw_ok=false);
+  double si_frozen_unsaturated_nospline_(double pc_liq, double pc_ice, bool throw_ok=false,
+          double si_guess=-1.);
+  double si_frozen_unsaturated_newton_(double pc_liq, double pc_ice, double si_guess,
+          bool& converged);
   double dsi_dpc_liq_frozen_unsaturated_nospline_(double pc_liq, double pc_ice,
           double si);
   double dsi_dpc_ice_frozen_unsaturated_nospline_(double pc_liq, double pc_ice,
           double si);
 
-  bool DetermineSplineCutoff_(double pc_liq, double pc_ice, double& cutoff, double& si);
+  bool DetermineSplineCutoff_(double pc_liq, double pc_ice, double& cutoff, double& si,
+          double si_guess=-1.);
   bool FitSpline_(double pc_ice, double cutoff, double si_cutoff, double (&coefs)[4]);
 
+  // lookup table of si in the partially frozen, unsaturated region
+  void BuildTable_();
+  bool LookupSi_(double pc_liq, double pc_ice, double& si,
+                 double& dsi_dpc_liq, double& dsi_dpc_ice) const;
+
 
  protected:
   double eps_;
@@ -71,6 +145,20 @@ class WRMImplicitPermafrostModel : public WRMPermafrostModel {
   double deriv_regularization_;
   std::string solver_;
 
+  // solver statistics
+  int n_solves_, n_iterations_, n_fallbacks_;
+
+  // table nodes are at (x0 + i*h, y0 + j*h), with x = log pc_liq and
+  // y = log (pc_ice / pc_liq), each holding si, dsi/dx, dsi/dy, d2si/dxdy
+  bool use_table_;
+  double table_x0_, table_y0_, table_h_;
+  int table_nx_, table_ny_;
+  double table_tol_, table_deriv_tol_;
+  double table_error_, table_deriv_error_;
+  double table_fraction_;
+  std::vector<double> table_;
+  std::vector<char> table_cell_ok_;
+
  private:
   // Functor for ice saturation, gets used within a root-finding algorithm
   class SatIceFunctor_ {
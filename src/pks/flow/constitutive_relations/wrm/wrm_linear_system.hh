@@ -34,6 +34,17 @@ public:
   virtual double d_capillaryPressure(double saturation) { return 1./alpha_; }
   virtual double residualSaturation() { return 0.0; }
 
+  // batched methods
+  virtual void saturation_batch(int n, const double* pc, double* s, double* ds_dpc) {
+    const double s0 = sat_at_zero_pc_, alpha = alpha_;
+    if (s) for (int i=0; i!=n; ++i) s[i] = s0 + alpha*pc[i];
+    if (ds_dpc) for (int i=0; i!=n; ++i) ds_dpc[i] = alpha;
+  }
+  virtual void k_relative_batch(int n, const double* s, double* kr, double* dkr_ds) {
+    if (kr) for (int i=0; i!=n; ++i) kr[i] = 1.0;
+    if (dkr_ds) for (int i=0; i!=n; ++i) dkr_ds[i] = 0.0;
+  }
+
  private:
   void InitializeFromPlist_();
 
@@ -6,6 +6,7 @@
 */
 
 #include "dbc.hh"
+#include "errors.hh"
 #include "wrm_factory.hh"
 #include "wrm_permafrost_factory.hh"
 #include "wrm_partition.hh"
@@ -14,6 +15,60 @@
 namespace Amanzi {
 namespace Flow {
 
+// -----------------------------------------------------------------------------
+// Initialize the partition and the list of owned cells in each region.
+// -----------------------------------------------------------------------------
+void WRMPartition::Initialize(const Teuchos::RCP<const AmanziMesh::Mesh>& mesh) {
+  if (!first->initialized()) {
+    first->Initialize(mesh, -1);
+    first->Verify();
+  }
+
+  if (region_cells_.size() != second.size()) {
+    region_cells_.assign(second.size(), AmanziMesh::Entity_ID_List());
+    int ncells = mesh->num_entities(AmanziMesh::CELL, AmanziMesh::Parallel_type::OWNED);
+    for (AmanziMesh::Entity_ID c=0; c!=ncells; ++c) {
+      region_cells_[(*first)[c]].push_back(c);
+    }
+  }
+}
+
+
+// -----------------------------------------------------------------------------
+// Index of the WRM of each entity of a component.
+// -----------------------------------------------------------------------------
+std::vector<int>
+WRMPartition::EntityRegions(const Teuchos::RCP<const AmanziMesh::Mesh>& mesh,
+                            const std::string& comp) const {
+  AMANZI_ASSERT(first->initialized());
+  std::vector<int> regions;
+  if (comp == "cell") {
+    int ncells = mesh->num_entities(AmanziMesh::CELL, AmanziMesh::Parallel_type::OWNED);
+    regions.resize(ncells);
+    for (AmanziMesh::Entity_ID c=0; c!=ncells; ++c) regions[c] = (*first)[c];
+
+  } else if (comp == "boundary_face") {
+    const Epetra_Map& vandelay_map = mesh->exterior_face_map(false);
+    const Epetra_Map& face_map = mesh->face_map(false);
+    AmanziMesh::Entity_ID_List cells;
+    int nbfaces = vandelay_map.NumMyElements();
+    regions.resize(nbfaces);
+    for (int bf=0; bf!=nbfaces; ++bf) {
+      AmanziMesh::Entity_ID f = face_map.LID(vandelay_map.GID(bf));
+      mesh->face_get_cells(f, AmanziMesh::Parallel_type::ALL, &cells);
+      AMANZI_ASSERT(cells.size() == 1);
+      regions[bf] = (*first)[cells[0]];
+    }
+
+  } else {
+    Errors::Message msg;
+    msg << "WRMPartition: no WRM for entities of component \"" << comp << "\".";
+    Exceptions::amanzi_throw(msg);
+  }
+  return regions;
+}
+
+
 // Non-member factory
 Teuchos::RCP<WRMPartition>
 createWRMPartition(Teuchos::ParameterList& plist) {
@@ -19,24 +19,116 @@ A list of (region, WRM) pairs, where the regions partition the mesh.
 * `"WRM type`" ``[string]`` Name of the WRM type.
 * `"_WRM_type_ parameters`" ``[_WRM_type_-spec]`` Spec for parameters of the requested type.
 
+Once initialized on a mesh, the partition also holds the list of owned cells
+in each region, so that evaluators may call each WRM once per region on
+contiguous arrays (see ForEachRegion()) rather than once per cell.
+
 */
 
 #ifndef AMANZI_FLOW_RELATIONS_WRM_PARTITION_
 #define AMANZI_FLOW_RELATIONS_WRM_PARTITION_
 
+#include <string>
+#include <vector>
+
+#include "Mesh.hh"
+#include "MeshPartition.hh"
+#include "parallel_for.hh"
 #include "wrm.hh"
 #include "wrm_permafrost_model.hh"
-#include "MeshPartition.hh"
 
 namespace Amanzi {
 namespace Flow {
 
 typedef std::vector<Teuchos::RCP<WRM> > WRMList;
-typedef std::pair<Teuchos::RCP<Functions::MeshPartition>, WRMList> WRMPartition;
+
+struct WRMPartition : public std::pair<Teuchos::RCP<Functions::MeshPartition>, WRMList> {
+  WRMPartition(const Teuchos::RCP<Functions::MeshPartition>& part,
+               const WRMList& wrms) :
+      std::pair<Teuchos::RCP<Functions::MeshPartition>, WRMList>(part, wrms) {}
+
+  // Initialize the partition, if it is not already, and the region lists.
+  void Initialize(const Teuchos::RCP<const AmanziMesh::Mesh>& mesh);
+
+  // Owned cells of each region, in increasing order.
+  const std::vector<AmanziMesh::Entity_ID_List>& region_cells() const {
+    return region_cells_;
+  }
+
+  // For each region, calls f(wrm, n, x_r, y0_r, y1_r) where x_r, y0_r and
+  // y1_r are contiguous arrays of the values of x, y0 and y1 on the n owned
+  // cells of the region.  Values are gathered and scattered unless the
+  // region's cells are contiguous.  y0 and y1 may be NULL.
+  template<class F>
+  void ForEachRegion(const double* x, double* y0, double* y1, const F& f) const;
+
+  // Index of the WRM of each entity of component comp, "cell" or
+  // "boundary_face", a boundary face taking the WRM of its cell.
+  std::vector<int> EntityRegions(const Teuchos::RCP<const AmanziMesh::Mesh>& mesh,
+                                 const std::string& comp) const;
+
+  // For each run of consecutive entities of [begin, begin+n) sharing a WRM,
+  // given their regions, calls f(wrm, i, m) for the m entities from begin+i.
+  template<class F>
+  void ForEachRun(const std::vector<int>& regions, int begin, int n, const F& f) const;
+
+ protected:
+  std::vector<AmanziMesh::Entity_ID_List> region_cells_;
+};
 
 typedef std::vector<Teuchos::RCP<WRMPermafrostModel> > WRMPermafrostModelList;
 typedef std::pair<Teuchos::RCP<Functions::MeshPartition>, WRMPermafrostModelList> WRMPermafrostModelPartition;
 
+template<class F>
+void WRMPartition::ForEachRegion(const double* x, double* y0, double* y1,
+        const F& f) const {
+  for (int r=0; r!=region_cells_.size(); ++r) {
+    const AmanziMesh::Entity_ID_List& cells = region_cells_[r];
+    int n = cells.size();
+    if (n == 0) continue;
+    WRM& wrm = *second[r];
+
+    if (cells.back() - cells.front() + 1 == n) {
+      // contiguous, work in place
+      int c0 = cells.front();
+      Threading::parallel_for_chunks(n, [&](int begin, int end) {
+          f(wrm, end - begin, x + c0 + begin,
+            y0 ? y0 + c0 + begin : NULL, y1 ? y1 + c0 + begin : NULL);
+        });
+
+    } else {
+      Threading::parallel_for_chunks(n, [&](int begin, int end) {
+          int m = end - begin;
+          std::vector<double> work(3*m);
+          double* x_r = &work[0];
+          double* y0_r = y0 ? &work[m] : NULL;
+          double* y1_r = y1 ? &work[2*m] : NULL;
+
+          for (int i=0; i!=m; ++i) x_r[i] = x[cells[begin+i]];
+          f(wrm, m, x_r, y0_r, y1_r);
+          if (y0) for (int i=0; i!=m; ++i) y0[cells[begin+i]] = y0_r[i];
+          if (y1) for (int i=0; i!=m; ++i) y1[cells[begin+i]] = y1_r[i];
+        });
+    }
+  }
+}
+
+
+template<class F>
+void WRMPartition::ForEachRun(const std::vector<int>& regions, int begin, int n,
+        const F& f) const {
+  if (n == 0) return;
+  const int* r = &regions[begin];
+  int i = 0;
+  while (i < n) {
+    int j = i + 1;
+    while (j < n && r[j] == r[i]) ++j;
+    f(*second[r[i]], i, j - i);
+    i = j;
+  }
+}
+
+
 // Non-member factory
 Teuchos::RCP<WRMPartition>
 createWRMPartition(Teuchos::ParameterList& plist);
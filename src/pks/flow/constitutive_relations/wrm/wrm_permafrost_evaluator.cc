@@ -7,6 +7,9 @@
   Authors: Ethan Coon (ecoon@lanl.gov)
 */
 
+#include <algorithm>
+#include <cmath>
+
 #include "wrm_permafrost_evaluator.hh"
 #include "wrm_partition.hh"
 
@@ -169,14 +172,32 @@ void WRMPermafrostEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
 
   double sats[3];
   int ncells = satg_c.MyLength();
+  if (si_c_.size() != ncells) si_c_.assign(ncells, -1.);
   for (AmanziMesh::Entity_ID c=0; c!=ncells; ++c) {
     int i = (*permafrost_models_->first)[c];
-    permafrost_models_->second[i]->saturations(pc_liq_c[0][c], pc_ice_c[0][c], sats);
+    permafrost_models_->second[i]->saturations_warm(pc_liq_c[0][c], pc_ice_c[0][c],
+            sats, si_c_[c]);
     satg_c[0][c] = sats[0];
     satl_c[0][c] = sats[1];
     sati_c[0][c] = sats[2];
   }
 
+  // report the cost of models that solve for ice saturation
+  int solves(0), iterations(0), fallbacks(0);
+  for (const auto& model : permafrost_models_->second) {
+    int s, it, f;
+    model->solver_statistics(s, it, f);
+    model->reset_solver_statistics();
+    solves += s;
+    iterations += it;
+    fallbacks += f;
+  }
+  if (solves > 0 && vo_->os_OK(Teuchos::VERB_EXTREME)) {
+    Teuchos::OSTab tab = vo_->getOSTab();
+    *vo_->os() << "ice saturation solves: " << solves << ", mean iterations: "
+               << (double) iterations / solves << ", fallbacks: " << fallbacks << std::endl;
+  }
+
   // Potentially do face values as well, though only for saturation_liquid?
   if (results[0]->HasComponent("boundary_face")) {
     Epetra_MultiVector& satg_bf = *results[0]->ViewComponent("boundary_face",false);
@@ -195,6 +216,7 @@ void WRMPermafrostEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
 
     // calculate boundary face values
     int nbfaces = satg_bf.MyLength();
+    if (si_bf_.size() != nbfaces) si_bf_.assign(nbfaces, -1.);
     for (int bf=0; bf!=nbfaces; ++bf) {
       // given a boundary face, we need the internal cell to choose the right WRM
       AmanziMesh::Entity_ID f = face_map.LID(vandelay_map.GID(bf));
@@ -203,7 +225,7 @@ void WRMPermafrostEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
 
       int i = (*permafrost_models_->first)[cells[0]];
       permafrost_models_->second[i]
-          ->saturations(pc_liq_bf[0][bf], pc_ice_bf[0][bf], sats);
+          ->saturations_warm(pc_liq_bf[0][bf], pc_ice_bf[0][bf], sats, si_bf_[bf]);
       satg_bf[0][bf] = sats[0];
       satl_bf[0][bf] = sats[1];
       sati_bf[0][bf] = sats[2];
@@ -221,6 +243,16 @@ WRMPermafrostEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State
     permafrost_models_->first->Verify();
   }
 
+  // offset of the requested derivatives in the cache entries
+  int offset = 0;
+  if (wrt_key == pc_liq_key_) {
+    offset = 2;
+  } else if (wrt_key == pc_ice_key_) {
+    offset = 5;
+  } else {
+    AMANZI_ASSERT(0);
+  }
+
   // Cell values
   Epetra_MultiVector& satg_c = *results[0]->ViewComponent("cell",false);
   Epetra_MultiVector& satl_c = *results[1]->ViewComponent("cell",false);
@@ -231,32 +263,16 @@ WRMPermafrostEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State
   const Epetra_MultiVector& pc_ice_c = *S->GetFieldData(pc_ice_key_)
       ->ViewComponent("cell",false);
 
-  double dsats[3];
-  if (wrt_key == pc_liq_key_) {
-    int ncells = satg_c.MyLength();
-    for (AmanziMesh::Entity_ID c=0; c!=ncells; ++c) {
-      int i = (*permafrost_models_->first)[c];
-      permafrost_models_->second[i]->dsaturations_dpc_liq(
-          pc_liq_c[0][c], pc_ice_c[0][c], dsats);
-
-      satg_c[0][c] = dsats[0];
-      satl_c[0][c] = dsats[1];
-      sati_c[0][c] = dsats[2];
-    }
-
-  } else if (wrt_key == pc_ice_key_) {
-    int ncells = satg_c.MyLength();
-    for (AmanziMesh::Entity_ID c=0; c!=ncells; ++c) {
-      int i = (*permafrost_models_->first)[c];
-      permafrost_models_->second[i]->dsaturations_dpc_ice(
-          pc_liq_c[0][c], pc_ice_c[0][c], dsats);
-
-      satg_c[0][c] = dsats[0];
-      satl_c[0][c] = dsats[1];
-      sati_c[0][c] = dsats[2];
-    }
-  } else {
-    AMANZI_ASSERT(0);
+  int ncells = satg_c.MyLength();
+  if (si_c_.size() != ncells) si_c_.assign(ncells, -1.);
+  if (dsats_c_.size() != 8*ncells) dsats_c_.assign(8*ncells, std::nan(""));
+  for (AmanziMesh::Entity_ID c=0; c!=ncells; ++c) {
+    int i = (*permafrost_models_->first)[c];
+    const double* dsats = Derivatives_(*permafrost_models_->second[i],
+            pc_liq_c[0][c], pc_ice_c[0][c], si_c_[c], &dsats_c_[8*c]) + offset;
+    satg_c[0][c] = dsats[0];
+    satl_c[0][c] = dsats[1];
+    sati_c[0][c] = dsats[2];
   }
 
   // Potentially do face values as well, though only for saturation_liquid?
@@ -275,46 +291,48 @@ WRMPermafrostEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State
     const Epetra_Map& vandelay_map = mesh->exterior_face_map(false);
     AmanziMesh::Entity_ID_List cells;
 
-    if (wrt_key == pc_liq_key_) {
-      // calculate boundary face values
-      int nbfaces = satl_bf.MyLength();
-      for (int bf=0; bf!=nbfaces; ++bf) {
-        // given a boundary face, we need the internal cell to choose the right WRM
-        AmanziMesh::Entity_ID f = face_map.LID(vandelay_map.GID(bf));
-        mesh->face_get_cells(f, AmanziMesh::Parallel_type::ALL, &cells);
-        AMANZI_ASSERT(cells.size() == 1);
-
-        int i = (*permafrost_models_->first)[cells[0]];
-        permafrost_models_->second[i]->dsaturations_dpc_liq(
-            pc_liq_bf[0][bf], pc_ice_bf[0][bf], dsats);
-        satg_bf[0][bf] = dsats[0];
-        satl_bf[0][bf] = dsats[1];
-        sati_bf[0][bf] = dsats[2];
-      }
+    // calculate boundary face values
+    int nbfaces = satl_bf.MyLength();
+    if (si_bf_.size() != nbfaces) si_bf_.assign(nbfaces, -1.);
+    if (dsats_bf_.size() != 8*nbfaces) dsats_bf_.assign(8*nbfaces, std::nan(""));
+    for (int bf=0; bf!=nbfaces; ++bf) {
+      // given a boundary face, we need the internal cell to choose the right WRM
+      AmanziMesh::Entity_ID f = face_map.LID(vandelay_map.GID(bf));
+      mesh->face_get_cells(f, AmanziMesh::Parallel_type::ALL, &cells);
+      AMANZI_ASSERT(cells.size() == 1);
 
-    } else if (wrt_key == pc_ice_key_) {
-      // calculate boundary face values
-      int nbfaces = satl_bf.MyLength();
-      for (int bf=0; bf!=nbfaces; ++bf) {
-        // given a boundary face, we need the internal cell to choose the right WRM
-        AmanziMesh::Entity_ID f = face_map.LID(vandelay_map.GID(bf));
-        mesh->face_get_cells(f, AmanziMesh::Parallel_type::ALL, &cells);
-        AMANZI_ASSERT(cells.size() == 1);
-
-        int i = (*permafrost_models_->first)[cells[0]];
-        permafrost_models_->second[i]->dsaturations_dpc_ice(
-            pc_liq_bf[0][bf], pc_ice_bf[0][bf], dsats);
-        satg_bf[0][bf] = dsats[0];
-        satl_bf[0][bf] = dsats[1];
-        sati_bf[0][bf] = dsats[2];
-      }
-    } else {
-      AMANZI_ASSERT(0);
+      int i = (*permafrost_models_->first)[cells[0]];
+      const double* dsats = Derivatives_(*permafrost_models_->second[i],
+              pc_liq_bf[0][bf], pc_ice_bf[0][bf], si_bf_[bf], &dsats_bf_[8*bf]) + offset;
+      satg_bf[0][bf] = dsats[0];
+      satl_bf[0][bf] = dsats[1];
+      sati_bf[0][bf] = dsats[2];
     }
   }
 }
 
 
+// Derivatives of the saturations with respect to both capillary pressures, in
+// a cache entry of the capillary pressures followed by the derivatives.  Both
+// are computed with one solve for ice saturation, when the entry was computed
+// at other capillary pressures, so that the second derivative requested
+// reuses the solve of the first.
+const double*
+WRMPermafrostEvaluator::Derivatives_(WRMPermafrostModel& model,
+        double pc_liq, double pc_ice, double& si, double* entry) {
+  if (entry[0] != pc_liq || entry[1] != pc_ice) {
+    double sats[3], dsats_dpc_liq[3], dsats_dpc_ice[3];
+    model.saturations_and_derivatives_warm(pc_liq, pc_ice, sats,
+            dsats_dpc_liq, dsats_dpc_ice, si);
+    entry[0] = pc_liq;
+    entry[1] = pc_ice;
+    std::copy(dsats_dpc_liq, dsats_dpc_liq+3, entry+2);
+    std::copy(dsats_dpc_ice, dsats_dpc_ice+3, entry+5);
+  }
+  return entry;
+}
+
+
 
 } // namespace
 } // namespace
@@ -9,6 +9,8 @@
 #ifndef AMANZI_FLOW_RELATIONS_WRM_PERMAFROST_EVALUATOR_
 #define AMANZI_FLOW_RELATIONS_WRM_PERMAFROST_EVALUATOR_
 
+#include <vector>
+
 #include "wrm.hh"
 #include "wrm_partition.hh"
 #include "wrm_permafrost_model.hh"
@@ -43,6 +45,9 @@ class WRMPermafrostEvaluator : public SecondaryVariablesFieldEvaluator {
 
   void InitializeFromPlist_();
 
+  const double* Derivatives_(WRMPermafrostModel& model, double pc_liq,
+          double pc_ice, double& si, double* entry);
+
  protected:
   Key pc_liq_key_;
   Key pc_ice_key_;
@@ -50,6 +55,16 @@ class WRMPermafrostEvaluator : public SecondaryVariablesFieldEvaluator {
   Teuchos::RCP<WRMPermafrostModelPartition> permafrost_models_;
   Teuchos::RCP<WRMPartition> wrms_;
 
+  // last ice saturation on each cell and boundary face, which warm starts
+  // models that solve for it
+  std::vector<double> si_c_;
+  std::vector<double> si_bf_;
+
+  // derivatives with respect to both capillary pressures on each cell and
+  // boundary face, with the capillary pressures they are at, 8 per entity
+  std::vector<double> dsats_c_;
+  std::vector<double> dsats_bf_;
+
  private:
   static Utils::RegisteredFactory<FieldEvaluator,WRMPermafrostEvaluator> factory_;
 
@@ -22,7 +22,7 @@ public:
 
   virtual ~WRMPermafrostModel() {}
 
-  void set_WRM(const Teuchos::RCP<WRM>& wrm) { wrm_ = wrm; }
+  virtual void set_WRM(const Teuchos::RCP<WRM>& wrm) { wrm_ = wrm; }
 
   virtual bool freezing(double T, double pc_liq, double pc_ice) = 0;
   virtual void saturations(double pc_liq, double pc_ice, double (&sats)[3]) = 0;
@@ -31,6 +31,49 @@ public:
   virtual void dsaturations_dpc_ice(double pc_liq, double pc_ice,
           double (&dsats)[3]) = 0;
 
+  // saturations and their derivatives with respect to both capillary
+  // pressures, which models may compute more cheaply together
+  virtual void saturations_and_derivatives(double pc_liq, double pc_ice,
+          double (&sats)[3], double (&dsats_dpc_liq)[3], double (&dsats_dpc_ice)[3]) {
+    saturations(pc_liq, pc_ice, sats);
+    dsaturations_dpc_liq(pc_liq, pc_ice, dsats_dpc_liq);
+    dsaturations_dpc_ice(pc_liq, pc_ice, dsats_dpc_ice);
+  }
+
+  // As above, warm started for models that solve for ice saturation: si is
+  // a guess, e.g. the last solution in this cell, or negative if there is
+  // none.  saturations_warm() returns the ice saturation in si.
+  virtual void saturations_warm(double pc_liq, double pc_ice, double (&sats)[3],
+          double& si) {
+    saturations(pc_liq, pc_ice, sats);
+    si = sats[2];
+  }
+  virtual void dsaturations_dpc_liq_warm(double pc_liq, double pc_ice,
+          double (&dsats)[3], double si) {
+    dsaturations_dpc_liq(pc_liq, pc_ice, dsats);
+  }
+  virtual void dsaturations_dpc_ice_warm(double pc_liq, double pc_ice,
+          double (&dsats)[3], double si) {
+    dsaturations_dpc_ice(pc_liq, pc_ice, dsats);
+  }
+  virtual void saturations_and_derivatives_warm(double pc_liq, double pc_ice,
+          double (&sats)[3], double (&dsats_dpc_liq)[3], double (&dsats_dpc_ice)[3],
+          double& si) {
+    saturations_warm(pc_liq, pc_ice, sats, si);
+    dsaturations_dpc_liq_warm(pc_liq, pc_ice, dsats_dpc_liq, si);
+    dsaturations_dpc_ice_warm(pc_liq, pc_ice, dsats_dpc_ice, si);
+  }
+
+  // Number of solves for ice saturation, their total iterations, and the
+  // number of warm-started solves that fell back to bracketing, since the
+  // last reset.
+  virtual void solver_statistics(int& solves, int& iterations, int& fallbacks) const {
+    solves = 0;
+    iterations = 0;
+    fallbacks = 0;
+  }
+  virtual void reset_solver_statistics() {}
+
  protected:
   Teuchos::ParameterList plist_;
   Teuchos::RCP<WRM> wrm_;
@@ -0,0 +1,67 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  Liquid and gas saturations, as a pointwise kernel.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include "wrm_saturation_kernel.hh"
+
+namespace Amanzi {
+namespace Flow {
+
+WRMSaturationKernel::WRMSaturationKernel(Teuchos::ParameterList& plist) :
+    Relations::PointwiseKernel(plist) {
+  AMANZI_ASSERT(plist_.isSublist("WRM parameters"));
+  Teuchos::ParameterList wrm_plist = plist_.sublist("WRM parameters");
+  wrms_ = createWRMPartition(wrm_plist);
+
+  args_.push_back(Keys::readKey(plist_, domain_, "capillary pressure",
+          "capillary_pressure_gas_liq"));
+  results_.push_back(Keys::readKey(plist_, domain_, "saturation", "saturation_liquid"));
+  results_.push_back(Keys::readKey(plist_, domain_, "other saturation", "saturation_gas"));
+}
+
+
+void WRMSaturationKernel::Setup(const Teuchos::RCP<const AmanziMesh::Mesh>& mesh,
+        const std::vector<std::string>& components) {
+  wrms_->Initialize(mesh);
+  for (const auto& comp : components) regions_[comp] = wrms_->EntityRegions(mesh, comp);
+}
+
+
+void WRMSaturationKernel::Evaluate(const std::string& comp, int begin, int n,
+        const double* const* args, double* const* results) {
+  const double* pc = args[0];
+  double* sl = results[0];
+  wrms_->ForEachRun(regions_.at(comp), begin, n,
+                    [=](WRM& wrm, int i, int m) {
+                      wrm.saturation_batch(m, pc+i, sl+i, NULL);
+                    });
+
+  double* sg = results[1];
+  for (int i=0; i!=n; ++i) sg[i] = 1. - sl[i];
+}
+
+
+void WRMSaturationKernel::EvaluateWithDerivatives(const std::string& comp, int begin, int n,
+        const double* const* args, double* const* results, double* const* jac) {
+  const double* pc = args[0];
+  double* sl = results[0];
+  double* dsl = jac[0];
+  wrms_->ForEachRun(regions_.at(comp), begin, n,
+                    [=](WRM& wrm, int i, int m) {
+                      wrm.saturation_batch(m, pc+i, sl+i, dsl+i);
+                    });
+
+  double* sg = results[1];
+  double* dsg = jac[1];
+  for (int i=0; i!=n; ++i) {
+    sg[i] = 1. - sl[i];
+    dsg[i] = -dsl[i];
+  }
+}
+
+} //namespace
+} //namespace
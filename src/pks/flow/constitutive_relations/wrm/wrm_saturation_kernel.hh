@@ -0,0 +1,62 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! WRMSaturationKernel: liquid and gas saturations, as a pointwise kernel.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+/*!
+
+Computes what WRMEvaluator does, on tiles of cells or boundary faces, for
+use in a FusedPointwiseEvaluator.  Its `"kernel type`" is `"WRM saturation`".
+
+* `"capillary pressure key`" ``[string]`` **DOMAIN-capillary_pressure_gas_liq**
+* `"saturation key`" ``[string]`` **DOMAIN-saturation_liquid**
+* `"other saturation key`" ``[string]`` **DOMAIN-saturation_gas**
+* `"WRM parameters`" ``[wrm-partition-typed-spec-list]``
+
+*/
+
+#ifndef AMANZI_FLOW_RELATIONS_WRM_SATURATION_KERNEL_
+#define AMANZI_FLOW_RELATIONS_WRM_SATURATION_KERNEL_
+
+#include <map>
+
+#include "PointwiseKernel.hh"
+#include "wrm_partition.hh"
+
+namespace Amanzi {
+namespace Flow {
+
+class WRMSaturationKernel : public Relations::PointwiseKernel {
+
+ public:
+  explicit
+  WRMSaturationKernel(Teuchos::ParameterList& plist);
+
+  virtual void Setup(const Teuchos::RCP<const AmanziMesh::Mesh>& mesh,
+                     const std::vector<std::string>& components);
+
+  virtual void Evaluate(const std::string& comp, int begin, int n,
+                        const double* const* args, double* const* results);
+  virtual void EvaluateWithDerivatives(const std::string& comp, int begin, int n,
+          const double* const* args, double* const* results, double* const* jac);
+
+  Teuchos::RCP<WRMPartition> get_WRMs() { return wrms_; }
+
+ protected:
+  Teuchos::RCP<WRMPartition> wrms_;
+  std::map<std::string, std::vector<int> > regions_;
+
+ private:
+  static Utils::RegisteredFactory<Relations::PointwiseKernel,WRMSaturationKernel> factory_;
+};
+
+} //namespace
+} //namespace
+
+#endif
@@ -0,0 +1,10 @@
+#include "wrm_saturation_kernel.hh"
+
+namespace Amanzi {
+namespace Flow {
+
+// registry of method
+Utils::RegisteredFactory<Relations::PointwiseKernel,WRMSaturationKernel> WRMSaturationKernel::factory_("WRM saturation");
+
+} //namespace
+} //namespace
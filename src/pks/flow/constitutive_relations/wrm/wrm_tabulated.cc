@@ -0,0 +1,250 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  A table-based approximation of any other WRM.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include <cmath>
+#include "errors.hh"
+
+#include "wrm_factory.hh"
+#include "wrm_tabulated.hh"
+
+namespace Amanzi {
+namespace Flow {
+
+WRMTabulated::WRMTabulated(Teuchos::ParameterList& plist) :
+    plist_(plist) {
+  InitializeFromPlist_();
+};
+
+
+/* ******************************************************************
+ * Saturation as a function of log pc.
+ ****************************************************************** */
+double WRMTabulated::saturation(double pc) {
+  if (pc > 0.) {
+    double x = std::log(pc);
+    if (x > log_pc_min_ && x < log_pc_max_) {
+      double ds_dx;
+      return sat_(x, &ds_dx);
+    }
+  }
+  return model_->saturation(pc);
+}
+
+
+double WRMTabulated::d_saturation(double pc) {
+  if (pc > 0.) {
+    double x = std::log(pc);
+    if (x > log_pc_min_ && x < log_pc_max_) {
+      double ds_dx;
+      sat_(x, &ds_dx);
+      return ds_dx / pc;
+    }
+  }
+  return model_->d_saturation(pc);
+}
+
+
+/* ******************************************************************
+ * Relative permeability as a function of log (1 - se).
+ ****************************************************************** */
+double WRMTabulated::k_relative(double s) {
+  double dse = 1. - (s - sr_) / (1. - sr_);
+  if (dse > 0.) {
+    double x = std::log(dse);
+    if (x > log_dse_min_ && x < log_dse_max_) {
+      double dkr_dx;
+      return kr_(x, &dkr_dx);
+    }
+  }
+  return model_->k_relative(s);
+}
+
+
+double WRMTabulated::d_k_relative(double s) {
+  double dse = 1. - (s - sr_) / (1. - sr_);
+  if (dse > 0.) {
+    double x = std::log(dse);
+    if (x > log_dse_min_ && x < log_dse_max_) {
+      double dkr_dx;
+      kr_(x, &dkr_dx);
+      return -dkr_dx / ((1. - sr_) * dse);
+    }
+  }
+  return model_->d_k_relative(s);
+}
+
+
+/* ******************************************************************
+ * Batched lookups.  Values outside of the tables are rare, so the branch
+ * to the model is well predicted.
+ ****************************************************************** */
+void WRMTabulated::saturation_batch(int n, const double* pc, double* s, double* ds_dpc) {
+  const double x_min = log_pc_min_, x_max = log_pc_max_;
+  for (int i=0; i!=n; ++i) {
+    double x = std::log(std::max(pc[i], 1.e-300));
+    if (x > x_min && x < x_max) {
+      double ds_dx;
+      double s_i = sat_(x, &ds_dx);
+      if (s) s[i] = s_i;
+      if (ds_dpc) ds_dpc[i] = ds_dx / pc[i];
+    } else {
+      if (s) s[i] = model_->saturation(pc[i]);
+      if (ds_dpc) ds_dpc[i] = model_->d_saturation(pc[i]);
+    }
+  }
+}
+
+
+void WRMTabulated::k_relative_batch(int n, const double* s, double* kr, double* dkr_ds) {
+  const double sr = sr_;
+  const double x_min = log_dse_min_, x_max = log_dse_max_;
+  for (int i=0; i!=n; ++i) {
+    double dse = 1. - (s[i] - sr) / (1. - sr);
+    double x = std::log(std::max(dse, 1.e-300));
+    if (x > x_min && x < x_max) {
+      double dkr_dx;
+      double kr_i = kr_(x, &dkr_dx);
+      if (kr) kr[i] = kr_i;
+      if (dkr_ds) dkr_ds[i] = -dkr_dx / ((1. - sr) * dse);
+    } else {
+      if (kr) kr[i] = model_->k_relative(s[i]);
+      if (dkr_ds) dkr_ds[i] = model_->d_k_relative(s[i]);
+    }
+  }
+}
+
+
+/* ******************************************************************
+ * Table of monotone cubic Hermite polynomials through f.
+ ****************************************************************** */
+template<class F>
+double WRMTabulated::Build_(Table& table, double x0, double x1, int n, const F& f) {
+  table.x0 = x0;
+  table.n = n;
+  table.h = (x1 - x0) / n;
+  table.inv_h = 1. / table.h;
+  double h = table.h;
+
+  std::vector<double> v(n+1), d(n+1);
+  for (int i=0; i!=n+1; ++i) v[i] = f(x0 + i*h, &d[i]);
+
+  // derivatives where the model's are not finite are the centered secant
+  for (int i=0; i!=n+1; ++i) {
+    if (!std::isfinite(d[i])) {
+      int lo = std::max(i-1, 0), hi = std::min(i+1, n);
+      d[i] = (v[hi] - v[lo]) / ((hi - lo) * h);
+    }
+  }
+
+  // Fritsch-Carlson limiting of the derivatives
+  for (int i=0; i!=n; ++i) {
+    double secant = (v[i+1] - v[i]) / h;
+    if (secant == 0.) {
+      d[i] = 0.;
+      d[i+1] = 0.;
+    } else {
+      double alpha = d[i] / secant;
+      double beta = d[i+1] / secant;
+      if (alpha < 0.) { d[i] = 0.; alpha = 0.; }
+      if (beta < 0.) { d[i+1] = 0.; beta = 0.; }
+      double r2 = alpha*alpha + beta*beta;
+      if (r2 > 9.) {
+        double tau = 3. / std::sqrt(r2);
+        d[i] = tau * alpha * secant;
+        d[i+1] = tau * beta * secant;
+      }
+    }
+  }
+
+  table.coefs.resize(4*n);
+  for (int i=0; i!=n; ++i) {
+    double* c = &table.coefs[4*i];
+    c[0] = v[i];
+    c[1] = h * d[i];
+    c[2] = 3.*(v[i+1] - v[i]) - 2.*h*d[i] - h*d[i+1];
+    c[3] = 2.*(v[i] - v[i+1]) + h*d[i] + h*d[i+1];
+  }
+
+  // error at interior points
+  double error = 0.;
+  for (int i=0; i!=n; ++i) {
+    for (int k=1; k!=4; ++k) {
+      double x = x0 + (i + 0.25*k) * h;
+      double df, dt;
+      error = std::max(error, std::abs(f(x, &df) - table(x, &dt)));
+    }
+  }
+  table.error = error;
+  return error;
+}
+
+
+template<class F>
+void WRMTabulated::BuildAccurate_(Table& table, double x0, double x1, const F& f,
+        const std::string& name) {
+  int n = n0_;
+  while (Build_(table, x0, x1, n, f) > tol_ && 2*n <= n_max_) n *= 2;
+
+  if (table.error > tol_) {
+    Errors::Message msg;
+    msg << "WRMTabulated: " << name << " table with " << n+1
+        << " nodes has error " << table.error << ", larger than the \"accuracy bound\" "
+        << tol_ << ".  Increase \"max number of nodes\" or the bound.";
+    Exceptions::amanzi_throw(msg);
+  }
+}
+
+
+void WRMTabulated::InitializeFromPlist_() {
+  if (!plist_.isSublist("tabulated model")) {
+    Errors::Message msg("WRMTabulated: missing sublist \"tabulated model\".");
+    Exceptions::amanzi_throw(msg);
+  }
+  model_plist_ = plist_.sublist("tabulated model");
+  WRMFactory fac;
+  model_ = fac.createWRM(model_plist_);
+  sr_ = model_->residualSaturation();
+
+  tol_ = plist_.get<double>("accuracy bound", 1.e-6);
+  n0_ = plist_.get<int>("number of nodes", 256) - 1;
+  n_max_ = plist_.get<int>("max number of nodes", 16384) - 1;
+  double pc_min = plist_.get<double>("min capillary pressure [Pa]", 1.0);
+  double pc_max = plist_.get<double>("max capillary pressure [Pa]", 1.e9);
+  double dse_min = plist_.get<double>("min distance to saturation [-]", 1.e-8);
+  if (pc_min <= 0. || pc_max <= pc_min || dse_min <= 0. || dse_min >= 0.5 || n0_ < 1) {
+    Errors::Message msg("WRMTabulated: invalid table range or number of nodes.");
+    Exceptions::amanzi_throw(msg);
+  }
+  log_pc_min_ = std::log(pc_min);
+  log_pc_max_ = std::log(pc_max);
+  log_dse_min_ = std::log(dse_min);
+  log_dse_max_ = std::log(1. - dse_min);
+
+  // s(x), x = log pc
+  WRM& model = *model_;
+  BuildAccurate_(sat_, log_pc_min_, log_pc_max_,
+                 [&model](double x, double* ds_dx) {
+                   double pc = std::exp(x);
+                   *ds_dx = model.d_saturation(pc) * pc;
+                   return model.saturation(pc);
+                 }, "saturation");
+
+  // kr(x), x = log (1 - se), stopping short of the residual saturation
+  // where derivatives of the model may be singular
+  double sr = sr_;
+  BuildAccurate_(kr_, log_dse_min_, log_dse_max_,
+                 [&model,sr](double x, double* dkr_dx) {
+                   double dse = std::exp(x);
+                   double s = sr + (1. - sr) * (1. - dse);
+                   *dkr_dx = -model.d_k_relative(s) * (1. - sr) * dse;
+                   return model.k_relative(s);
+                 }, "relative permeability");
+}
+
+}  // namespace
+}  // namespace
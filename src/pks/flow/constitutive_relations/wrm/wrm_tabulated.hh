@@ -0,0 +1,166 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! WRMTabulated : a table-based approximation of any other WRM.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+/*!
+
+Analytic models such as van Genuchten evaluate several powers per call, and
+are called on every cell at every nonlinear iteration.  This WRM wraps any
+other WRM, tabulating at setup:
+
+- saturation as a function of :math:`\log p_c`, on
+  :math:`[p_{c,min}, p_{c,max}]`, and
+- relative permeability as a function of :math:`\log (1 - s_e)`, where
+  :math:`s_e` is the effective saturation, on :math:`[0, 1 - \delta]`.
+
+Nodes are evenly spaced in these log variables, so that they cluster where
+the curves vary quickly, and a lookup is one log and a cubic.  Each interval
+is a cubic Hermite polynomial through the model's values and derivatives at
+its nodes, with derivatives limited (Fritsch-Carlson) so that the tables are
+monotone whenever the model is.  The tables are checked against the model
+at setup: if the error at interior points of any interval exceeds the
+accuracy bound, the number of nodes is doubled, up to a maximum, after which
+setup fails.  Outside the tabulated ranges (saturated, nearly saturated, or
+extremely dry) the model itself is called.
+
+Capillary pressure as a function of saturation is not tabulated.
+
+.. _WRM-tabulated-spec:
+.. admonition:: WRM-tabulated-spec
+
+    * `"tabulated model`" ``[WRM-typed-spec]`` The WRM to tabulate, including
+      its `"WRM Type`".
+
+    * `"accuracy bound`" ``[double]`` **1.e-6** Max absolute error allowed in
+      saturation and relative permeability.
+
+    * `"number of nodes`" ``[int]`` **256** Initial number of nodes of each
+      table.
+
+    * `"max number of nodes`" ``[int]`` **16384** Max number of nodes of each
+      table.
+
+    * `"min capillary pressure [Pa]`" ``[double]`` **1.0**
+
+    * `"max capillary pressure [Pa]`" ``[double]`` **1.e9**
+
+    * `"min distance to saturation [-]`" ``[double]`` **1.e-8** Smallest
+      tabulated :math:`1 - s_e`.
+
+Example:
+
+.. code-block:: xml
+
+    <ParameterList name="moss" type="ParameterList">
+      <Parameter name="region" type="string" value="moss" />
+      <Parameter name="WRM Type" type="string" value="tabulated" />
+      <Parameter name="accuracy bound" type="double" value="1.e-7" />
+      <ParameterList name="tabulated model" type="ParameterList">
+        <Parameter name="WRM Type" type="string" value="van Genuchten" />
+        <Parameter name="van Genuchten alpha" type="double" value="0.002" />
+        <Parameter name="van Genuchten m" type="double" value="0.2" />
+        <Parameter name="residual saturation" type="double" value="0.0" />
+      </ParameterList>
+    </ParameterList>
+
+*/
+
+#ifndef ATS_FLOWRELATIONS_WRM_TABULATED_
+#define ATS_FLOWRELATIONS_WRM_TABULATED_
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+
+#include "wrm.hh"
+#include "Factory.hh"
+
+namespace Amanzi {
+namespace Flow {
+
+class WRMTabulated : public WRM {
+
+public:
+  explicit WRMTabulated(Teuchos::ParameterList& plist);
+
+  // required methods from the base class
+  double k_relative(double saturation);
+  double d_k_relative(double saturation);
+  double saturation(double pc);
+  double d_saturation(double pc);
+  double capillaryPressure(double saturation) { return model_->capillaryPressure(saturation); }
+  double d_capillaryPressure(double saturation) { return model_->d_capillaryPressure(saturation); }
+  double residualSaturation() { return sr_; }
+
+  // batched lookups
+  void saturation_batch(int n, const double* pc, double* s, double* ds_dpc);
+  void k_relative_batch(int n, const double* s, double* kr, double* dkr_ds);
+
+  // accuracy of the tables, measured against the model at setup
+  const Teuchos::RCP<WRM>& model() { return model_; }
+  int num_nodes_saturation() const { return sat_.n + 1; }
+  int num_nodes_k_relative() const { return kr_.n + 1; }
+  double error_saturation() const { return sat_.error; }
+  double error_k_relative() const { return kr_.error; }
+
+ private:
+  // Piecewise cubics on evenly spaced nodes of [x0, x0 + n*h].  Interval i
+  // holds the coefficients of a + t(b + t(c + t d)), with t in [0,1].
+  struct Table {
+    double x0, h, inv_h;
+    int n;
+    std::vector<double> coefs;
+    double error;
+
+    double operator()(double x, double* deriv) const {
+      double xi = (x - x0) * inv_h;
+      int i = std::min(std::max(static_cast<int>(xi), 0), n-1);
+      double t = xi - i;
+      const double* c = &coefs[4*i];
+      *deriv = (c[1] + t*(2*c[2] + t*3*c[3])) * inv_h;
+      return c[0] + t*(c[1] + t*(c[2] + t*c[3]));
+    }
+  };
+
+  void InitializeFromPlist_();
+
+  // Build a table of f with nodes at x0 + i*h, where f(x, &df) returns the
+  // value and derivative.  Returns the max error at interior points.
+  template<class F>
+  double Build_(Table& table, double x0, double x1, int n, const F& f);
+
+  // Build tables, refining until the accuracy bound is met.
+  template<class F>
+  void BuildAccurate_(Table& table, double x0, double x1, const F& f,
+                      const std::string& name);
+
+  Teuchos::ParameterList plist_;
+  Teuchos::ParameterList model_plist_;
+  Teuchos::RCP<WRM> model_;
+
+  double sr_;
+  double tol_;
+  int n0_, n_max_;
+  double log_pc_min_, log_pc_max_;
+  double log_dse_min_, log_dse_max_;
+
+  Table sat_;  // s(log pc)
+  Table kr_;  // kr(log (1 - se))
+
+  static Utils::RegisteredFactory<WRM,WRMTabulated> factory_;
+};
+
+} //namespace
+} //namespace
+
+#endif
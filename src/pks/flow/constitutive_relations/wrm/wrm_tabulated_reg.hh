@@ -0,0 +1,15 @@
+/*
+  A table-based approximation of any other WRM.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include "wrm_tabulated.hh"
+
+namespace Amanzi {
+namespace Flow {
+
+Utils::RegisteredFactory<WRM,WRMTabulated> WRMTabulated::factory_("tabulated");
+
+}  // namespace
+}  // namespace
@@ -132,6 +132,61 @@ double WRMVanGenuchten::d_capillaryPressure(double s) {
 }
 
 
+/* ******************************************************************
+ * Batched saturation and its derivative.  With x = (alpha pc)^n, the
+ * derivative is -m n (1+x)^(-m-1) x/pc (1-sr), so the two share both
+ * powers.  Cells in the smoothed or saturated ranges are rare and use the
+ * pointwise formulas.
+ ****************************************************************** */
+void WRMVanGenuchten::saturation_batch(int n, const double* pc,
+        double* s, double* ds_dpc) {
+  const double alpha = alpha_, vg_n = n_, m = m_, sr = sr_, pc0 = pc0_;
+  for (int i=0; i!=n; ++i) {
+    double pc_i = pc[i];
+    if (pc_i > pc0 && pc_i > 0.) {
+      double x = std::pow(alpha*pc_i, vg_n);
+      double se = std::pow(1.0 + x, -m);
+      if (s) s[i] = se * (1.0 - sr) + sr;
+      if (ds_dpc) ds_dpc[i] = -m*vg_n * se / (1.0 + x) * x / pc_i * (1.0 - sr);
+    } else {
+      if (s) s[i] = saturation(pc_i);
+      if (ds_dpc) ds_dpc[i] = d_saturation(pc_i);
+    }
+  }
+}
+
+
+/* ******************************************************************
+ * Batched relative permeability and its derivative, sharing the powers
+ * x = se^(1/m) and y = (1-x)^m.
+ ****************************************************************** */
+void WRMVanGenuchten::k_relative_batch(int n, const double* s,
+        double* kr, double* dkr_ds) {
+  const double m = m_, l = l_, sr = sr_, s0 = s0_;
+  const bool mualem = function_ == FLOW_WRM_MUALEM;
+  for (int i=0; i!=n; ++i) {
+    double se = (s[i] - sr)/(1-sr);
+    if (s[i] <= s0 && se > 0.) {
+      double x = std::pow(se, 1.0/m);
+      double y = std::pow(1.0 - x, m);
+      if (mualem) {
+        double se_l = std::pow(se, l);
+        if (kr) kr[i] = se_l * (1.0 - y) * (1.0 - y);
+        if (dkr_ds) dkr_ds[i] = std::abs(1.0 - x) < FLOW_WRM_TOLERANCE ? 0.0 :
+          (1.0 - y) * (l * (1.0 - y) + 2 * x * y / (1.0 - x)) * se_l / se / (1 - sr);
+      } else {
+        if (kr) kr[i] = se * se * (1.0 - y);
+        if (dkr_ds) dkr_ds[i] = std::abs(1.0 - x) < FLOW_WRM_TOLERANCE ? 0.0 :
+          (2 * (1.0 - y) + x / (1.0 - x)) * se / (1 - sr);
+      }
+    } else {
+      if (kr) kr[i] = k_relative(s[i]);
+      if (dkr_ds) dkr_ds[i] = d_k_relative(s[i]);
+    }
+  }
+}
+
+
 void WRMVanGenuchten::InitializeFromPlist_() {
   std::string fname = plist_.get<std::string>("Krel function name", "Mualem");
   if (fname == std::string("Mualem")) {
@@ -70,6 +70,10 @@ public:
   double d_capillaryPressure(double saturation);
   double residualSaturation() { return sr_; }
 
+  // batched methods, sharing powers between values and derivatives
+  void saturation_batch(int n, const double* pc, double* s, double* ds_dpc);
+  void k_relative_batch(int n, const double* s, double* kr, double* dkr_ds);
+
  private:
   void InitializeFromPlist_();
 
@@ -46,8 +46,8 @@ Interfrost::UpdatePreconditioner(double t,
   if (vo_->os_OK(Teuchos::VERB_HIGH))
     *vo_->os() << "Precon update at t = " << t << std::endl;
 
-  // Recreate mass matrices
-  if (dynamic_mesh_) {
+  // Recreate mass matrices, if the mesh may have moved
+  if (untracked_deformation_) {
     matrix_diff_->SetTensorCoefficient(K_);
     preconditioner_diff_->SetTensorCoefficient(K_);
   }
@@ -166,7 +166,13 @@ Interfrost::UpdatePreconditioner(double t,
 
   if (precon_used_) {
     preconditioner_->AssembleMatrix();
-    preconditioner_->UpdatePreconditioner();
+    if (column_pc_ != Teuchos::null) {
+      column_pc_->Update(preconditioner_->A());
+    } else if (single_pc_ != Teuchos::null) {
+      single_pc_->Update(preconditioner_->A());
+    } else {
+      preconditioner_->UpdatePreconditioner();
+    }
   }      
       
 }
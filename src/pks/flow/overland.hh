@@ -66,9 +66,10 @@ public:
   // updates the preconditioner
   virtual void UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> up, double h);
 
-  // -- Compute a norm on u-du and return the result.
-  virtual double ErrorNorm(Teuchos::RCP<const TreeVector> u,
-                       Teuchos::RCP<const TreeVector> du);
+  // -- Compute the local part of a norm on u-du.
+  virtual void ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
+                              Teuchos::RCP<const TreeVector> du,
+                              std::vector<double>& norms);
   
 protected:
   // setup methods
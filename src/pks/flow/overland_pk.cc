@@ -190,7 +190,7 @@ void OverlandFlow::SetupOverlandFlow_(const Teuchos::Ptr<State>& S) {
   //    symbolic assemble
   precon_used_ = plist_->isSublist("preconditioner");
   if (precon_used_) {
-    preconditioner_->SymbolicAssembleMatrix();
+    pc_structure_->SymbolicAssemble(name_, *preconditioner_);
     preconditioner_->InitializePreconditioner(plist_->sublist("preconditioner"));
 
     //    Potentially create a linear solver
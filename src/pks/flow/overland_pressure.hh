@@ -78,6 +78,13 @@ Solves the diffusion wave equation for overland flow with pressure as a primary
     * `"allow no negative ponded depths`" ``[bool]`` **false** Modifies all
       correction updates to ensure only positive ponded depth is allowed.
 
+    * `"predictor type`" ``[string]`` **linear** A history-based predictor,
+      see predictor-spec_.  `"conserved variable`" is not supported.
+
+    * `"line search`" ``[line-search-spec]`` **optional** If provided, the
+      limited correction is further globalized by a line search on the
+      residual.
+
     * `"min ponded depth for velocity calculation`" ``[double]`` **1.e-2** For
       ponded depth below this height, declare the velocity 0.
 
@@ -199,9 +206,10 @@ public:
   // evaluating consistent faces for given BCs and cell values
   virtual void CalculateConsistentFaces(const Teuchos::Ptr<CompositeVector>& u);
   
-  // -- Compute a norm on u-du and return the result.
-  virtual double ErrorNorm(Teuchos::RCP<const TreeVector> u,
-                           Teuchos::RCP<const TreeVector> du);
+  // -- Compute the local part of a norm on u-du.
+  virtual void ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
+                              Teuchos::RCP<const TreeVector> du,
+                              std::vector<double>& norms);
 
   // -- Possibly modify the correction before it is applied
   virtual AmanziSolvers::FnBaseDefs::ModifyCorrectionResult
@@ -275,9 +283,6 @@ protected:
 
   // newton correction
   bool jacobian_;
-  int iter_;
-  double iter_counter_time_;
-  int jacobian_lag_;
   
 
   // work data space
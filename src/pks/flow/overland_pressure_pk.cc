@@ -62,10 +62,7 @@ OverlandPressureFlow::OverlandPressureFlow(Teuchos::ParameterList& pk_tree,
     niter_(0),
     source_only_if_unfrozen_(false),
     precon_used_(true),
-    jacobian_(false),
-    jacobian_lag_(0),
-    iter_(0),
-    iter_counter_time_(0.)
+    jacobian_(false)
 {
   if(!plist_->isParameter("conserved quantity key suffix"))
     plist_->set("conserved quantity key suffix", "water_content");
@@ -231,7 +228,7 @@ void OverlandPressureFlow::SetupOverlandFlow_(const Teuchos::Ptr<State>& S) {
   // If using approximate Jacobian for the preconditioner, we also need derivative information.
   jacobian_ = (mfd_pc_plist.get<std::string>("Newton correction", "none") != "none");
   if (jacobian_) {
-    jacobian_lag_ = mfd_pc_plist.get<int>("Newton correction lag", 0);
+    newton_control_ = Teuchos::rcp(new NewtonCorrectionControl(mfd_pc_plist, vo_));
     
     if (preconditioner_->RangeMap().HasComponent("face")) {
       // MFD -- upwind required
@@ -269,7 +266,7 @@ void OverlandPressureFlow::SetupOverlandFlow_(const Teuchos::Ptr<State>& S) {
   //    symbolic assemble
   precon_used_ = plist_->isSublist("preconditioner");
   if (precon_used_) {
-    preconditioner_->SymbolicAssembleMatrix();
+    pc_structure_->SymbolicAssemble(name_, *preconditioner_);
     preconditioner_->InitializePreconditioner(plist_->sublist("preconditioner"));
   }
 
@@ -298,6 +295,14 @@ void OverlandPressureFlow::SetupOverlandFlow_(const Teuchos::Ptr<State>& S) {
   // limiters
   p_limit_ = plist_->get<double>("limit correction to pressure change [Pa]", -1.);
   patm_limit_ = plist_->get<double>("limit correction when crossing atmospheric pressure [Pa]", -1.);
+  if (plist_->isSublist("line search"))
+    line_search_ = Teuchos::rcp(new LineSearchDelegate(plist_->sublist("line search"), vo_));
+
+  // ponded depth is linear in pressure, so "conserved variable" is just "linear"
+  if (predictor_ != Teuchos::null && predictor_->type() == "conserved variable") {
+    Errors::Message msg("OverlandPressureFlow: \"predictor type\" \"conserved variable\" is not supported, use \"linear\".");
+    Exceptions::amanzi_throw(msg);
+  }
   patm_hard_limit_ = plist_->get<bool>("allow no negative ponded depths", false);
   min_vel_ponded_depth_ = plist_->get<double>("min ponded depth for velocity calculation", 1e-2);
   min_tidal_bc_ponded_depth_ = plist_->get<double>("min ponded depth for tidal bc", 0.02);  
@@ -1330,7 +1335,12 @@ bool OverlandPressureFlow::ModifyPredictor(double h, Teuchos::RCP<const TreeVect
   if (vo_->os_OK(Teuchos::VERB_EXTREME))
     *vo_->os() << "Modifying predictor:" << std::endl;
 
-  return false;
+  bool changed = false;
+  if (predictor_ != Teuchos::null) {
+    changed = predictor_->ModifyPredictor(S_next_->time(), u);
+    predictor_->RecordPredictor(*u);
+  }
+  return changed;
 };
 
 
@@ -1504,9 +1514,16 @@ OverlandPressureFlow::ModifyCorrection(double h, Teuchos::RCP<const TreeVector>
     }
   }
 
+  // globalize with a line search on the residual norm
+  bool line_searched = false;
+  if (line_search_ != Teuchos::null) {
+    line_searched = line_search_->ModifyCorrection(*this, S_inter_->time(), S_next_->time(),
+            res, u, du);
+  }
+
   if (n_limited_spurt > 0) {
     return AmanziSolvers::FnBaseDefs::CORRECTION_MODIFIED_LAG_BACKTRACKING;
-  } else if (n_limited_change > 0) {
+  } else if (n_limited_change > 0 || line_searched) {
 
     return AmanziSolvers::FnBaseDefs::CORRECTION_MODIFIED;
   }
@@ -180,12 +180,10 @@ void OverlandPressureFlow::UpdatePreconditioner(double t, Teuchos::RCP<const Tre
   if (vo_->os_OK(Teuchos::VERB_EXTREME))
     *vo_->os() << "Precon update at t = " << t << std::endl;
 
-  // update state with the solution up.
-  if (std::abs(t - iter_counter_time_)/t > 1.e-4) {
-    iter_ = 0;
-    iter_counter_time_ = t;
-  }
+  // decide whether to include the Newton correction in this update
+  bool newton = jacobian_ && newton_control_->UpdatePreconditioner(t);
 
+  // update state with the solution up.
 
   AMANZI_ASSERT(std::abs(S_next_->time() - t) <= 1.e-4*t);
   
@@ -201,13 +199,13 @@ void OverlandPressureFlow::UpdatePreconditioner(double t, Teuchos::RCP<const Tre
   // -- update the rel perm according to the boundary info and upwinding
   // -- scheme of choice
   UpdatePermeabilityData_(S_next_.ptr());
-  if (jacobian_ && iter_ >= jacobian_lag_) UpdatePermeabilityDerivativeData_(S_next_.ptr());
+  if (newton) UpdatePermeabilityDerivativeData_(S_next_.ptr());
 
   Teuchos::RCP<const CompositeVector> cond =
     S_next_->GetFieldData(Keys::getKey(domain_,"upwind_overland_conductivity"));
 
   Teuchos::RCP<const CompositeVector> dcond = Teuchos::null;
-  if (jacobian_ && iter_ >= jacobian_lag_) {
+  if (newton) {
     if (preconditioner_->RangeMap().HasComponent("face")) {
       dcond = S_next_->GetFieldData(Keys::getDerivKey(Keys::getKey(domain_,"upwind_overland_conductivity"),Keys::getKey(domain_,"ponded_depth")));
     } else {
@@ -220,7 +218,7 @@ void OverlandPressureFlow::UpdatePreconditioner(double t, Teuchos::RCP<const Tre
   preconditioner_diff_->SetScalarCoefficient(cond, dcond);
 
   preconditioner_diff_->UpdateMatrices(Teuchos::null, Teuchos::null);
-  if (jacobian_ && iter_ >= jacobian_lag_) {
+  if (newton) {
     Teuchos::RCP<const CompositeVector> pres_elev = Teuchos::null;
     Teuchos::RCP<CompositeVector> flux = Teuchos::null;
     if (preconditioner_->RangeMap().HasComponent("face")) {
@@ -353,6 +351,7 @@ void OverlandPressureFlow::UpdatePreconditioner(double t, Teuchos::RCP<const Tre
 
   if (precon_used_) {
     preconditioner_->AssembleMatrix();
+    pc_structure_->Check(name_, *preconditioner_);
     preconditioner_->UpdatePreconditioner();
   }      
   
@@ -364,16 +363,14 @@ void OverlandPressureFlow::UpdatePreconditioner(double t, Teuchos::RCP<const Tre
   EpetraExt::RowMatrixToMatlabFile(filename_s.str().c_str(), *sc);
   *vo_->os() << "updated precon " << S_next_->cycle() << std::endl;
   */
-
-  // increment the iterator count
-  iter_++;
 };
 
 // -----------------------------------------------------------------------------
 // Default enorm that uses an abs and rel tolerance to monitor convergence.
+// This is the local part, reduced by PK_PhysicalBDF_Default::ErrorNorm().
 // -----------------------------------------------------------------------------
-double OverlandPressureFlow::ErrorNorm(Teuchos::RCP<const TreeVector> u,
-                               Teuchos::RCP<const TreeVector> res) {
+void OverlandPressureFlow::ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
+        Teuchos::RCP<const TreeVector> res, std::vector<double>& norms) {
 
   S_inter_->GetFieldEvaluator(conserved_key_)->HasFieldChanged(S_inter_.ptr(), name_);
   const Epetra_MultiVector& conserved = *S_inter_->GetFieldData(conserved_key_)
@@ -424,14 +421,12 @@ double OverlandPressureFlow::ErrorNorm(Teuchos::RCP<const TreeVector> u,
 
       const Epetra_MultiVector& kr_f = *S_next_->GetFieldData(Keys::getKey(domain_,"upwind_overland_conductivity"))
         ->ViewComponent("face",false);
+      const auto& face_cells = ErrorNormFaceCells_();
       
       for (unsigned int f=0; f!=nfaces; ++f) {
-        AmanziMesh::Entity_ID_List cells;
-        mesh_->face_get_cells(f, AmanziMesh::Parallel_type::OWNED, &cells);
-        double cv_min = cells.size() == 1 ? cv[0][cells[0]]
-            : std::min(cv[0][cells[0]],cv[0][cells[1]]);
-        double conserved_min = cells.size() == 1 ? conserved[0][cells[0]]
-            : std::min(conserved[0][cells[0]],conserved[0][cells[1]]);
+        int c0 = face_cells[2*f], c1 = face_cells[2*f+1];
+        double cv_min = std::min(cv[0][c0], cv[0][c1]);
+        double conserved_min = std::min(conserved[0][c0], conserved[0][c1]);
         
         double enorm_f = fluxtol_ * h * std::abs(dvec_v[0][f])
             / (atol_*cv_min + rtol_*std::abs(conserved_min));
@@ -467,13 +462,8 @@ double OverlandPressureFlow::ErrorNorm(Teuchos::RCP<const TreeVector> u,
     
     enorm_val = std::max(enorm_val, enorm_comp);
   }
-  
-  double enorm_val_l = enorm_val;
 
-  int ierr;
-  ierr = MPI_Allreduce(&enorm_val_l, &enorm_val, 1, MPI_DOUBLE, MPI_MAX, comm);
-  AMANZI_ASSERT(!ierr);
-  return enorm_val;
+  norms.push_back(enorm_val);
 }
   
 }  // namespace Flow
@@ -208,6 +208,7 @@ void OverlandFlow::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector>
   preconditioner_diff_->ApplyBCs(true, true, true);
   if (precon_used_) {
     preconditioner_->AssembleMatrix();
+    pc_structure_->Check(name_, *preconditioner_);
     preconditioner_->UpdatePreconditioner();
   }
 };
@@ -216,9 +217,10 @@ void OverlandFlow::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector>
 
 // -----------------------------------------------------------------------------
 // Default enorm that uses an abs and rel tolerance to monitor convergence.
+// This is the local part, reduced by PK_PhysicalBDF_Default::ErrorNorm().
 // -----------------------------------------------------------------------------
-double OverlandFlow::ErrorNorm(Teuchos::RCP<const TreeVector> u,
-        Teuchos::RCP<const TreeVector> res) {
+void OverlandFlow::ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
+        Teuchos::RCP<const TreeVector> res, std::vector<double>& norms) {
   const Epetra_MultiVector& pd = *S_next_->GetFieldData(key_)
       ->ViewComponent("cell",true);
   const Epetra_MultiVector& cv = *S_next_->GetFieldData(cell_vol_key_)
@@ -259,14 +261,12 @@ double OverlandFlow::ErrorNorm(Teuchos::RCP<const TreeVector> u,
       double constraint_scaling_cutoff = plist_->sublist("diffusion").get<double>("constraint equation scaling cutoff", 1.0);
       const Epetra_MultiVector& kr_f = *S_next_->GetFieldData(Keys::getDerivKey(Keys::getKey(domain_,"upwind_overland_conductivity"), key_))
         ->ViewComponent("face",false);
+      const auto& face_cells = ErrorNormFaceCells_();
 
       for (unsigned int f=0; f!=nfaces; ++f) {
-        AmanziMesh::Entity_ID_List cells;
-        mesh_->face_get_cells(f, AmanziMesh::Parallel_type::OWNED, &cells);
-        double cv_min = cells.size() == 1 ? cv[0][cells[0]]
-            : std::min(cv[0][cells[0]],cv[0][cells[1]]);
-        double conserved_min = cells.size() == 1 ? pd[0][cells[0]] * cv[0][cells[0]]
-            : std::min(pd[0][cells[0]]*cv[0][cells[0]], pd[0][cells[1]]*cv[0][cells[1]]);
+        int c0 = face_cells[2*f], c1 = face_cells[2*f+1];
+        double cv_min = std::min(cv[0][c0], cv[0][c1]);
+        double conserved_min = std::min(pd[0][c0]*cv[0][c0], pd[0][c1]*cv[0][c1]);
       
         double enorm_f = fluxtol_ * h * std::abs(dvec_v[0][f]) 
             / (atol_*cv_min + rtol_*std::abs(conserved_min));
@@ -302,10 +302,7 @@ double OverlandFlow::ErrorNorm(Teuchos::RCP<const TreeVector> u,
     enorm_val = std::max(enorm_val, enorm_comp);
   }
 
-  double enorm_val_l = enorm_val;
-  int ierr = MPI_Allreduce(&enorm_val_l, &enorm_val, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-  AMANZI_ASSERT(!ierr);
-  return enorm_val;
+  norms.push_back(enorm_val);
 };
 
 
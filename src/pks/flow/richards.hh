@@ -60,9 +60,15 @@ Solves Richards equation:
     * `"diffusion preconditioner`" ``[pde-diffusion-spec]`` **optional** The
       inverse of the diffusion operator.  See PDE_Diffusion_.  Typically this
       is only needed to set Jacobian options, as all others probably should
-      match those in `"diffusion`", and default to those values.
+      match those in `"diffusion`", and default to those values.  When a
+      `"Newton correction`" is requested, its use is controlled as in
+      newton-correction-control-spec_.
 
-    * `"preconditioner`" ``[preconditioner-typed-spec]`` Preconditioner for the solve.
+    * `"preconditioner`" ``[preconditioner-typed-spec]`` Preconditioner for the
+      solve.  In addition to the Preconditioner_ types, `"preconditioner
+      type`" may be `"column line`", see preconditioner-column-line-spec_,
+      or `"single precision ILU`", see preconditioner-single-precision-spec_.
+      These require a `"fv: default`" discretization and no `"linear solver`".
 
     * `"linear solver`" ``[linear-solver-typed-spec]`` **optional** May be used
       to improve the inverse of the diffusion preconditioner.  Only used if this
@@ -108,7 +114,11 @@ Solves Richards equation:
     * `"modify predictor via water content`" ``[bool]`` **false** Modifies the
       predictor using the method of Krabbenhoft [??] paper.  Effectively does a
       change of variables, extrapolating not in pressure but in water content,
-      then takes the smaller of the two extrapolants.
+      then takes the smaller of the two extrapolants.  This is the same as
+      `"predictor type`" = `"conserved variable`".
+
+    * `"predictor type`" ``[string]`` **linear** A history-based predictor,
+      see predictor-spec_.  All types are supported.
 
     * `"max valid change in saturation in a time step [-]`" ``[double]`` **-1**
       Rejects timesteps whose max saturation change is greater than this value.
@@ -128,6 +138,10 @@ Solves Richards equation:
       ``[double]`` **-1** If > 0, this limits an iterate's max pressure change
       to this value when they cross atmospheric pressure.  Not usually helpful.
 
+    * `"line search`" ``[line-search-spec]`` **optional** If provided, the
+      limited correction is further globalized by a line search on the
+      residual.
+
     INCLUDES:
 
     - ``[pk-physical-bdf-default-spec]`` A `PK: Physical and BDF`_ spec.
@@ -231,6 +245,7 @@ namespace Amanzi {
 class MPCSubsurface;
 class PredictorDelegateBCFlux;
 namespace WhetStone { class Tensor; }
+namespace Operators { class PreconditionerColumnLine; class PreconditionerSinglePrecision; }
 
 namespace Flow {
 
@@ -260,6 +275,11 @@ public:
   // -- limit changes in a valid time step
   virtual bool ValidStep();
 
+  // -- transfer operators, also recreating the operators' geometry if the
+  //    mesh has moved
+  virtual void State_to_Solution(const Teuchos::RCP<State>& S,
+                                 TreeVector& soln);
+
   // -- Update diagnostics for vis.
   virtual void CalculateDiagnostics(const Teuchos::RCP<State>& S);
 
@@ -298,6 +318,9 @@ protected:
 
   virtual void UpdateVelocity_(const Teuchos::Ptr<State>& S);
 
+  // -- checks for a deformation since the operators' geometry was built
+  bool IsMeshDeformed_(const Teuchos::Ptr<State>& S);
+
   virtual int BoundaryFaceGetCell(int f) const;
   virtual double BoundaryFaceValue(int f, const CompositeVector& u);
   // virtual double DeriveBoundaryFaceValue
@@ -401,12 +424,11 @@ protected:
   Teuchos::RCP<Operators::PDE_DiffusionWithGravity> face_matrix_diff_;
   Teuchos::RCP<Operators::PDE_Accumulation> preconditioner_acc_;
   Teuchos::RCP<Operators::Operator> lin_solver_;
+  Teuchos::RCP<Operators::PreconditionerColumnLine> column_pc_;
+  Teuchos::RCP<Operators::PreconditionerSinglePrecision> single_pc_;
 
   // flag to do jacobian and therefore coef derivs
   bool jacobian_;
-  int iter_;
-  double iter_counter_time_;
-  int jacobian_lag_;
   
 
   // residual vector for vapor diffusion
@@ -428,6 +450,9 @@ protected:
 
   // is this a dynamic mesh problem
   bool dynamic_mesh_;
+  bool untracked_deformation_;  // the mesh moves, but no deformation index is published
+  Key deformed_key_;
+  double geometry_deform_index_;
 
   // is vapor turned on
   bool vapor_diffusion_;
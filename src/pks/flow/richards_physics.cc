@@ -14,6 +14,7 @@
 
 #include "FieldEvaluator.hh"
 #include "Op.hh"
+#include "parallel_for.hh"
 #include "richards.hh"
 
 namespace Amanzi {
@@ -91,9 +92,9 @@ void Richards::AddSources_(const Teuchos::Ptr<State>& S,
 
     // Add into residual
     unsigned int ncells = g_c.MyLength();
-    for (unsigned int c=0; c!=ncells; ++c) {
-      g_c[0][c] -= source1[0][c] * cv[0][c];
-    }
+    Threading::parallel_for(ncells, [&](int c) {
+        g_c[0][c] -= source1[0][c] * cv[0][c];
+      });
 
     if (vo_->os_OK(Teuchos::VERB_EXTREME)) {
       *vo_->os() << "Adding external source term" << std::endl;
@@ -25,10 +25,13 @@ Authors: Neil Carlson (version 1)
 #include "CompositeVectorFunction.hh"
 #include "CompositeVectorFunctionFactory.hh"
 #include "LinearOperatorFactory.hh"
+#include "PreconditionerColumnLine.hh"
+#include "PreconditionerSinglePrecision.hh"
 
 #include "predictor_delegate_bc_flux.hh"
 #include "wrm_evaluator.hh"
 #include "rel_perm_evaluator.hh"
+#include "ProfiledFieldEvaluator.hh"
 #include "richards_water_content_evaluator.hh"
 #include "OperatorDefs.hh"
 #include "BoundaryFlux.hh"
@@ -60,13 +63,12 @@ Richards::Richards(Teuchos::ParameterList& pk_tree,
     modify_predictor_first_bc_flux_(false),
     upwind_from_prev_flux_(false),
     dynamic_mesh_(false),
+    untracked_deformation_(false),
+    geometry_deform_index_(0.),
     clobber_boundary_flux_dir_(false),
     vapor_diffusion_(false),
     perm_scale_(1.),
-    jacobian_(false),
-    jacobian_lag_(0),
-    iter_(0),
-    iter_counter_time_(0.)
+    jacobian_(false)
 {
   if (!plist_->isParameter("conserved quantity key suffix"))
     plist_->set("conserved quantity key suffix", "water_content");
@@ -260,7 +262,7 @@ void Richards::SetupRichardsFlow_(const Teuchos::Ptr<State>& S) {
   //    For now this means upwinding the derivative.
   jacobian_ = mfd_pc_plist.get<std::string>("Newton correction", "none") != "none";
   if (jacobian_) {
-    jacobian_lag_ = mfd_pc_plist.get<int>("Newton correction lag", 0);
+    newton_control_ = Teuchos::rcp(new NewtonCorrectionControl(mfd_pc_plist, vo_));
 
     //if (preconditioner_->RangeMap().HasComponent("face")) {
     if (mfd_pc_plist.get<std::string>("discretization primary") != "fv: default"){
@@ -308,8 +310,23 @@ void Richards::SetupRichardsFlow_(const Teuchos::Ptr<State>& S) {
   //    symbolic assemble
   precon_used_ = plist_->isSublist("preconditioner");
   if (precon_used_) {
-    preconditioner_->SymbolicAssembleMatrix();
-    preconditioner_->InitializePreconditioner(plist_->sublist("preconditioner"));
+    pc_structure_->SymbolicAssemble(name_, *preconditioner_);
+    std::string pc_type = plist_->sublist("preconditioner").get<std::string>("preconditioner type", "");
+    if (pc_type == "column line" || pc_type == "single precision ILU") {
+      if (mfd_pc_plist.get<std::string>("discretization primary") != "fv: default" ||
+          plist_->isSublist("linear solver")) {
+        Errors::Message msg;
+        msg << "Richards PK: the \"" << pc_type << "\" preconditioner requires an \"fv: default\" discretization and no \"linear solver\".";
+        Exceptions::amanzi_throw(msg);
+      }
+      if (pc_type == "column line") {
+        column_pc_ = Teuchos::rcp(new Operators::PreconditionerColumnLine(plist_->sublist("preconditioner"), mesh_));
+      } else {
+        single_pc_ = Teuchos::rcp(new Operators::PreconditionerSinglePrecision(plist_->sublist("preconditioner")));
+      }
+    } else {
+      preconditioner_->InitializePreconditioner(plist_->sublist("preconditioner"));
+    }
 
     //    Potentially create a linear solver
     if (plist_->isSublist("linear solver")) {
@@ -373,10 +390,20 @@ void Richards::SetupRichardsFlow_(const Teuchos::Ptr<State>& S) {
     plist_->get<bool>("modify predictor for initial flux BCs", false);
   modify_predictor_wc_ =
     plist_->get<bool>("modify predictor via water content", false);
+  if (predictor_ != Teuchos::null && predictor_->type() == "conserved variable") {
+    modify_predictor_wc_ = true;
+  } else if (modify_predictor_wc_ && predictor_ == Teuchos::null) {
+    // the water content predictor needs the solution history
+    Teuchos::ParameterList pred_list;
+    pred_list.set("predictor type", "conserved variable");
+    predictor_ = Teuchos::rcp(new PredictorDelegateHistory(pred_list, vo_));
+  }
 
   // correctors
   p_limit_ = plist_->get<double>("limit correction to pressure change [Pa]", -1.);
   patm_limit_ = plist_->get<double>("limit correction to pressure change when crossing atmospheric [Pa]", -1.);
+  if (plist_->isSublist("line search"))
+    line_search_ = Teuchos::rcp(new LineSearchDelegate(plist_->sublist("line search"), vo_));
 
   // valid step controls
   sat_change_limit_ = plist_->get<double>("max valid change in saturation in a time step [-]", -1.);
@@ -461,7 +488,7 @@ void Richards::SetupPhysicalEvaluators_(const Teuchos::Ptr<State>& S) {
   S->RequireFieldEvaluator(coef_key_);
 
   // -- get the WRM models
-  auto wrm_eval = Teuchos::rcp_dynamic_cast<Flow::WRMEvaluator>(wrm);
+  auto wrm_eval = Teuchos::rcp_dynamic_cast<Flow::WRMEvaluator>(Relations::get_wrapped(wrm));
   AMANZI_ASSERT(wrm_eval != Teuchos::null);
   wrms_ = wrm_eval->get_WRMs();
 
@@ -507,6 +534,9 @@ void Richards::Initialize(const Teuchos::Ptr<State>& S) {
 
   // check whether this is a dynamic mesh problem
   if (S->HasField("vertex coordinate")) dynamic_mesh_ = true;
+  deformed_key_ = Keys::getKey(domain_, "cell_deformation_index");
+  if (S->HasField(deformed_key_)) dynamic_mesh_ = true;
+  untracked_deformation_ = dynamic_mesh_ && !S->HasField(deformed_key_);
 
   // Set extra fields as initialized -- these don't currently have evaluators,
   // and will be initialized in the call to commit_state()
@@ -865,6 +895,52 @@ bool Richards::UpdatePermeabilityDerivativeData_(const Teuchos::Ptr<State>& S) {
 };
 
 
+// -----------------------------------------------------------------------------
+// Has the mesh deformed since the diffusion operators' geometry was built?
+//
+// Recreating the diffusion operators' geometric data (mass matrices or
+// transmissibilities) is expensive, so this is only done when the
+// deformation PK reports a deformation other than the one the operators
+// were built on.  This compares the index of the state evaluated, so that
+// a rolled back step, whose mesh is restored, also rebuilds.  If no
+// deformation PK publishes this information, the mesh may move at any time,
+// and the geometry is instead recreated in every residual and preconditioner
+// update.
+// -----------------------------------------------------------------------------
+bool Richards::IsMeshDeformed_(const Teuchos::Ptr<State>& S) {
+  if (!dynamic_mesh_ || untracked_deformation_) return false;
+
+  const Epetra_MultiVector& deformed = *S->GetFieldData(deformed_key_)
+      ->ViewComponent("cell",false);
+  double latest(0.);
+  deformed.MaxValue(&latest);
+  if (latest == geometry_deform_index_) return false;
+
+  if (vo_->os_OK(Teuchos::VERB_HIGH))
+    *vo_->os() << "  mesh deformation " << latest << " differs from "
+               << geometry_deform_index_ << ", recreating operator geometry" << std::endl;
+  geometry_deform_index_ = latest;
+  return true;
+}
+
+
+// -----------------------------------------------------------------------------
+// Transfer operators, at the start of each attempt at a step.
+//
+// A deformation PK only moves the mesh between steps, or it is restored when
+// a step is rolled back, so the operators' geometry is checked here rather
+// than in every residual.
+// -----------------------------------------------------------------------------
+void Richards::State_to_Solution(const Teuchos::RCP<State>& S,
+        TreeVector& solution) {
+  PK_PhysicalBDF_Default::State_to_Solution(S, solution);
+
+  if (IsMeshDeformed_(S.ptr())) {
+    matrix_diff_->SetTensorCoefficient(K_);
+    preconditioner_diff_->SetTensorCoefficient(K_);
+  }
+}
+
 
 
 // -----------------------------------------------------------------------------
@@ -1191,13 +1267,17 @@ bool Richards::ModifyPredictor(double h, Teuchos::RCP<const TreeVector> u0,
   bc_flux_->Compute(S_next_->time());
   UpdateBoundaryConditions_(S_next_.ptr());
   db_->WriteBoundaryConditions(bc_markers(), bc_values());
-  
+
+  // history-based predictors replace the linear extrapolant
+  bool changed(false);
+  if (predictor_ != Teuchos::null) {
+    changed |= predictor_->ModifyPredictor(S_next_->time(), u);
+  }
+
   // push Dirichlet data into predictor
   if (u->Data()->HasComponent("boundary_face")) {
     ApplyBoundaryConditions_(u->Data().ptr());
   }
-  
-  bool changed(false);
   if (modify_predictor_bc_flux_ ||
       (modify_predictor_first_bc_flux_ && 
        ((S_next_->cycle() == 0) || (S_next_->cycle() == 1)))) {
@@ -1211,6 +1291,8 @@ bool Richards::ModifyPredictor(double h, Teuchos::RCP<const TreeVector> u0,
   if (modify_predictor_with_consistent_faces_) {
     changed |= ModifyPredictorConsistentFaces_(h,u);
   }
+
+  if (predictor_ != Teuchos::null) predictor_->RecordPredictor(*u);
   return changed;
 }
 
@@ -1258,9 +1340,56 @@ bool Richards::ModifyPredictorConsistentFaces_(double h, Teuchos::RCP<TreeVector
   return true;
 }
 
+// -----------------------------------------------------------------------------
+// Extrapolate in saturation, invert through the WRM, and take the smaller of
+// the two extrapolants.  Cells with ice are left alone.
+// -----------------------------------------------------------------------------
 bool Richards::ModifyPredictorWC_(double h, Teuchos::RCP<TreeVector> u) {
-  AMANZI_ASSERT(0);
-  return false;
+  int n = predictor_->history_size();
+  if (n < 2) return false;
+
+  Teuchos::OSTab tab = vo_->getOSTab();
+  if (vo_->os_OK(Teuchos::VERB_EXTREME))
+    *vo_->os() << "  modifications via water content." << std::endl;
+
+  double patm = *S_next_->GetScalarData("atmospheric_pressure");
+  double t1 = predictor_->time(n-1);
+  double t0 = predictor_->time(n-2);
+  double factor = (S_next_->time() - t1) / (t1 - t0);
+
+  const Epetra_MultiVector& p1 = *predictor_->solution(n-1).Data()->ViewComponent("cell",false);
+  const Epetra_MultiVector& p0 = *predictor_->solution(n-2).Data()->ViewComponent("cell",false);
+  Epetra_MultiVector& u_c = *u->Data()->ViewComponent("cell",false);
+
+  Teuchos::RCP<const Epetra_MultiVector> sat_ice;
+  if (S_inter_->HasField(sat_ice_key_))
+    sat_ice = S_inter_->GetFieldData(sat_ice_key_)->ViewComponent("cell",false);
+
+  int my_modified = 0;
+  unsigned int ncells = u_c.MyLength();
+  for (unsigned int c=0; c!=ncells; ++c) {
+    if (sat_ice != Teuchos::null && (*sat_ice)[0][c] > 0.) continue;
+
+    const Teuchos::RCP<WRM>& wrm = wrms_->second[(*wrms_->first)[c]];
+    double s1 = wrm->saturation(patm - p1[0][c]);
+    double s0 = wrm->saturation(patm - p0[0][c]);
+    if (s1 >= 1. && s0 >= 1.) continue;
+
+    double sr = wrm->residualSaturation();
+    double s = s1 + factor * (s1 - s0);
+    s = std::min(std::max(s, sr + 1.e-6), 1.);
+    double p_wc = patm - wrm->capillaryPressure(s);
+    if (std::abs(p_wc - p1[0][c]) < std::abs(u_c[0][c] - p1[0][c])) {
+      u_c[0][c] = p_wc;
+      my_modified++;
+    }
+  }
+
+  int n_modified = 0;
+  mesh_->get_comm()->SumAll(&my_modified, &n_modified, 1);
+  if (vo_->os_OK(Teuchos::VERB_HIGH))
+    *vo_->os() << "  water content predictor modified " << n_modified << " cells." << std::endl;
+  return n_modified > 0;
 }
 
 
@@ -1568,9 +1697,16 @@ Richards::ModifyCorrection(double h, Teuchos::RCP<const TreeVector> res,
     }
   }
 
+  // globalize with a line search on the residual norm
+  bool line_searched = false;
+  if (line_search_ != Teuchos::null) {
+    line_searched = line_search_->ModifyCorrection(*this, S_inter_->time(), S_next_->time(),
+            res, u, du);
+  }
+
   if (n_limited_spurt > 0) {
     return AmanziSolvers::FnBaseDefs::CORRECTION_MODIFIED_LAG_BACKTRACKING;
-  } else if (n_limited_change > 0) {
+  } else if (n_limited_change > 0 || line_searched) {
     return AmanziSolvers::FnBaseDefs::CORRECTION_MODIFIED;
   }
 
@@ -1,4 +1,8 @@
+#include <cmath>
+
 #include "EpetraExt_RowMatrixOut.h"
+#include "CompositeVectorSpace.hh"
+#include "Tensor.hh"
 #include "richards_steadystate.hh"
 
 namespace Amanzi {
@@ -13,11 +17,176 @@ namespace Flow {
                                            const Teuchos::RCP<State>& S,
                                            const Teuchos::RCP<TreeVector>& solution) :
     PK(pk_tree, glist, S, solution),
-    Richards(pk_tree, glist, S, solution) {}
+    Richards(pk_tree, glist, S, solution),
+    ptc_(false),
+    ptc_newton_(false),
+    ptc_converged_(false),
+    res_norm0_(-1.),
+    res_norm_prev_(-1.) {}
 
 void RichardsSteadyState::Setup(const Teuchos::Ptr<State>& S) {
   max_iters_ = plist_->sublist("time integrator").get<int>("max iterations", 10);
   Richards::Setup(S);
+
+  // pseudo-transient continuation
+  ptc_ = plist_->isSublist("pseudo-transient continuation");
+  if (ptc_) {
+    Teuchos::ParameterList& ptc_list = plist_->sublist("pseudo-transient continuation");
+    ptc_cfl_ = ptc_list.get<double>("initial CFL", 1.0);
+    ptc_cfl_max_ = ptc_list.get<double>("max CFL", 1.e12);
+    ptc_ser_exponent_ = ptc_list.get<double>("SER exponent", 1.0);
+    ptc_cfl_reduction_ = ptc_list.get<double>("CFL reduction on failure", 0.5);
+    ptc_local_ = ptc_list.get<bool>("local pseudo time step", true);
+    ptc_ss_rtol_ = ptc_list.get<double>("steady state relative tolerance", 1.e-6);
+    ptc_ss_atol_ = ptc_list.get<double>("steady state absolute tolerance", 0.0);
+    ptc_newton_rtol_ = ptc_list.get<double>("switch to Newton relative residual", -1.0);
+
+    CompositeVectorSpace cvs;
+    cvs.SetMesh(mesh_)->SetGhosted(false)->SetComponent("cell", AmanziMesh::CELL, 1);
+    dtau_ = Teuchos::rcp(new CompositeVector(cvs));
+
+    // the pseudo-accumulation term needs dWC/dp
+    S->RequireFieldEvaluator(conserved_key_);
+  }
+}
+
+
+// -----------------------------------------------------------------------------
+// Once at steady state, there is no more work to do.
+// -----------------------------------------------------------------------------
+double RichardsSteadyState::get_dt() {
+  if (ptc_ && ptc_converged_) return 1.e99;
+  return Richards::get_dt();
+}
+
+
+// -----------------------------------------------------------------------------
+// Advance a pseudo step, updating the CFL number via SER.
+// -----------------------------------------------------------------------------
+bool RichardsSteadyState::AdvanceStep(double t_old, double t_new, bool reinit) {
+  if (!ptc_) return Richards::AdvanceStep(t_old, t_new, reinit);
+
+  Teuchos::OSTab tab = vo_->getOSTab();
+  if (ptc_converged_) {
+    if (vo_->os_OK(Teuchos::VERB_LOW))
+      *vo_->os() << "PTC: steady state reached, nothing to do." << std::endl;
+    return false;
+  }
+
+  // monitor convergence of the steady residual
+  double res_norm = SteadyResidualNorm_(t_new);
+  if (res_norm0_ < 0.) res_norm0_ = res_norm;
+  double rel_norm = res_norm0_ > 0. ? res_norm / res_norm0_ : 0.;
+  if (rel_norm < ptc_ss_rtol_ || res_norm < ptc_ss_atol_) {
+    ptc_converged_ = true;
+    if (vo_->os_OK(Teuchos::VERB_LOW))
+      *vo_->os() << "PTC: steady state reached, |F| = " << res_norm
+                 << " (relative " << rel_norm << ")" << std::endl;
+    return false;
+  }
+
+  // switched evolution relaxation
+  if (res_norm_prev_ > 0. && res_norm > 0.) {
+    ptc_cfl_ *= std::pow(res_norm_prev_ / res_norm, ptc_ser_exponent_);
+    ptc_cfl_ = std::min(ptc_cfl_, ptc_cfl_max_);
+  }
+  res_norm_prev_ = res_norm;
+  ptc_newton_ = rel_norm < ptc_newton_rtol_;
+
+  if (vo_->os_OK(Teuchos::VERB_MEDIUM))
+    *vo_->os() << "PTC: |F| = " << res_norm << " (relative " << rel_norm
+               << "), CFL = " << ptc_cfl_
+               << (ptc_newton_ ? ", steady Newton" : "") << std::endl;
+
+  if (!ptc_newton_) UpdatePseudoTimeStep_(t_new - t_old);
+  bool fail = Richards::AdvanceStep(t_old, t_new, reinit);
+
+  if (fail) {
+    // back off, and do not try steady Newton again at this residual
+    ptc_cfl_ *= ptc_cfl_reduction_;
+    if (ptc_newton_) ptc_newton_rtol_ = 0.1 * rel_norm;
+    ptc_newton_ = false;
+  }
+  return fail;
+}
+
+
+// -----------------------------------------------------------------------------
+// Inf-norm of the steady residual at the current iterate.
+// -----------------------------------------------------------------------------
+double RichardsSteadyState::SteadyResidualNorm_(double t) {
+  bc_pressure_->Compute(t);
+  bc_flux_->Compute(t);
+  UpdateBoundaryConditions_(S_next_.ptr());
+
+  CompositeVector res(S_next_->GetFieldData(key_)->Map());
+  res.PutScalar(0.);
+  ApplyDiffusion_(S_next_.ptr(), res.ptr());
+
+  double norm(0.);
+  res.NormInf(&norm);
+  return norm;
+}
+
+
+// -----------------------------------------------------------------------------
+// Local, CFL-like pseudo time step, fixed over a pseudo step.
+// -----------------------------------------------------------------------------
+void RichardsSteadyState::UpdatePseudoTimeStep_(double h) {
+  Epetra_MultiVector& dtau = *dtau_->ViewComponent("cell",false);
+  if (!ptc_local_) {
+    dtau.PutScalar(ptc_cfl_ * h);
+    return;
+  }
+
+  S_next_->GetFieldEvaluator(conserved_key_)
+      ->HasFieldDerivativeChanged(S_next_.ptr(), name_, key_);
+  const Epetra_MultiVector& dwc_dp = *S_next_->GetFieldData(Keys::getDerivKey(conserved_key_, key_))
+      ->ViewComponent("cell",false);
+
+  UpdatePermeabilityData_(S_next_.ptr());
+  Teuchos::RCP<const CompositeVector> uw_kr = S_next_->GetFieldData(uw_coef_key_);
+  bool kr_on_faces = uw_kr->HasComponent("face");
+  const Epetra_MultiVector& kr = *uw_kr->ViewComponent(kr_on_faces ? "face" : "cell", true);
+
+  // estimate the diagonal of the diffusion operator as sum_f kr K |f| / d_cf
+  AmanziMesh::Entity_ID_List faces;
+  unsigned int ncells = dtau.MyLength();
+  for (unsigned int c=0; c!=ncells; ++c) {
+    const WhetStone::Tensor& Kc = (*K_)[c];
+    double Kbar = Kc.rank() == 1 ? Kc(0,0) : Kc.Trace() / Kc.dimension();
+    const AmanziGeometry::Point& xc = mesh_->cell_centroid(c);
+
+    mesh_->cell_get_faces(c, &faces);
+    double diag = 0.;
+    for (auto f : faces) {
+      double dist = AmanziGeometry::norm(mesh_->face_centroid(f) - xc);
+      double kr_f = kr_on_faces ? kr[0][f] : kr[0][c];
+      diag += kr_f * Kbar * mesh_->face_area(f) / dist;
+    }
+    dtau[0][c] = diag > 0. ? ptc_cfl_ * std::max(dwc_dp[0][c], 1.e-12) / diag : ptc_cfl_ * h;
+  }
+}
+
+
+// -----------------------------------------------------------------------------
+// Pseudo-accumulation, (WC - WC_old) / dtau
+// -----------------------------------------------------------------------------
+void RichardsSteadyState::AddPseudoAccumulation_(const Teuchos::Ptr<CompositeVector>& g) {
+  S_next_->GetFieldEvaluator(conserved_key_)->HasFieldChanged(S_next_.ptr(), name_);
+  S_inter_->GetFieldEvaluator(conserved_key_)->HasFieldChanged(S_inter_.ptr(), name_);
+
+  const Epetra_MultiVector& wc1 = *S_next_->GetFieldData(conserved_key_)->ViewComponent("cell",false);
+  const Epetra_MultiVector& wc0 = *S_inter_->GetFieldData(conserved_key_)->ViewComponent("cell",false);
+  const Epetra_MultiVector& dtau = *dtau_->ViewComponent("cell",false);
+  Epetra_MultiVector& g_c = *g->ViewComponent("cell",false);
+
+  unsigned int ncells = g_c.MyLength();
+  for (unsigned int c=0; c!=ncells; ++c) {
+    g_c[0][c] += (wc1[0][c] - wc0[0][c]) / dtau[0][c];
+  }
+
+  db_->WriteVector("res (ptc acc)", g, true);
 }
 
 // -----------------------------------------------------------------------------
@@ -42,6 +211,13 @@ void RichardsSteadyState::UpdatePreconditioner(double t, Teuchos::RCP<const Tree
   // update the rel perm according to the scheme of choice
   UpdatePermeabilityData_(S_next_.ptr());
 
+  // pseudo-accumulation contributes to the diagonal, while the steady Newton
+  // solve includes the Newton correction if one is requested.
+  bool pseudo_acc = ptc_ && !ptc_newton_;
+  bool newton = ptc_ && ptc_newton_ && jacobian_;
+  if (ptc_) preconditioner_->Init();
+  if (newton) UpdatePermeabilityDerivativeData_(S_next_.ptr());
+
   // Create the preconditioner
   Teuchos::RCP<const CompositeVector> rel_perm =
       S_next_->GetFieldData(uw_coef_key_);
@@ -50,15 +226,48 @@ void RichardsSteadyState::UpdatePreconditioner(double t, Teuchos::RCP<const Tree
   Teuchos::RCP<const CompositeVector> rho = S_next_->GetFieldData(mass_dens_key_);
   preconditioner_diff_->SetDensity(rho);
 
-  preconditioner_diff_->SetScalarCoefficient(rel_perm, Teuchos::null);
+  Teuchos::RCP<const CompositeVector> dkrdp = Teuchos::null;
+  if (newton) {
+    dkrdp = duw_coef_key_.empty() ? S_next_->GetFieldData(dcoef_key_)
+        : S_next_->GetFieldData(duw_coef_key_);
+  }
+
+  preconditioner_diff_->SetScalarCoefficient(rel_perm, dkrdp);
   preconditioner_diff_->UpdateMatrices(Teuchos::null, pres.ptr());
+  if (newton) {
+    Teuchos::RCP<CompositeVector> flux = S_next_->GetFieldData(flux_key_, name_);
+    preconditioner_diff_->UpdateFlux(pres.ptr(), flux.ptr());
+    preconditioner_diff_->UpdateMatricesNewtonCorrection(flux.ptr(), pres.ptr());
+  }
 
   // Assemble and precompute the Schur complement for inversion.
   preconditioner_diff_->ApplyBCs(true, true, true);
 
+  if (pseudo_acc) {
+    S_next_->GetFieldEvaluator(conserved_key_)
+        ->HasFieldDerivativeChanged(S_next_.ptr(), name_, key_);
+    const Epetra_MultiVector& dwc_dp = *S_next_->GetFieldData(Keys::getDerivKey(conserved_key_, key_))
+        ->ViewComponent("cell",false);
+    const Epetra_MultiVector& dtau = *dtau_->ViewComponent("cell",false);
+
+    CompositeVector acc(*dtau_);
+    Epetra_MultiVector& acc_c = *acc.ViewComponent("cell",false);
+    unsigned int ncells = acc_c.MyLength();
+    for (unsigned int c=0; c!=ncells; ++c) {
+      acc_c[0][c] = dwc_dp[0][c] / dtau[0][c];
+    }
+    preconditioner_acc_->AddAccumulationTerm(acc, "cell");
+  }
+
   if (precon_used_) {
     preconditioner_->AssembleMatrix();
-    preconditioner_->UpdatePreconditioner();
+    if (column_pc_ != Teuchos::null) {
+      column_pc_->Update(preconditioner_->A());
+    } else if (single_pc_ != Teuchos::null) {
+      single_pc_->Update(preconditioner_->A());
+    } else {
+      preconditioner_->UpdatePreconditioner();
+    }
   }      
   
   
@@ -152,8 +361,6 @@ void RichardsSteadyState::FunctionalResidual(double t_old, double t_new, Teuchos
   Solution_to_State(*u_new, S_next_);
   Teuchos::RCP<CompositeVector> u = u_new->Data();
 
-  if (dynamic_mesh_) matrix_diff_->SetTensorCoefficient(K_);
-
 #if DEBUG_FLAG
   if (vo_->os_OK(Teuchos::VERB_HIGH))
     *vo_->os() << "----------------------------------------------------------------" << std::endl
@@ -184,6 +391,9 @@ void RichardsSteadyState::FunctionalResidual(double t_old, double t_new, Teuchos
   // evaulate water content, because otherwise it is never done.
   S_next_->GetFieldEvaluator(conserved_key_)->HasFieldChanged(S_next_.ptr(), name_);
 
+  // pseudo-transient continuation term
+  if (ptc_ && !ptc_newton_) AddPseudoAccumulation_(res.ptr());
+
 #if DEBUG_FLAG
   // dump s_old, s_new
   vnames[0] = "sl_old"; vnames[1] = "sl_new";
@@ -11,13 +11,53 @@
 
 This is the same as Richards equation, but turns off the accumulation term.
 
+Optionally, pseudo-transient continuation (PTC) may be used to march to
+steady state.  A pseudo-accumulation term :math:`(\Theta - \Theta^n) /
+\Delta \tau_c` is added, where the local pseudo time step is CFL-like,
+:math:`\Delta \tau_c = CFL \frac{\partial \Theta}{\partial p} / D_c`, and
+:math:`D_c` is an estimate of the diagonal of the diffusion operator in cell
+c.  The CFL number is grown by switched evolution relaxation (SER), :math:`CFL^{n+1} =
+CFL^n (|F^{n-1}| / |F^n|)^{\alpha}`, based on the steady residual
+:math:`F`.  Once the steady residual has been reduced sufficiently, the
+pseudo-accumulation term is dropped and Newton is applied directly to the
+steady problem.  When the steady residual is converged, the PK stops doing
+work and requests a very large time step.
+
 .. _richards-steadystate-spec:
 .. admonition:: richards-steadystate-spec
 
+    * `"pseudo-transient continuation`" ``[ptc-spec]`` **optional** If
+      provided, use PTC.
+
     INCLUDES:
 
     - ``[richards-spec]`` See `Richards PK`_
   
+.. _ptc-spec:
+.. admonition:: ptc-spec
+
+    * `"initial CFL`" ``[double]`` **1.0** Initial CFL number.
+
+    * `"max CFL`" ``[double]`` **1.e12** Maximum CFL number.
+
+    * `"SER exponent`" ``[double]`` **1.0** Exponent :math:`\alpha` above.
+
+    * `"CFL reduction on failure`" ``[double]`` **0.5** Factor multiplying the
+      CFL number when a pseudo step fails.
+
+    * `"local pseudo time step`" ``[bool]`` **true** If false, a uniform
+      :math:`\Delta \tau = CFL * h` is used, where h is the time step size.
+
+    * `"steady state relative tolerance`" ``[double]`` **1.e-6** Converged when
+      the steady residual's inf-norm, relative to the initial one, is below this.
+
+    * `"steady state absolute tolerance`" ``[double]`` **0.0** Converged when
+      the steady residual's inf-norm is below this. ``[mol s^-1]``
+
+    * `"switch to Newton relative residual`" ``[double]`` **-1** Drop the
+      pseudo-accumulation term when the relative steady residual is below
+      this.  Negative values never switch.
+
 */
 
 #ifndef PK_FLOW_RICHARDS_STEADYSTATE_HH_
@@ -50,6 +90,12 @@ public:
   // Virtual destructor
   virtual ~RichardsSteadyState() {}
 
+  // -- Choose a time step compatible with physics.
+  virtual double get_dt();
+
+  // -- Advance from state S0 to state S1 at time S0.time + dt.
+  virtual bool AdvanceStep(double t_old, double t_new, bool reinit);
+
 protected:
   virtual void Setup(const Teuchos::Ptr<State>& S);
 
@@ -61,9 +107,31 @@ protected:
   // updates the preconditioner
   virtual void UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> up, double h);
 
+ protected:
+  // pseudo-transient continuation
+  double SteadyResidualNorm_(double t);
+  void UpdatePseudoTimeStep_(double h);
+  void AddPseudoAccumulation_(const Teuchos::Ptr<CompositeVector>& g);
+
  protected:
   int max_iters_;
 
+  // pseudo-transient continuation
+  bool ptc_;
+  bool ptc_local_;
+  bool ptc_newton_;
+  bool ptc_converged_;
+  double ptc_cfl_;
+  double ptc_cfl_max_;
+  double ptc_ser_exponent_;
+  double ptc_cfl_reduction_;
+  double ptc_ss_rtol_;
+  double ptc_ss_atol_;
+  double ptc_newton_rtol_;
+  double res_norm0_;
+  double res_norm_prev_;
+  Teuchos::RCP<CompositeVector> dtau_;
+
  private:
   // factory registration
   static RegisteredPKFactory<RichardsSteadyState> reg_;
@@ -11,6 +11,8 @@ Authors: Ethan Coon (ATS version) (ecoon@lanl.gov)
 #include "boost/math/special_functions/fpclassify.hpp"
 
 #include "Op.hh"
+#include "PreconditionerColumnLine.hh"
+#include "PreconditionerSinglePrecision.hh"
 #include "richards.hh"
 
 namespace Amanzi {
@@ -37,7 +39,7 @@ void Richards::FunctionalResidual(double t_old,
   Solution_to_State(*u_new, S_next_);
   Teuchos::RCP<CompositeVector> u = u_new->Data();
 
-  if (dynamic_mesh_) matrix_diff_->SetTensorCoefficient(K_);
+  if (untracked_deformation_) matrix_diff_->SetTensorCoefficient(K_);
 
   if (vo_->os_OK(Teuchos::VERB_HIGH))
     *vo_->os() << "----------------------------------------------------------------" << std::endl
@@ -120,7 +122,20 @@ int Richards::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u, Teuchos::RCP
   db_->WriteVector("p_res", u->Data().ptr(), true);
 
   // Apply the preconditioner
-  int ierr = lin_solver_->ApplyInverse(*u->Data(), *Pu->Data());
+  int ierr = 0;
+  if (column_pc_ != Teuchos::null) {
+    Pu->PutScalar(0.);
+    column_pc_->ApplyInverse(*u->Data()->ViewComponent("cell",false),
+                             *Pu->Data()->ViewComponent("cell",false));
+    ierr = 1;
+  } else if (single_pc_ != Teuchos::null) {
+    Pu->PutScalar(0.);
+    single_pc_->ApplyInverse(*u->Data()->ViewComponent("cell",false),
+                             *Pu->Data()->ViewComponent("cell",false));
+    ierr = 1;
+  } else {
+    ierr = lin_solver_->ApplyInverse(*u->Data(), *Pu->Data());
+  }
 
   db_->WriteVector("PC*p_res", Pu->Data().ptr(), true);
   
@@ -137,23 +152,22 @@ void Richards::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> up,
   if (vo_->os_OK(Teuchos::VERB_HIGH))
     *vo_->os() << "Precon update at t = " << t << std::endl;
 
-  // Recreate mass matrices
-  if (dynamic_mesh_) {
+  // decide whether to include the Newton correction in this update
+  bool newton = jacobian_ && newton_control_->UpdatePreconditioner(t);
+
+  // Recreate mass matrices, if the mesh may have moved
+  if (untracked_deformation_) {
     matrix_diff_->SetTensorCoefficient(K_);
     preconditioner_diff_->SetTensorCoefficient(K_);
   }
 
   // update state with the solution up.
-  if (std::abs(t - iter_counter_time_)/t > 1.e-4) {
-    iter_ = 0;
-    iter_counter_time_ = t;
-  }
   AMANZI_ASSERT(std::abs(S_next_->time() - t) <= 1.e-4*t);
   PK_PhysicalBDF_Default::Solution_to_State(*up, S_next_);
 
   // update the rel perm according to the scheme of choice, also upwind derivatives of rel perm
   UpdatePermeabilityData_(S_next_.ptr());
-  if (jacobian_ && iter_ >= jacobian_lag_) UpdatePermeabilityDerivativeData_(S_next_.ptr());
+  if (newton) UpdatePermeabilityDerivativeData_(S_next_.ptr());
 
   // update boundary conditions
   bc_pressure_->Compute(S_next_->time());
@@ -174,7 +188,7 @@ void Richards::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> up,
 
   // jacobian term
   Teuchos::RCP<const CompositeVector> dkrdp = Teuchos::null;
-  if (jacobian_ && iter_ >= jacobian_lag_) {
+  if (newton) {
     if (!duw_coef_key_.empty()) {
       dkrdp = S_next_->GetFieldData(duw_coef_key_);
     } else {
@@ -187,7 +201,7 @@ void Richards::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> up,
   preconditioner_diff_->UpdateMatrices(Teuchos::null, up->Data().ptr());
   preconditioner_diff_->ApplyBCs(true, true, true);
 
-  if (jacobian_ && iter_ >= jacobian_lag_) {// && preconditioner_->RangeMap().HasComponent("face")) {
+  if (newton) {// && preconditioner_->RangeMap().HasComponent("face")) {
     Teuchos::RCP<CompositeVector> flux = S_next_->GetFieldData(flux_key_, name_);
     preconditioner_diff_->UpdateFlux(up->Data().ptr(), flux.ptr());
     preconditioner_diff_->UpdateMatricesNewtonCorrection(flux.ptr(), up->Data().ptr());
@@ -212,11 +226,15 @@ void Richards::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> up,
   
   if (precon_used_) {
     preconditioner_->AssembleMatrix();
-    preconditioner_->UpdatePreconditioner();
+    pc_structure_->Check(name_, *preconditioner_);
+    if (column_pc_ != Teuchos::null) {
+      column_pc_->Update(preconditioner_->A());
+    } else if (single_pc_ != Teuchos::null) {
+      single_pc_->Update(preconditioner_->A());
+    } else {
+      preconditioner_->UpdatePreconditioner();
+    }
   }
-
-  // increment the iterator count
-  iter_++;
 };
 
 
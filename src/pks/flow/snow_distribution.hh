@@ -106,8 +106,9 @@ public:
   virtual void UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> up, double h);
 
   // error monitor
-  virtual double ErrorNorm(Teuchos::RCP<const TreeVector> u,
-                       Teuchos::RCP<const TreeVector> du);
+  virtual void ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
+                              Teuchos::RCP<const TreeVector> du,
+                              std::vector<double>& norms);
 
   virtual bool ModifyPredictor(double h, Teuchos::RCP<const TreeVector> u0,
           Teuchos::RCP<TreeVector> u);
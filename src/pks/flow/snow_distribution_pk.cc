@@ -129,7 +129,7 @@ void SnowDistribution::SetupSnowDistribution_(const Teuchos::Ptr<State>& S) {
   // symbolic assemble, get PC
   precon_used_ = plist_->isSublist("preconditioner");
   if (precon_used_) {
-    preconditioner_->SymbolicAssembleMatrix();
+    pc_structure_->SymbolicAssemble(name_, *preconditioner_);
     preconditioner_->InitializePreconditioner(plist_->sublist("preconditioner"));
   }
   
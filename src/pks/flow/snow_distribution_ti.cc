@@ -188,11 +188,12 @@ void SnowDistribution::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVec
 
   preconditioner_diff_->ApplyBCs(true, true, true);
   preconditioner_->AssembleMatrix();
+  if (precon_used_) pc_structure_->Check(name_, *preconditioner_);
   preconditioner_->UpdatePreconditioner();
 };
 
-double SnowDistribution::ErrorNorm(Teuchos::RCP<const TreeVector> u,
-                       Teuchos::RCP<const TreeVector> du) {
+void SnowDistribution::ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
+        Teuchos::RCP<const TreeVector> du, std::vector<double>& norms) {
   Teuchos::OSTab tab = vo_->getOSTab();
 
   Teuchos::RCP<const CompositeVector> res = du->Data();
@@ -233,9 +234,7 @@ double SnowDistribution::ErrorNorm(Teuchos::RCP<const TreeVector> u,
     *vo_->os() << "ENorm (cells) = " << err_c.value << "[" << err_c.gid << "] (" << infnorm_c << ")" << std::endl;
   }
 
-  double buf = enorm_cell;
-  MPI_Allreduce(&buf, &enorm_cell, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-  return enorm_cell;
+  norms.push_back(enorm_cell);
 };
 
 bool SnowDistribution::ModifyPredictor(double h, Teuchos::RCP<const TreeVector> u0,
@@ -0,0 +1,198 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/* -------------------------------------------------------------------------
+ATS
+
+License: see $ATS_DIR/COPYRIGHT
+Author: Ethan Coon
+
+Line search globalization of a nonlinear correction.
+------------------------------------------------------------------------- */
+
+#include <cmath>
+
+#include "errors.hh"
+#include "line_search_delegate.hh"
+
+namespace Amanzi {
+
+LineSearchDelegate::LineSearchDelegate(Teuchos::ParameterList& plist,
+        const Teuchos::RCP<VerboseObject>& vo) :
+    vo_(vo),
+    attempt_searches_(0),
+    step_searches_(0),
+    step_residuals_(0),
+    total_searches_(0),
+    total_residuals_(0),
+    total_rescued_steps_(0)
+{
+  method_ = plist.get<std::string>("method", "backtracking");
+  if (method_ != "backtracking" && method_ != "critical point") {
+    Errors::Message msg;
+    msg << "LineSearchDelegate: unknown method \"" << method_
+        << "\", valid are \"backtracking\" and \"critical point\".";
+    Exceptions::amanzi_throw(msg);
+  }
+  max_its_ = plist.get<int>("max iterations", 5);
+  c_ = plist.get<double>("sufficient decrease", 1.e-4);
+  alpha_min_ = plist.get<double>("min step length", 0.05);
+}
+
+
+// -----------------------------------------------------------------------------
+// Find a step length and scale the correction.
+// -----------------------------------------------------------------------------
+bool LineSearchDelegate::ModifyCorrection(BDFFnBase<TreeVector>& fn,
+        double t_old, double t_new,
+        Teuchos::RCP<const TreeVector> res,
+        Teuchos::RCP<const TreeVector> u,
+        Teuchos::RCP<TreeVector> du) {
+  Teuchos::OSTab tab = vo_->getOSTab();
+
+  if (u0_ == Teuchos::null) {
+    u0_ = Teuchos::rcp(new TreeVector(*u));
+    r_ = Teuchos::rcp(new TreeVector(*res));
+  } else {
+    *u0_ = *u;
+  }
+  Teuchos::RCP<TreeVector> u_nc = Teuchos::rcp_const_cast<TreeVector>(u);
+
+  double norm0(0.);
+  res->Norm2(&norm0);
+
+  // try the full step first
+  double norm1 = Residual_(fn, t_old, t_new, 1.0, *u0_, *du, u_nc, r_);
+  double alpha = 1.0;
+  if (norm1 > (1. - c_) * norm0) {
+    attempt_searches_++;
+    step_searches_++;
+    if (method_ == "backtracking") {
+      alpha = Backtracking_(fn, t_old, t_new, norm0, norm1, *u0_, *du, u_nc, r_);
+    } else {
+      alpha = CriticalPoint_(fn, t_old, t_new, *res, *u0_, *du, u_nc, r_);
+    }
+  }
+
+  // restore the iterate
+  *u_nc = *u0_;
+  fn.ChangedSolution();
+
+  if (alpha < 1.) {
+    if (vo_->os_OK(Teuchos::VERB_HIGH))
+      *vo_->os() << "Line search: |F| = " << norm0 << ", full step |F| = " << norm1
+                 << ", taking alpha = " << alpha << std::endl;
+    du->Scale(alpha);
+    return true;
+  }
+  return false;
+}
+
+
+// -----------------------------------------------------------------------------
+// Evaluate the residual norm at u0 - alpha * du.
+// -----------------------------------------------------------------------------
+double LineSearchDelegate::Residual_(BDFFnBase<TreeVector>& fn,
+        double t_old, double t_new, double alpha,
+        const TreeVector& u0, const TreeVector& du,
+        const Teuchos::RCP<TreeVector>& u,
+        const Teuchos::RCP<TreeVector>& r) {
+  *u = u0;
+  u->Update(-alpha, du, 1.0);
+  fn.ChangedSolution();
+  fn.FunctionalResidual(t_old, t_new, Teuchos::null, u, r);
+  step_residuals_++;
+
+  double norm(0.);
+  r->Norm2(&norm);
+  return norm;
+}
+
+
+// -----------------------------------------------------------------------------
+// Halve the step until the Armijo condition is met.
+// -----------------------------------------------------------------------------
+double LineSearchDelegate::Backtracking_(BDFFnBase<TreeVector>& fn,
+        double t_old, double t_new, double norm0, double norm1,
+        const TreeVector& u0, const TreeVector& du,
+        const Teuchos::RCP<TreeVector>& u,
+        const Teuchos::RCP<TreeVector>& r) {
+  double alpha = 1.0;
+  double best_alpha = 1.0;
+  double best_norm = norm1;
+  for (int i=0; i!=max_its_; ++i) {
+    if (alpha <= alpha_min_) break;
+    alpha = std::max(0.5 * alpha, alpha_min_);
+    double norm = Residual_(fn, t_old, t_new, alpha, u0, du, u, r);
+    if (norm < best_norm) {
+      best_norm = norm;
+      best_alpha = alpha;
+    }
+    if (norm <= (1. - c_ * alpha) * norm0) return alpha;
+  }
+  return best_alpha;
+}
+
+
+// -----------------------------------------------------------------------------
+// Secant iteration on the derivative of 1/2 |F|^2 along the correction.
+// -----------------------------------------------------------------------------
+double LineSearchDelegate::CriticalPoint_(BDFFnBase<TreeVector>& fn,
+        double t_old, double t_new, const TreeVector& res0,
+        const TreeVector& u0, const TreeVector& du,
+        const Teuchos::RCP<TreeVector>& u,
+        const Teuchos::RCP<TreeVector>& r) {
+  double a_prev = 0.;
+  double d_prev(0.);
+  du.Dot(res0, &d_prev);
+  d_prev = -d_prev;
+
+  // r currently holds the residual of the full step
+  double a = 1.;
+  double d(0.);
+  du.Dot(*r, &d);
+  d = -d;
+
+  for (int i=0; i!=max_its_; ++i) {
+    if (d == d_prev) break;
+    double a_new = a - d * (a - a_prev) / (d - d_prev);
+    a_new = std::min(std::max(a_new, alpha_min_), 1.);
+    if (std::abs(a_new - a) < 1.e-2) {
+      a = a_new;
+      break;
+    }
+
+    a_prev = a;
+    d_prev = d;
+    a = a_new;
+    Residual_(fn, t_old, t_new, a, u0, du, u, r);
+    du.Dot(*r, &d);
+    d = -d;
+  }
+  return a;
+}
+
+
+// -----------------------------------------------------------------------------
+// Accumulate and write statistics for the step.
+// -----------------------------------------------------------------------------
+void LineSearchDelegate::CommitStep() {
+  total_searches_ += step_searches_;
+  total_residuals_ += step_residuals_;
+  // searches in failed attempts did not rescue this step
+  if (attempt_searches_ > 0) total_rescued_steps_++;
+
+  if (vo_->os_OK(Teuchos::VERB_HIGH)) {
+    Teuchos::OSTab tab = vo_->getOSTab();
+    *vo_->os() << "Line search: " << step_searches_ << " full steps rejected, "
+               << step_residuals_ << " trial residuals (total: "
+               << total_rescued_steps_ << " steps rescued, " << total_searches_
+               << " searches, " << total_residuals_ << " trial residuals)"
+               << std::endl;
+  }
+
+  attempt_searches_ = 0;
+  step_searches_ = 0;
+  step_residuals_ = 0;
+}
+
+} // namespace
@@ -0,0 +1,134 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! Line search globalization of a nonlinear correction.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+
+/*!
+
+When clipping the correction is not enough to make progress, a line search on
+the norm of the nonlinear residual may rescue an iteration that would
+otherwise fail and force the time step to be cut.  Given an iterate u, its
+residual F(u), and a (preconditioned) correction du, this delegate finds a
+step length :math:`\alpha \in (0,1]` and scales the correction, so that the
+next iterate is :math:`u - \alpha du`.
+
+Trial residuals are evaluated by the PK in place, so only evaluators that
+depend on the primary variable are recomputed.  The full step is always tried
+first and accepted if it sufficiently decreases the residual, so in the
+common case the line search costs one residual evaluation per iteration.
+
+Two methods are available:
+
+- `"backtracking`" halves the step until the Armijo condition
+  :math:`|F(u - \alpha du)| \le (1 - c \alpha) |F(u)|` is satisfied.
+- `"critical point`" uses secant iterations to find a critical point of
+  :math:`\frac{1}{2}|F(u - \alpha du)|^2`, approximating its derivative by
+  :math:`-du \cdot F(u - \alpha du)`.
+
+Statistics on how often the full step was rejected, and on how many time
+steps succeeded after such a rejection within the successful attempt
+("rescued" steps), are written at `"high`" verbosity when each step is
+committed.
+
+.. _line-search-spec:
+.. admonition:: line-search-spec
+
+    * `"method`" ``[string]`` **backtracking** One of `"backtracking`" or
+      `"critical point`".
+
+    * `"max iterations`" ``[int]`` **5** Max number of trial residuals beyond
+      the full step.
+
+    * `"sufficient decrease`" ``[double]`` **1.e-4** Armijo parameter c.
+
+    * `"min step length`" ``[double]`` **0.05** Smallest allowed
+      :math:`\alpha`.
+
+*/
+
+#ifndef ATS_PK_LINE_SEARCH_DELEGATE_HH_
+#define ATS_PK_LINE_SEARCH_DELEGATE_HH_
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+
+#include "VerboseObject.hh"
+#include "TreeVector.hh"
+#include "BDFFnBase.hh"
+
+namespace Amanzi {
+
+class LineSearchDelegate {
+
+ public:
+  LineSearchDelegate(Teuchos::ParameterList& plist,
+                     const Teuchos::RCP<VerboseObject>& vo);
+
+  // Scales du by the step length.  Returns true if du was modified.  Note
+  // that u is assumed to be the primary variable in state -- it is modified
+  // in place to evaluate trial residuals, and restored on exit.
+  bool ModifyCorrection(BDFFnBase<TreeVector>& fn,
+                        double t_old, double t_new,
+                        Teuchos::RCP<const TreeVector> res,
+                        Teuchos::RCP<const TreeVector> u,
+                        Teuchos::RCP<TreeVector> du);
+
+  // Called at the start of each attempt at a step, i.e. of each nonlinear
+  // solve, including retries with a smaller step size.
+  void StartAttempt() { attempt_searches_ = 0; }
+
+  // Called when a step is committed.  Writes statistics.
+  void CommitStep();
+
+  // statistics
+  int num_searches() const { return total_searches_; }
+  int num_rescued_steps() const { return total_rescued_steps_; }
+
+ protected:
+  double Residual_(BDFFnBase<TreeVector>& fn, double t_old, double t_new,
+                   double alpha, const TreeVector& u0, const TreeVector& du,
+                   const Teuchos::RCP<TreeVector>& u,
+                   const Teuchos::RCP<TreeVector>& r);
+
+  double Backtracking_(BDFFnBase<TreeVector>& fn, double t_old, double t_new,
+                       double norm0, double norm1, const TreeVector& u0,
+                       const TreeVector& du, const Teuchos::RCP<TreeVector>& u,
+                       const Teuchos::RCP<TreeVector>& r);
+
+  double CriticalPoint_(BDFFnBase<TreeVector>& fn, double t_old, double t_new,
+                        const TreeVector& res0, const TreeVector& u0,
+                        const TreeVector& du, const Teuchos::RCP<TreeVector>& u,
+                        const Teuchos::RCP<TreeVector>& r);
+
+ protected:
+  Teuchos::RCP<VerboseObject> vo_;
+
+  std::string method_;
+  int max_its_;
+  double c_;
+  double alpha_min_;
+
+  // work space
+  Teuchos::RCP<TreeVector> u0_;
+  Teuchos::RCP<TreeVector> r_;
+
+  // statistics, of the current attempt, of all attempts at this step, and
+  // of all steps
+  int attempt_searches_;
+  int step_searches_;
+  int step_residuals_;
+  int total_searches_;
+  int total_residuals_;
+  int total_rescued_steps_;
+};
+
+} // namespace
+
+#endif
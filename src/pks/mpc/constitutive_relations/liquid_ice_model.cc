@@ -30,6 +30,7 @@
 #include "compressible_porosity_model.hh"
 #include "compressible_porosity_leijnse_evaluator.hh"
 #include "compressible_porosity_leijnse_model.hh"
+#include "ProfiledFieldEvaluator.hh"
 #include "liquid_ice_model.hh"
 
 namespace Amanzi {
@@ -54,56 +55,56 @@ void LiquidIceModel::InitializeModel(const Teuchos::Ptr<State>& S,
   Teuchos::RCP<FieldEvaluator> me = S->GetFieldEvaluator(Keys::getKey(domain, "saturation_ice"));
   
   Teuchos::RCP<Flow::WRMPermafrostEvaluator> wrm_me =
-      Teuchos::rcp_dynamic_cast<Flow::WRMPermafrostEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Flow::WRMPermafrostEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(wrm_me != Teuchos::null);
   wrms_ = wrm_me->get_WRMPermafrostModels();
   
   // -- liquid EOS
   me = S->GetFieldEvaluator(Keys::getKey(domain, "molar_density_liquid"));
   Teuchos::RCP<Relations::EOSEvaluator> eos_liquid_me =
-      Teuchos::rcp_dynamic_cast<Relations::EOSEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Relations::EOSEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(eos_liquid_me != Teuchos::null);
   liquid_eos_ = eos_liquid_me->get_EOS();
 
   // -- ice EOS
   me = S->GetFieldEvaluator(Keys::getKey(domain, "molar_density_ice"));
   Teuchos::RCP<Relations::EOSEvaluator> eos_ice_me =
-      Teuchos::rcp_dynamic_cast<Relations::EOSEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Relations::EOSEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(eos_ice_me != Teuchos::null);
   ice_eos_ = eos_ice_me->get_EOS();
 
   // -- capillary pressure for ice/water
   me = S->GetFieldEvaluator(Keys::getKey(domain, "capillary_pressure_liq_ice"));
   Teuchos::RCP<Flow::PCIceEvaluator> pc_ice_me =
-    Teuchos::rcp_dynamic_cast<Flow::PCIceEvaluator>(me);
+    Teuchos::rcp_dynamic_cast<Flow::PCIceEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(pc_ice_me != Teuchos::null);
   pc_i_ = pc_ice_me->get_PCIceWater();
 
   // -- capillary pressure for liq/gas
   me = S->GetFieldEvaluator(Keys::getKey(domain, "capillary_pressure_gas_liq"));
   Teuchos::RCP<Flow::PCLiquidEvaluator> pc_liq_me =
-    Teuchos::rcp_dynamic_cast<Flow::PCLiquidEvaluator>(me);
+    Teuchos::rcp_dynamic_cast<Flow::PCLiquidEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(pc_liq_me != Teuchos::null);
   pc_l_ = pc_liq_me->get_PCLiqAtm();
   
   // -- iem for liquid
   me = S->GetFieldEvaluator(Keys::getKey(domain, "internal_energy_liquid"));
   Teuchos::RCP<Energy::IEMEvaluator> iem_liquid_me =
-      Teuchos::rcp_dynamic_cast<Energy::IEMEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Energy::IEMEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(iem_liquid_me != Teuchos::null);
   liquid_iem_ = iem_liquid_me->get_IEM();
 
   // -- iem for ice
   me = S->GetFieldEvaluator(Keys::getKey(domain, "internal_energy_ice"));
   Teuchos::RCP<Energy::IEMEvaluator> iem_ice_me =
-      Teuchos::rcp_dynamic_cast<Energy::IEMEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Energy::IEMEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(iem_ice_me != Teuchos::null);
   ice_iem_ = iem_ice_me->get_IEM();
 
   // -- iem for rock
   me = S->GetFieldEvaluator(Keys::getKey(domain, "internal_energy_rock"));
   Teuchos::RCP<Energy::IEMEvaluator> iem_rock_me =
-      Teuchos::rcp_dynamic_cast<Energy::IEMEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Energy::IEMEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(iem_rock_me != Teuchos::null);
   rock_iem_ = iem_rock_me->get_IEM();
 
@@ -113,13 +114,13 @@ void LiquidIceModel::InitializeModel(const Teuchos::Ptr<State>& S,
   me = S->GetFieldEvaluator(Keys::getKey(domain, "porosity"));
   if(!poro_leij_){
     Teuchos::RCP<Flow::CompressiblePorosityEvaluator> poro_me =
-      Teuchos::rcp_dynamic_cast<Flow::CompressiblePorosityEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Flow::CompressiblePorosityEvaluator>(Relations::get_wrapped(me));
     AMANZI_ASSERT(poro_me != Teuchos::null);
     poro_models_ = poro_me->get_Models();
   }
   else{
     Teuchos::RCP<Flow::CompressiblePorosityLeijnseEvaluator> poro_me =
-      Teuchos::rcp_dynamic_cast<Flow::CompressiblePorosityLeijnseEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Flow::CompressiblePorosityLeijnseEvaluator>(Relations::get_wrapped(me));
     AMANZI_ASSERT(poro_me != Teuchos::null);
     poro_leij_models_ = poro_me->get_Models();
   }
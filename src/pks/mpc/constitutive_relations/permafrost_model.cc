@@ -32,6 +32,7 @@
 #include "compressible_porosity_model.hh"
 #include "compressible_porosity_leijnse_evaluator.hh"
 #include "compressible_porosity_leijnse_model.hh"
+#include "ProfiledFieldEvaluator.hh"
 #include "permafrost_model.hh"
 
 namespace Amanzi {
@@ -59,77 +60,77 @@ void PermafrostModel::InitializeModel(const Teuchos::Ptr<State>& S,
   Teuchos::RCP<FieldEvaluator> me = S->GetFieldEvaluator(Keys::getKey(domain, "saturation_gas"));
   
   Teuchos::RCP<Flow::WRMPermafrostEvaluator> wrm_me =
-      Teuchos::rcp_dynamic_cast<Flow::WRMPermafrostEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Flow::WRMPermafrostEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(wrm_me != Teuchos::null);
   wrms_ = wrm_me->get_WRMPermafrostModels();
   
   // -- liquid EOS
   me = S->GetFieldEvaluator(Keys::getKey(domain, "molar_density_liquid"));
   Teuchos::RCP<Relations::EOSEvaluator> eos_liquid_me =
-      Teuchos::rcp_dynamic_cast<Relations::EOSEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Relations::EOSEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(eos_liquid_me != Teuchos::null);
   liquid_eos_ = eos_liquid_me->get_EOS();
 
   // -- ice EOS
   me = S->GetFieldEvaluator(Keys::getKey(domain, "molar_density_ice"));
   Teuchos::RCP<Relations::EOSEvaluator> eos_ice_me =
-      Teuchos::rcp_dynamic_cast<Relations::EOSEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Relations::EOSEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(eos_ice_me != Teuchos::null);
   ice_eos_ = eos_ice_me->get_EOS();
 
   // -- gas EOS
   me = S->GetFieldEvaluator(Keys::getKey(domain, "molar_density_gas"));
   Teuchos::RCP<Relations::EOSEvaluator> eos_gas_me =
-      Teuchos::rcp_dynamic_cast<Relations::EOSEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Relations::EOSEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(eos_gas_me != Teuchos::null);
   gas_eos_ = eos_gas_me->get_EOS();
 
   // -- gas vapor pressure
   me = S->GetFieldEvaluator(Keys::getKey(domain, "mol_frac_gas"));
   Teuchos::RCP<Relations::MolarFractionGasEvaluator> mol_frac_me =
-    Teuchos::rcp_dynamic_cast<Relations::MolarFractionGasEvaluator>(me);
+    Teuchos::rcp_dynamic_cast<Relations::MolarFractionGasEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(mol_frac_me != Teuchos::null);
   vpr_ = mol_frac_me->get_VaporPressureRelation();
 
   // -- capillary pressure for ice/water
   me = S->GetFieldEvaluator(Keys::getKey(domain, "capillary_pressure_liq_ice"));
   Teuchos::RCP<Flow::PCIceEvaluator> pc_ice_me =
-    Teuchos::rcp_dynamic_cast<Flow::PCIceEvaluator>(me);
+    Teuchos::rcp_dynamic_cast<Flow::PCIceEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(pc_ice_me != Teuchos::null);
   pc_i_ = pc_ice_me->get_PCIceWater();
 
   // -- capillary pressure for liq/gas
   me = S->GetFieldEvaluator(Keys::getKey(domain, "capillary_pressure_gas_liq"));
   Teuchos::RCP<Flow::PCLiquidEvaluator> pc_liq_me =
-    Teuchos::rcp_dynamic_cast<Flow::PCLiquidEvaluator>(me);
+    Teuchos::rcp_dynamic_cast<Flow::PCLiquidEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(pc_liq_me != Teuchos::null);
   pc_l_ = pc_liq_me->get_PCLiqAtm();
   
   // -- iem for liquid
   me = S->GetFieldEvaluator(Keys::getKey(domain, "internal_energy_liquid"));
   Teuchos::RCP<Energy::IEMEvaluator> iem_liquid_me =
-      Teuchos::rcp_dynamic_cast<Energy::IEMEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Energy::IEMEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(iem_liquid_me != Teuchos::null);
   liquid_iem_ = iem_liquid_me->get_IEM();
 
   // -- iem for ice
   me = S->GetFieldEvaluator(Keys::getKey(domain, "internal_energy_ice"));
   Teuchos::RCP<Energy::IEMEvaluator> iem_ice_me =
-      Teuchos::rcp_dynamic_cast<Energy::IEMEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Energy::IEMEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(iem_ice_me != Teuchos::null);
   ice_iem_ = iem_ice_me->get_IEM();
 
   // -- iem for gas
   me = S->GetFieldEvaluator(Keys::getKey(domain, "internal_energy_gas"));
   Teuchos::RCP<Energy::IEMWaterVaporEvaluator> iem_gas_me =
-      Teuchos::rcp_dynamic_cast<Energy::IEMWaterVaporEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Energy::IEMWaterVaporEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(iem_gas_me != Teuchos::null);
   gas_iem_ = iem_gas_me->get_IEM();
 
   // -- iem for rock
   me = S->GetFieldEvaluator(Keys::getKey(domain, "internal_energy_rock"));
   Teuchos::RCP<Energy::IEMEvaluator> iem_rock_me =
-      Teuchos::rcp_dynamic_cast<Energy::IEMEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Energy::IEMEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(iem_rock_me != Teuchos::null);
   rock_iem_ = iem_rock_me->get_IEM();
 
@@ -139,13 +140,13 @@ void PermafrostModel::InitializeModel(const Teuchos::Ptr<State>& S,
   me = S->GetFieldEvaluator(Keys::getKey(domain, "porosity"));
   if(!poro_leij_){
     Teuchos::RCP<Flow::CompressiblePorosityEvaluator> poro_me =
-      Teuchos::rcp_dynamic_cast<Flow::CompressiblePorosityEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Flow::CompressiblePorosityEvaluator>(Relations::get_wrapped(me));
     AMANZI_ASSERT(poro_me != Teuchos::null);
     poro_models_ = poro_me->get_Models();
   }
   else{
     Teuchos::RCP<Flow::CompressiblePorosityLeijnseEvaluator> poro_me =
-      Teuchos::rcp_dynamic_cast<Flow::CompressiblePorosityLeijnseEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Flow::CompressiblePorosityLeijnseEvaluator>(Relations::get_wrapped(me));
     AMANZI_ASSERT(poro_me != Teuchos::null);
     poro_leij_models_ = poro_me->get_Models();
   }
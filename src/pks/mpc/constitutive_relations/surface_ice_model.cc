@@ -19,6 +19,7 @@
 #include "unfrozen_fraction_model.hh"
 #include "icy_height_evaluator.hh"
 #include "icy_height_model.hh"
+#include "ProfiledFieldEvaluator.hh"
 
 #include "surface_ice_model.hh"
 
@@ -36,42 +37,42 @@ SurfaceIceModel::InitializeModel(const Teuchos::Ptr<State>& S, Teuchos::Paramete
   // -- liquid EOS
   Teuchos::RCP<FieldEvaluator> me = S->GetFieldEvaluator("surface_molar_density_liquid");
   Teuchos::RCP<Relations::EOSEvaluator> eos_liquid_me =
-      Teuchos::rcp_dynamic_cast<Relations::EOSEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Relations::EOSEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(eos_liquid_me != Teuchos::null);
   liquid_eos_ = eos_liquid_me->get_EOS();
 
   // -- ice EOS
   me = S->GetFieldEvaluator("surface_molar_density_ice");
   Teuchos::RCP<Relations::EOSEvaluator> eos_ice_me =
-      Teuchos::rcp_dynamic_cast<Relations::EOSEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Relations::EOSEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(eos_ice_me != Teuchos::null);
   ice_eos_ = eos_ice_me->get_EOS();
 
   // -- iem for liquid
   me = S->GetFieldEvaluator("surface_internal_energy_liquid");
   Teuchos::RCP<Energy::IEMEvaluator> iem_liquid_me =
-      Teuchos::rcp_dynamic_cast<Energy::IEMEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Energy::IEMEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(iem_liquid_me != Teuchos::null);
   liquid_iem_ = iem_liquid_me->get_IEM();
 
   // -- iem for ice
   me = S->GetFieldEvaluator("surface_internal_energy_ice");
   Teuchos::RCP<Energy::IEMEvaluator> iem_ice_me =
-      Teuchos::rcp_dynamic_cast<Energy::IEMEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Energy::IEMEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(iem_ice_me != Teuchos::null);
   ice_iem_ = iem_ice_me->get_IEM();
 
   // -- ponded depth evaluator
   me = S->GetFieldEvaluator("ponded_depth");
   Teuchos::RCP<Flow::IcyHeightEvaluator> icy_h_me =
-      Teuchos::rcp_dynamic_cast<Flow::IcyHeightEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Flow::IcyHeightEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(icy_h_me != Teuchos::null);
   pd_ = icy_h_me->get_IcyModel();
 
   // -- unfrozen fraction evaluator
   me = S->GetFieldEvaluator("unfrozen_fraction");
   Teuchos::RCP<Flow::UnfrozenFractionEvaluator> uf_me =
-      Teuchos::rcp_dynamic_cast<Flow::UnfrozenFractionEvaluator>(me);
+      Teuchos::rcp_dynamic_cast<Flow::UnfrozenFractionEvaluator>(Relations::get_wrapped(me));
   AMANZI_ASSERT(uf_me != Teuchos::null);
   uf_ = uf_me->get_Model();
   
@@ -101,7 +101,7 @@ void MPCCoupledCells::Setup(const Teuchos::Ptr<State>& S) {
   // setup and initialize the preconditioner
   precon_used_ = plist_->isSublist("preconditioner");
   if (precon_used_) {
-    preconditioner_->SymbolicAssembleMatrix();
+    pc_structure_->SymbolicAssemble(name_, *preconditioner_);
     Teuchos::ParameterList& pc_sublist = plist_->sublist("preconditioner");
     preconditioner_->InitializePreconditioner(pc_sublist);
   }
@@ -150,6 +150,7 @@ void MPCCoupledCells::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVect
 
   if (precon_used_) {
     preconditioner_->AssembleMatrix();
+    pc_structure_->Check(name_, *preconditioner_);
     preconditioner_->UpdatePreconditioner();
   }
 }
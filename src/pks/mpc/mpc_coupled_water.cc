@@ -1,4 +1,7 @@
+#include <cmath>
+
 #include "Teuchos_XMLParameterListHelpers.hpp"
+#include "Teuchos_TimeMonitor.hpp"
 #include "EpetraExt_RowMatrixOut.h"
 
 #include "LinearOperatorFactory.hh"
@@ -13,7 +16,21 @@ MPCCoupledWater::MPCCoupledWater(Teuchos::ParameterList& FElist,
                   const Teuchos::RCP<State>& S,
                   const Teuchos::RCP<TreeVector>& soln) :
     PK(FElist, plist,  S, soln),
-    StrongMPC<PK_PhysicalBDF_Default>(FElist, plist,  S, soln) {}
+    StrongMPC<PK_PhysicalBDF_Default>(FElist, plist,  S, soln),
+    updates_since_setup_(0),
+    setup_time_(-1.e99),
+    step_setups_(0),
+    step_updates_(0),
+    total_setups_(0),
+    total_updates_(0)
+{
+  setup_lag_ = plist_->get<int>("preconditioner setup lag", 0);
+  setup_each_step_ = plist_->get<bool>("rebuild preconditioner each step", true);
+
+  assemble_timer_ = Teuchos::TimeMonitor::getNewCounter(name_+" PC assemble");
+  setup_timer_ = Teuchos::TimeMonitor::getNewCounter(name_+" PC setup");
+  solve_timer_ = Teuchos::TimeMonitor::getNewCounter(name_+" PC solve");
+}
 
 
 
@@ -61,7 +78,7 @@ MPCCoupledWater::Setup(const Teuchos::Ptr<State>& S) {
   }
 
   // -- must re-symbolic assemble subsurf operators, now that they have a surface operator
-  precon_->SymbolicAssembleMatrix();
+  pc_structure_->SymbolicAssemble(name_, *precon_);
   precon_->InitializePreconditioner(plist_->sublist("preconditioner"));
 
 
@@ -152,7 +169,11 @@ int MPCCoupledWater::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u,
   // call the precon's inverse
   if (vo_->os_OK(Teuchos::VERB_EXTREME))
     *vo_->os() << "Precon applying subsurface operator." << std::endl;
-  int ierr = lin_solver_->ApplyInverse(*u->SubVector(0)->Data(), *Pu->SubVector(0)->Data());
+  int ierr = 0;
+  {
+    Teuchos::TimeMonitor monitor(*solve_timer_);
+    ierr = lin_solver_->ApplyInverse(*u->SubVector(0)->Data(), *Pu->SubVector(0)->Data());
+  }
 
   if (vo_->os_OK(Teuchos::VERB_EXTREME))
     *vo_->os() << "Precon applying  CopySubsurfaceToSurface." << std::endl;
@@ -198,10 +219,47 @@ MPCCoupledWater::UpdatePreconditioner(double t,
   // doing the subsurface 2nd re-inits the surface matrices (and doesn't
   // refill them).  This is why subsurface is first
   StrongMPC<PK_PhysicalBDF_Default>::UpdatePreconditioner(t, up, h);
-  
-  precon_->AssembleMatrix();
-  precon_->UpdatePreconditioner();
-  
+
+  {
+    Teuchos::TimeMonitor monitor(*assemble_timer_);
+    precon_->AssembleMatrix();
+    pc_structure_->Check(name_, *precon_);
+  }
+
+  // a change in time means a new step (or a retry with a smaller dt)
+  bool new_step = std::abs(t - setup_time_) > 1.e-4 * std::max(std::abs(t), 1.);
+  step_updates_++;
+  if ((new_step && setup_each_step_) || step_setups_ + total_setups_ == 0 ||
+      updates_since_setup_ >= setup_lag_) {
+    Teuchos::TimeMonitor monitor(*setup_timer_);
+    precon_->UpdatePreconditioner();
+    updates_since_setup_ = 0;
+    step_setups_++;
+  } else {
+    updates_since_setup_++;
+    if (vo_->os_OK(Teuchos::VERB_EXTREME))
+      *vo_->os() << "Precon reassembled, reusing the preconditioner setup." << std::endl;
+  }
+  setup_time_ = t;
+}
+
+
+void
+MPCCoupledWater::CommitStep(double t_old, double t_new, const Teuchos::RCP<State>& S) {
+  StrongMPC<PK_PhysicalBDF_Default>::CommitStep(t_old, t_new, S);
+
+  total_setups_ += step_setups_;
+  total_updates_ += step_updates_;
+  if (vo_->os_OK(Teuchos::VERB_HIGH)) {
+    Teuchos::OSTab tab = vo_->getOSTab();
+    *vo_->os() << "Precon: " << step_setups_ << " setups in " << step_updates_
+               << " updates (total: " << total_setups_ << " in " << total_updates_
+               << "), time assemble = " << assemble_timer_->totalElapsedTime()
+               << ", setup = " << setup_timer_->totalElapsedTime()
+               << ", solve = " << solve_timer_->totalElapsedTime() << std::endl;
+  }
+  step_setups_ = 0;
+  step_updates_ = 0;
 }
 
 // -- Modify the predictor.
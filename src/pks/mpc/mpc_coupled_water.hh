@@ -16,6 +16,18 @@ are co-located with the surface cell pressure, and therefore are equivalent.
 In this approach (described in detail in a paper that is in review), the
 surface equations are directly assembled into the subsurface discrete operator.
 
+Because of this, the integrated hydrology system is a single assembled matrix
+with the surface degrees of freedom included, and the `"preconditioner`"
+(e.g. AMG) is built once on that matrix.  Building the preconditioner is
+often the most expensive part of a linear solve, so its setup may be lagged:
+the matrix is reassembled on every preconditioner update, and is always what
+the `"linear solver`" iterates on, but the preconditioner itself is only
+rebuilt every `"preconditioner setup lag`" + 1 updates, and on the first
+update of each time step if `"rebuild preconditioner each step`" is set.
+Time spent assembling, building, and applying the preconditioner is timed
+separately, written at `"high`" verbosity when each step is committed, and
+included in the timing summary at the end of the run.
+
 .. _mpc-coupled-water-spec:
 .. admonition:: mpc-coupled-water-spec
 
@@ -30,6 +42,12 @@ surface equations are directly assembled into the subsurface discrete operator.
    * `"water delegate`" ``[coupled-water-delegate-spec]`` A `Coupled Water
      Globalization Delegate`_ spec.
 
+   * `"preconditioner setup lag`" ``[int]`` **0** Number of preconditioner
+     updates that reuse the previously built preconditioner.
+
+   * `"rebuild preconditioner each step`" ``[bool]`` **true** Always rebuild
+     the preconditioner on the first update of a time step.
+
    INCLUDES:
 
    - ``[strong-mpc-spec]`` *Is a* StrongMPC_
@@ -74,6 +92,9 @@ class MPCCoupledWater : public StrongMPC<PK_PhysicalBDF_Default> {
   // -- Update the preconditioner.
   virtual void UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> up, double h);
 
+  // -- Commit the step, writes preconditioner timings.
+  virtual void CommitStep(double t_old, double t_new, const Teuchos::RCP<State>& S);
+
   // -- Modify the predictor.
   virtual bool ModifyPredictor(double h, Teuchos::RCP<const TreeVector> u0,
           Teuchos::RCP<TreeVector> u);
@@ -104,6 +125,17 @@ class MPCCoupledWater : public StrongMPC<PK_PhysicalBDF_Default> {
   Teuchos::RCP<Operators::Operator> precon_surf_;
   Teuchos::RCP<Operators::Operator> lin_solver_;
 
+  // amortized preconditioner setup
+  int setup_lag_;
+  bool setup_each_step_;
+  int updates_since_setup_;
+  double setup_time_;
+  int step_setups_, step_updates_;
+  int total_setups_, total_updates_;
+  Teuchos::RCP<Teuchos::Time> assemble_timer_;
+  Teuchos::RCP<Teuchos::Time> setup_timer_;
+  Teuchos::RCP<Teuchos::Time> solve_timer_;
+
   // Water delegate
   Teuchos::RCP<MPCDelegateWater> water_;
   bool consistent_cells_;
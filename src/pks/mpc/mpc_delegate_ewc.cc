@@ -8,6 +8,9 @@ Author: Ethan Coon
 Interface for EWC, a helper class that does projections and preconditioners in
 energy/water-content space instead of temperature/pressure space.
 ------------------------------------------------------------------------- */
+#include <cmath>
+
+#include "Point.hh"
 #include "FieldEvaluator.hh"
 #include "ewc_model.hh"
 #include "mpc_delegate_ewc.hh"
@@ -20,7 +23,13 @@ namespace Amanzi {
 // Constructor
 // -----------------------------------------------------------------------------
 MPCDelegateEWC::MPCDelegateEWC(Teuchos::ParameterList& plist) :
-    plist_(Teuchos::rcpFromRef(plist)) {
+    plist_(Teuchos::rcpFromRef(plist)),
+    elim_(false),
+    elim_time_(-1.e99),
+    elim_candidates_(0),
+    elim_cells_(0),
+    elim_its_(0),
+    elim_failed_(0) {
   // set up the VerboseObject
   std::string name = plist_->get<std::string>("PK name")+std::string(" EWC");
   vo_ = Teuchos::rcp(new VerboseObject(name, *plist_));
@@ -86,9 +95,22 @@ void MPCDelegateEWC::setup(const Teuchos::Ptr<State>& S) {
     Exceptions::amanzi_throw(message);
   }
 
+  // nonlinear elimination of cells near the cusp
+  elim_ = plist_->get<bool>("nonlinear elimination", false);
+  if (elim_) {
+    elim_max_its_ = plist_->get<int>("nonlinear elimination max iterations", 10);
+    elim_rtol_ = plist_->get<double>("nonlinear elimination relative tolerance", 1.e-3);
+    elim_min_res_ = plist_->get<double>("nonlinear elimination minimum residual", 1.e-8);
+    elim_p_cap_ = plist_->get<double>("nonlinear elimination pressure correction cap [Pa]", 2.e5);
+    elim_T_cap_ = plist_->get<double>("nonlinear elimination temperature correction cap [K]", 2.0);
+    elim_eps_p_ = plist_->get<double>("nonlinear elimination pressure finite difference [Pa]", 1.e-3);
+    elim_eps_T_ = plist_->get<double>("nonlinear elimination temperature finite difference [K]", 1.e-7);
+    elim_T_min_ = plist_->get<double>("nonlinear elimination minimum temperature [K]", 200.);
+  }
+
   // Smart EWC uses a heuristic to guess when we need the EWC instead of using
-  // it blindly.
-  if (predictor_type_ == PREDICTOR_SMART_EWC || precon_type_ == PRECON_SMART_EWC) {
+  // it blindly.  Nonlinear elimination uses the same cusp.
+  if (predictor_type_ == PREDICTOR_SMART_EWC || precon_type_ == PRECON_SMART_EWC || elim_) {
     if (plist_->isParameter("freeze-thaw cusp width [K]")) {
       cusp_size_T_freezing_ = plist_->get<double>("freeze-thaw cusp width [K]");
       cusp_size_T_thawing_ = cusp_size_T_freezing_;
@@ -121,10 +143,15 @@ void MPCDelegateEWC::initialize(const Teuchos::Ptr<State>& S) {
   }
 
   // initialize the Jacobian
-  if (precon_type_ == PRECON_EWC || precon_type_ == PRECON_SMART_EWC) {
+  if (precon_type_ == PRECON_EWC || precon_type_ == PRECON_SMART_EWC || elim_) {
     int ncells = mesh_->num_entities(AmanziMesh::CELL, AmanziMesh::Parallel_type::OWNED);
     jac_.resize(ncells, WhetStone::Tensor(2,2));
   }
+  if (elim_) {
+    int ncells = mesh_->num_entities(AmanziMesh::CELL, AmanziMesh::Parallel_type::OWNED);
+    elim_diag_.resize(ncells, WhetStone::Tensor(2,2));
+    elim_valid_.resize(ncells, false);
+  }
 
   // initialize the model, which grabs all needed models from state
   model_->InitializeModel(S, *plist_);
@@ -154,6 +181,22 @@ void MPCDelegateEWC::commit_state(double dt, const Teuchos::RCP<State>& S) {
     *e_prev2_ = *S_inter_->GetFieldData(e_key_)->ViewComponent("cell",false);
     time_prev2_ = S_inter_->time();
   }
+
+  if (elim_) {
+    int local[4] = { elim_candidates_, elim_cells_, elim_its_, elim_failed_ };
+    int global[4];
+    mesh_->get_comm()->SumAll(local, global, 4);
+    if (vo_->os_OK(Teuchos::VERB_HIGH)) {
+      Teuchos::OSTab tab = vo_->getOSTab();
+      *vo_->os() << "Nonlinear elimination: " << global[1] << " of " << global[0]
+                 << " cusp cells eliminated in " << global[2] << " local iterations, "
+                 << global[3] << " local solves failed" << std::endl;
+    }
+    elim_candidates_ = 0;
+    elim_cells_ = 0;
+    elim_its_ = 0;
+    elim_failed_ = 0;
+  }
 }
 
 
@@ -237,4 +280,166 @@ void MPCDelegateEWC::update_precon_ewc_(double t, Teuchos::RCP<const TreeVector>
   }
 }
 
+
+// -----------------------------------------------------------------------------
+// Store the flux part of the cell-diagonal blocks of the preconditioner.
+// -----------------------------------------------------------------------------
+void MPCDelegateEWC::UpdateNonlinearElimination(double t, Teuchos::RCP<const TreeVector> up,
+        double h, const std::vector<WhetStone::Tensor>& diag,
+        const std::vector<bool>& valid) {
+  // the accumulation blocks at the same linearization point
+  update_precon_ewc_(t, up, h);
+
+  int ncells = elim_diag_.size();
+  for (int c=0; c!=ncells; ++c) {
+    elim_valid_[c] = valid[c];
+    for (int i=0; i!=2; ++i)
+      for (int j=0; j!=2; ++j)
+        elim_diag_[c](i,j) = diag[c](i,j) - jac_[c](i,j) / h;
+  }
+  elim_time_ = t;
+}
+
+
+// -----------------------------------------------------------------------------
+// Extensive water content and energy of a cell, from the model.
+// -----------------------------------------------------------------------------
+int MPCDelegateEWC::EvaluateAccumulation_(double cv, double p, double T,
+        double& wc, double& e) {
+  int ierr = model_->Evaluate(T, p, e, wc);
+  wc *= cv;
+  e *= cv;
+  return ierr;
+}
+
+
+// -----------------------------------------------------------------------------
+// Local (p,T) solves, with neighbors frozen, on cells near the cusp.
+// -----------------------------------------------------------------------------
+int MPCDelegateEWC::EliminateStiffCells(double t, double h, const TreeVector& g,
+        const TreeVector& u, TreeVector& du) {
+  // only valid if the blocks were computed at this iterate's time
+  if (!elim_ || std::abs(t - elim_time_) > 1.e-10 * std::max(std::abs(t), 1.)) return 0;
+
+  const Epetra_MultiVector& g_wc = *g.SubVector(0)->Data()->ViewComponent("cell",false);
+  const Epetra_MultiVector& g_e = *g.SubVector(1)->Data()->ViewComponent("cell",false);
+  const Epetra_MultiVector& pres = *u.SubVector(0)->Data()->ViewComponent("cell",false);
+  const Epetra_MultiVector& temp = *u.SubVector(1)->Data()->ViewComponent("cell",false);
+  Epetra_MultiVector& dpres = *du.SubVector(0)->Data()->ViewComponent("cell",false);
+  Epetra_MultiVector& dtemp = *du.SubVector(1)->Data()->ViewComponent("cell",false);
+  const Epetra_MultiVector& cv = *S_next_->GetFieldData(cv_key_)->ViewComponent("cell",false);
+
+  int rank = mesh_->get_comm()->MyPID();
+  int n_modified = 0;
+  int ncells = elim_diag_.size();
+  for (int c=0; c!=ncells; ++c) {
+    if (!elim_valid_[c]) continue;
+
+    double p0 = pres[0][c];
+    double T0 = temp[0][c];
+    model_->UpdateModel(S_next_.ptr(), c);
+    if (model_->Freezing(T0 - cusp_size_T_thawing_, p0)
+        == model_->Freezing(T0 + cusp_size_T_freezing_, p0)) continue;
+    elim_candidates_++;
+
+    double wc0(0.), e0(0.);
+    if (EvaluateAccumulation_(cv[0][c], p0, T0, wc0, e0)) continue;
+    double wc_scale = h / std::max(std::abs(wc0), 1.e-10);
+    double e_scale = h / std::max(std::abs(e0), 1.e-10);
+    const WhetStone::Tensor& D = elim_diag_[c];
+
+    // local residual and its norm at the current iterate
+    AmanziGeometry::Point x(2), G(2);
+    x[0] = p0; x[1] = T0;
+    G[0] = g_wc[0][c];
+    G[1] = g_e[0][c];
+    double norm0 = std::sqrt(std::pow(G[0]*wc_scale, 2) + std::pow(G[1]*e_scale, 2));
+    if (norm0 < elim_min_res_) continue;
+    double norm = norm0;
+
+    Teuchos::RCP<VerboseObject> dcvo = Teuchos::null;
+    if (vo_->os_OK(Teuchos::VERB_EXTREME))
+      dcvo = db_->GetVerboseObject(c, rank);
+    if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
+      *dcvo->os() << "Eliminating: c = " << c << ", p,T = " << p0 << ", " << T0
+                  << ", |G| = " << norm0 << std::endl;
+
+    bool converged = false;
+    int ierr = 0;
+    int its = 0;
+    while (!converged && its < elim_max_its_ && !ierr) {
+      its++;
+
+      // Jacobian: accumulation by finite differences, plus frozen fluxes
+      double wc(0.), e(0.), wc_T(0.), e_T(0.), wc_p(0.), e_p(0.);
+      ierr = EvaluateAccumulation_(cv[0][c], x[0], x[1], wc, e);
+      ierr |= EvaluateAccumulation_(cv[0][c], x[0], x[1] + elim_eps_T_, wc_T, e_T);
+      ierr |= EvaluateAccumulation_(cv[0][c], x[0] + elim_eps_p_, x[1], wc_p, e_p);
+      if (ierr) break;
+
+      WhetStone::Tensor J(2,2);
+      J(0,0) = (wc_p - wc) / elim_eps_p_ / h + D(0,0);
+      J(0,1) = (wc_T - wc) / elim_eps_T_ / h + D(0,1);
+      J(1,0) = (e_p - e) / elim_eps_p_ / h + D(1,0);
+      J(1,1) = (e_T - e) / elim_eps_T_ / h + D(1,1);
+      if (std::abs(J.Det()) < 1.e-20) {
+        ierr = 1;
+        break;
+      }
+      J.Inverse();
+      AmanziGeometry::Point correction = J * G;
+
+      // cap the correction
+      double scale = 1.;
+      if (std::abs(correction[0]) > elim_p_cap_)
+        scale = elim_p_cap_ / std::abs(correction[0]);
+      if (std::abs(correction[1]) > elim_T_cap_)
+        scale = std::min(scale, elim_T_cap_ / std::abs(correction[1]));
+      correction *= scale;
+
+      // backtrack until the local residual decreases
+      double damp = 1.;
+      double norm_new = norm;
+      AmanziGeometry::Point x_new(2), G_new(2);
+      for (int i=0; i!=6; ++i) {
+        x_new = x - damp * correction;
+        ierr = EvaluateAccumulation_(cv[0][c], x_new[0], x_new[1], wc, e);
+        if (ierr) break;
+        G_new[0] = g_wc[0][c] + (wc - wc0) / h
+            + D(0,0) * (x_new[0] - p0) + D(0,1) * (x_new[1] - T0);
+        G_new[1] = g_e[0][c] + (e - e0) / h
+            + D(1,0) * (x_new[0] - p0) + D(1,1) * (x_new[1] - T0);
+        norm_new = std::sqrt(std::pow(G_new[0]*wc_scale, 2) + std::pow(G_new[1]*e_scale, 2));
+        if (norm_new < norm) break;
+        damp *= 0.5;
+      }
+      if (ierr || norm_new >= norm) {
+        ierr = 1;
+        break;
+      }
+
+      x = x_new;
+      G = G_new;
+      norm = norm_new;
+      converged = norm < elim_rtol_ * norm0;
+    }
+    elim_its_ += its;
+
+    if (converged && x[1] > elim_T_min_) {
+      if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
+        *dcvo->os() << "   eliminated in " << its << " its: p,T = " << x[0]
+                    << ", " << x[1] << ", |G| = " << norm << std::endl;
+      dpres[0][c] = p0 - x[0];
+      dtemp[0][c] = T0 - x[1];
+      n_modified++;
+    } else {
+      if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_EXTREME))
+        *dcvo->os() << "   FAILED local solve, keeping the global correction" << std::endl;
+      elim_failed_++;
+    }
+  }
+  elim_cells_ += n_modified;
+  return n_modified;
+}
+
 } // namespace
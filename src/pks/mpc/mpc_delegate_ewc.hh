@@ -66,6 +66,40 @@ provides the initial guess to the nonlinear solve.
       over which to assume we are close to the latent heat cliff as we get
       warmer, and begins applying the EWC algorithm in `"ewc smarter`".
         
+    * `"nonlinear elimination`" ``[bool]`` **false** If true, cells near the
+      latent heat cusp (as determined by the cusp widths above) are eliminated
+      from each global Newton correction: each such cell gets a local
+      nonlinear solve in :math:`(p, T)` with all neighboring values frozen.
+      See below.
+
+    * `"nonlinear elimination max iterations`" ``[int]`` **10** Max number of
+      local Newton iterations per cell.
+
+    * `"nonlinear elimination relative tolerance`" ``[double]`` **1.e-3**
+      Reduction of the local residual required to accept the local solve.
+
+    * `"nonlinear elimination minimum residual`" ``[double]`` **1.e-8** Cells
+      whose local residual, scaled by the water content and energy of the
+      cell and multiplied by the time step, is smaller than this are left
+      alone.
+
+    * `"nonlinear elimination pressure correction cap [Pa]`" ``[double]``
+      **2.e5** Largest change in pressure of a local Newton iteration.
+
+    * `"nonlinear elimination temperature correction cap [K]`" ``[double]``
+      **2.0** Largest change in temperature of a local Newton iteration.
+
+    * `"nonlinear elimination pressure finite difference [Pa]`" ``[double]``
+      **1.e-3** Increment in pressure of the finite difference derivatives of
+      the accumulation terms.
+
+    * `"nonlinear elimination temperature finite difference [K]`" ``[double]``
+      **1.e-7** Increment in temperature of the finite difference derivatives
+      of the accumulation terms.
+
+    * `"nonlinear elimination minimum temperature [K]`" ``[double]`` **200.**
+      Local solves ending below this temperature are rejected.
+
     * `"pressure key`" ``[string]`` **DOMAIN-pressure**
     * `"temperature key`" ``[string]`` **DOMAIN-temperature**
     * `"water content key`" ``[string]`` **DOMAIN-water_content**
@@ -75,6 +109,24 @@ provides the initial guess to the nonlinear solve.
     INCLUDES
 
     - ``[debugger-spec]`` Uses a Debugger_
+
+Nonlinear elimination is a nonlinear preconditioner.  Near the cusp, a
+handful of cells may stall the global Newton iteration.  With neighbors
+frozen, the residual of cell c is approximated by:
+
+.. math::
+    G_c(x) = F_c(x^k) + \frac{1}{h}\left( A_c(x) - A_c(x^k) \right) + D_c (x - x^k)
+
+where :math:`x = (p, T)`, :math:`A = (\Theta, E)` is evaluated by the EWC
+model, and :math:`D_c` is the cell's 2x2 diagonal block of the global
+preconditioner with the accumulation terms removed, i.e. the linearized flux
+terms.  The latent heat nonlinearity is therefore treated exactly, while the
+fluxes are linearized.  On cells whose local solve converges, the correction
+of the global Newton iteration is replaced by that of the local solve.  The
+diagonal blocks are computed by the owning MPC whenever the preconditioner is
+updated; cells on a process boundary are not eliminated.  Counts of
+candidate and eliminated cells and of local iterations are written at
+`"high`" verbosity when each step is committed.
     
 */
 
@@ -110,6 +162,22 @@ class MPCDelegateEWC {
 
   void set_model(const Teuchos::RCP<EWCModel>& model) { model_ = model; }
 
+  // nonlinear elimination of stiff cells
+  bool nonlinear_elimination() const { return elim_; }
+
+  // Sets the cell-diagonal 2x2 blocks of the global preconditioner, in
+  // (water content, energy) x (p, T), computed at time t with step size h.
+  // Cells with valid[c] false are never eliminated.
+  void UpdateNonlinearElimination(double t, Teuchos::RCP<const TreeVector> up, double h,
+          const std::vector<WhetStone::Tensor>& diag, const std::vector<bool>& valid);
+
+  // Local solves on stiff cells.  g and u are the (p, T) residual and
+  // iterate at time t, and du the correction of the global iteration, which
+  // is replaced by the local correction on eliminated cells.  Returns the
+  // number of (owned) cells modified.
+  int EliminateStiffCells(double t, double h, const TreeVector& g,
+                          const TreeVector& u, TreeVector& du);
+
  protected:
   virtual bool modify_predictor_smart_ewc_(double h, Teuchos::RCP<TreeVector> up) = 0;
   virtual void precon_ewc_(Teuchos::RCP<const TreeVector> u,
@@ -117,6 +185,8 @@ class MPCDelegateEWC {
 
   virtual void update_precon_ewc_(double t, Teuchos::RCP<const TreeVector> up, double h);
 
+  int EvaluateAccumulation_(double cv, double p, double T, double& wc, double& e);
+
 
 
  protected:
@@ -154,6 +224,19 @@ class MPCDelegateEWC {
   double cusp_size_T_freezing_;
   double cusp_size_T_thawing_;
 
+  // nonlinear elimination
+  bool elim_;
+  int elim_max_its_;
+  double elim_rtol_;
+  double elim_min_res_;
+  double elim_p_cap_, elim_T_cap_;
+  double elim_eps_p_, elim_eps_T_;
+  double elim_T_min_;
+  double elim_time_;
+  std::vector<WhetStone::Tensor> elim_diag_;
+  std::vector<bool> elim_valid_;
+  int elim_candidates_, elim_cells_, elim_its_, elim_failed_;
+
   // states
   Teuchos::RCP<State> S_next_;
   Teuchos::RCP<State> S_inter_;
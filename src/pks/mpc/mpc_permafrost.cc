@@ -23,6 +23,10 @@ MPCPermafrost::MPCPermafrost(Teuchos::ParameterList& pk_tree,
                  const Teuchos::RCP<TreeVector>& solution) :
     PK(pk_tree, global_plist, S, solution),
     MPCSubsurface(pk_tree, global_plist, S, solution) {
+  // the surface blocks are added to the subsurface operator before its
+  // structure is assembled, so it is assembled once
+  defer_symbolic_assembly_ = true;
+
   // tweak the sub-PK parameter lists
   Teuchos::Array<std::string> names = plist_->get<Teuchos::Array<std::string> >("PKs order");
 
@@ -105,6 +109,10 @@ MPCPermafrost::Setup(const Teuchos::Ptr<State>& S) {
   // call the subsurface setup, which calls the sub-pk's setups and sets up
   // the subsurface block operator
   MPCSubsurface::Setup(S);
+  if (precon_type_ == PRECON_CPR) {
+    Errors::Message message("MPCPermafrost: preconditioner type \"cpr\" is not supported with surface coupling.");
+    Exceptions::amanzi_throw(message);
+  }
 
   // require the coupling fields, claim ownership
   S->RequireField(mass_exchange_key_, name_)
@@ -171,11 +179,11 @@ MPCPermafrost::Setup(const Teuchos::Ptr<State>& S) {
         dE_dp_block_->OpPushBack(*op);
       }
     }
-
-    // must now re-symbolic assemble the matrix to get the updated surface parts
-    preconditioner_->SymbolicAssembleMatrix();
-    preconditioner_->InitializePreconditioner(plist_->sublist("preconditioner"));
   }
+
+  // assemble the structure, now including the surface parts
+  pc_structure_->SymbolicAssemble(name_, *preconditioner_);
+  preconditioner_->InitializePreconditioner(plist_->sublist("preconditioner"));
       
   // grab the debuggers
   domain_db_ = domain_flow_pk_->debugger();
@@ -226,6 +234,35 @@ MPCPermafrost::set_states(const Teuchos::RCP<State>& S,
                            const Teuchos::RCP<State>& S_next) {
   MPCSubsurface::set_states(S,S_inter,S_next);
   if (water_.get()) water_->set_states(S,S_inter,S_next);
+
+  // The scheduler holds evaluators of S_next, so is rebuilt with it.
+  if (plist_->get<bool>("evaluate independent evaluators concurrently", false)) {
+    std::vector<Key> roots;
+    if (plist_->isParameter("concurrently evaluated keys")) {
+      Teuchos::Array<std::string> keys =
+          plist_->get<Teuchos::Array<std::string> >("concurrently evaluated keys");
+      roots.insert(roots.end(), keys.begin(), keys.end());
+    } else {
+      const char* subsurf_names[] = { "water_content", "energy", "enthalpy",
+                                      "thermal_conductivity", "relative_permeability" };
+      const char* surf_names[] = { "water_content", "energy", "enthalpy",
+                                   "thermal_conductivity", "overland_conductivity" };
+      for (int i=0; i!=5; ++i) {
+        Key key = Keys::getKey(domain_subsurf_, subsurf_names[i]);
+        if (S_next->HasFieldEvaluator(key)) roots.push_back(key);
+      }
+      for (int i=0; i!=5; ++i) {
+        Key key = Keys::getKey(domain_surf_, surf_names[i]);
+        if (S_next->HasFieldEvaluator(key)) roots.push_back(key);
+      }
+    }
+
+    // the exchange fluxes are set during the residual
+    KeySet excluded;
+    excluded.insert(mass_exchange_key_);
+    excluded.insert(energy_exchange_key_);
+    scheduler_ = Teuchos::rcp(new EvaluatorScheduler(name_, roots, excluded));
+  }
 }
 
 
@@ -236,6 +273,24 @@ MPCPermafrost::FunctionalResidual(double t_old, double t_new, Teuchos::RCP<TreeV
   // propagate updated info into state
   Solution_to_State(*u_new, S_next_);
 
+  // bring independent evaluators up to date, concurrently if possible
+  if (scheduler_ != Teuchos::null) {
+    bool first = !scheduler_->is_setup();
+    scheduler_->Update(S_next_.ptr());
+
+    if (first && vo_->os_OK(Teuchos::VERB_HIGH)) {
+      Teuchos::OSTab tab = vo_->getOSTab();
+      const std::vector<std::vector<Key> >& groups = scheduler_->get_groups();
+      *vo_->os() << "Evaluators updated in " << groups.size() << " groups"
+                 << (scheduler_->concurrent() ? ", concurrently:" : ", serially:") << std::endl;
+      for (int g=0; g!=groups.size(); ++g) {
+        *vo_->os() << "  ";
+        for (int r=0; r!=groups[g].size(); ++r) *vo_->os() << " " << groups[g][r];
+        *vo_->os() << std::endl;
+      }
+    }
+  }
+
   // Evaluate the surface flow residual
   surf_flow_pk_->FunctionalResidual(t_old, t_new, u_old->SubVector(2),
                             u_new->SubVector(2), g->SubVector(2));
@@ -388,8 +443,14 @@ MPCPermafrost::UpdatePreconditioner(double t,
   dE_dp_block_->Rescale(scaling);
   
   preconditioner_->AssembleMatrix();
+  pc_structure_->Check(name_, *preconditioner_);
   preconditioner_->UpdatePreconditioner();
 
+  // probe the local blocks for nonlinear elimination
+  if (ewc_ != Teuchos::null && ewc_->nonlinear_elimination()) {
+    UpdateNonlinearElimination_(t, up, h, scaling);
+  }
+
   if (dump_) {
     std::stringstream filename;
     filename << "FullyCoupled_PC_" << S_next_->cycle() << "_" << update_pcs_ << ".txt";
@@ -597,6 +658,9 @@ MPCPermafrost::ModifyCorrection(double h, Teuchos::RCP<const TreeVector> r,
   }
   bool modified = (n_modified > 0) || (damping < 1.);
 
+  // nonlinear elimination replaces the correction on stiff subsurface cells
+  modified |= EliminateStiffCells_(h, r, u, du);
+
   if (modified) {
     // Copy subsurface face corrections to surface cell corrections
     CopySubsurfaceToSurface(*du->SubVector(0)->Data(),
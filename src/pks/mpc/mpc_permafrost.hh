@@ -31,6 +31,21 @@ and flow for integrated hydrology with freeze/thaw processes.
    * `"water delegate`" ``[coupled-water-delegate-spec]`` A `Coupled Water
      Globalization Delegate`_ spec.
 
+   * `"evaluate independent evaluators concurrently`" ``[bool]`` **false** If
+     true, independent branches of the evaluators of the residual are brought
+     up to date concurrently before the residual is computed.  This only
+     applies to runs on a single MPI process, as evaluators scatter ghost
+     values on the mesh's communicator; on more than one process the branches
+     are updated serially.  See evaluator_scheduler.hh.
+
+   * `"concurrently evaluated keys`" ``[Array(string)]`` **water content,
+     energy, enthalpy, thermal conductivity and relative permeability or
+     overland conductivity of both domains** Roots of the branches evaluated
+     concurrently.  Those depending on the exchange fluxes are skipped.
+
+   Nonlinear elimination of subsurface cells near the latent heat cusp is
+   enabled through the `"ewc delegate`" list, as in the `Subsurface MPC`_.
+
    INCLUDES:
 
    - ``[mpc-subsurface-spec]`` *Is a* `Subsurface MPC`_
@@ -40,6 +55,7 @@ and flow for integrated hydrology with freeze/thaw processes.
 #ifndef PKS_MPC_PERMAFROST_FOUR_HH_
 #define PKS_MPC_PERMAFROST_FOUR_HH_
 
+#include "evaluator_scheduler.hh"
 #include "mpc_delegate_ewc.hh"
 #include "mpc_delegate_water.hh"
 #include "mpc_subsurface.hh"
@@ -112,6 +128,9 @@ class MPCPermafrost : public MPCSubsurface {
   // Water delegate
   Teuchos::RCP<MPCDelegateWater> water_;
 
+  // concurrent update of the evaluators of the residual
+  Teuchos::RCP<EvaluatorScheduler> scheduler_;
+
   // debugger for dumping vectors
   Teuchos::RCP<Debugger> domain_db_;
   Teuchos::RCP<Debugger> surf_db_;
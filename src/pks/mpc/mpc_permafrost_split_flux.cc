@@ -8,6 +8,7 @@ Author: Ethan Coon
 ------------------------------------------------------------------------- */
 
 #include "primary_variable_field_evaluator.hh"
+#include "PrimaryVariableChangeSetEvaluator.hh"
 #include "mpc_surface_subsurface_helpers.hh"
 
 #include "mpc_permafrost_split_flux.hh"
@@ -145,26 +146,38 @@ MPCPermafrostSplitFlux::CopyPrimaryToStar(const Teuchos::Ptr<const State>& S,
   auto& p_star = *S_star->GetFieldData(p_primary_variable_star_, S_star->GetField(p_primary_variable_star_)->owner())
                   ->ViewComponent("cell",false);
   const auto& p = *S->GetFieldData(p_primary_variable_)->ViewComponent("cell",false);
-  for (int c=0; c!=p_star.MyLength(); ++c) {
-    if (p[0][c] <= 101325.0) {
-      p_star[0][c] = 101325.;
-    } else {
-      p_star[0][c] = p[0][c];
-    }
-  }
 
+  // if the star evaluators track changed entities, mark the cells which
+  // change, so that only those are reevaluated
   auto peval = S_star->GetFieldEvaluator(p_primary_variable_star_);
   auto peval_pvfe = Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>(peval);
+  auto peval_pvcs = Teuchos::rcp_dynamic_cast<Relations::PrimaryVariableChangeSetEvaluator>(peval);
+  std::vector<int> changed;
+  for (int c=0; c!=p_star.MyLength(); ++c) {
+    double p_new = p[0][c] <= 101325.0 ? 101325. : p[0][c];
+    if (p_star[0][c] != p_new) changed.push_back(c);
+    p_star[0][c] = p_new;
+  }
+  if (peval_pvcs != Teuchos::null) peval_pvcs->MarkChanged("cell", changed);
   peval_pvfe->SetFieldAsChanged(S_star.ptr());
 
   // copy T primary variable
   auto& T_star = *S_star->GetFieldData(T_primary_variable_star_, S_star->GetField(T_primary_variable_star_)->owner())
                   ->ViewComponent("cell",false);
   const auto& T = *S->GetFieldData(T_primary_variable_)->ViewComponent("cell",false);
-  T_star = T;
 
   auto Teval = S_star->GetFieldEvaluator(T_primary_variable_star_);
   auto Teval_pvfe = Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>(Teval);
+  auto Teval_pvcs = Teuchos::rcp_dynamic_cast<Relations::PrimaryVariableChangeSetEvaluator>(Teval);
+  if (Teval_pvcs != Teuchos::null) {
+    changed.clear();
+    for (int c=0; c!=T_star.MyLength(); ++c) {
+      if (T_star[0][c] != T[0][c]) changed.push_back(c);
+    }
+    Teval_pvcs->MarkChanged("cell", changed);
+  }
+  T_star = T;
+
   Teval_pvfe->SetFieldAsChanged(S_star.ptr());
 
 }
@@ -21,7 +21,11 @@ MPCPermafrostSplitFluxColumns::MPCPermafrostSplitFluxColumns(Teuchos::ParameterL
                  const Teuchos::RCP<State>& S,
                  const Teuchos::RCP<TreeVector>& solution)
     : PK(FElist, plist, S, solution),
-      MPC<PK>(FElist, plist, S, solution)
+      MPC<PK>(FElist, plist, S, solution),
+      dt_reduced_(false),
+      dt_next_(-1.),
+      valid_(true),
+      reductions_committed_(0)
 {
   // collect keys and names
   std::string domain_star = plist_->get<std::string>("star domain name");
@@ -53,6 +57,7 @@ MPCPermafrostSplitFluxColumns::MPCPermafrostSplitFluxColumns(Teuchos::ParameterL
   
   // -- add for the various columns based on GIDs of the surface system
   auto surf_mesh = S->GetMesh(domain_star);
+  reductions_ = Teuchos::rcp(new ReductionAggregator(surf_mesh->get_comm()));
   int ncols = surf_mesh->num_entities(AmanziMesh::CELL, AmanziMesh::Parallel_type::OWNED);
   for (int i=0; i!=ncols; ++i) {
     int gid = surf_mesh->cell_map(false).GID(i);
@@ -132,17 +137,30 @@ void MPCPermafrostSplitFluxColumns::Setup(const Teuchos::Ptr<State>& S)
 }
 
 // -----------------------------------------------------------------------------
-// Calculate the min of sub PKs timestep sizes.
+// Calculate the min of sub PKs timestep sizes.  This was already reduced at
+// the end of AdvanceStep(), unless no step has been taken yet.
 // -----------------------------------------------------------------------------
 double MPCPermafrostSplitFluxColumns::get_dt()
+{
+  if (dt_reduced_) {
+    dt_reduced_ = false;
+    return dt_next_;
+  }
+
+  reductions_->Reset();
+  int i_dt = reductions_->AddMin(get_dt_local_());
+  reductions_->Reduce();
+  return reductions_->Min(i_dt);
+};
+
+
+double MPCPermafrostSplitFluxColumns::get_dt_local_()
 {
   double dt_l = 1.e99;
   for (auto pk : sub_pks_) {
     dt_l = std::min(pk->get_dt(), dt_l);
   }    
-  double dt_g;
-  S_next_->GetMesh(Keys::getDomain(p_primary_variable_star_))->get_comm()->MinAll(&dt_l, &dt_g, 1);
-  return dt_g;
+  return dt_l;
 };
 
 // -----------------------------------------------------------------------------
@@ -164,11 +182,17 @@ void MPCPermafrostSplitFluxColumns::set_dt( double dt)
 bool MPCPermafrostSplitFluxColumns::AdvanceStep(double t_old, double t_new, bool reinit)
 {
   Teuchos::OSTab tab = vo_->getOSTab();
+  dt_reduced_ = false;
+  valid_ = true;
+
   // Advance the star system 
   bool fail = false;
   fail = sub_pks_[0]->AdvanceStep(t_old, t_new, reinit);
   fail |= !sub_pks_[0]->ValidStep();
-  if (fail) return fail;
+  if (fail) {
+    valid_ = false;
+    return fail;
+  }
 
   // Copy star's new value into primary's old value
   CopyStarToPrimary(t_new - t_old);
@@ -181,16 +205,26 @@ bool MPCPermafrostSplitFluxColumns::AdvanceStep(double t_old, double t_new, bool
     if (fail) break;
   }
 
-  int fail_l(fail);
-  int fail_g;
-  S_next_->GetMesh(Keys::getDomain(p_primary_variable_star_))->get_comm()->MaxAll(&fail_l, &fail_g, 1);
-  return fail_g > 0;
+  // reduce the failure flag along with the next time step proposal, which
+  // already accounts for any failure
+  reductions_->Reset();
+  int i_fail = reductions_->AddFlag(fail);
+  int i_dt = reductions_->AddMin(get_dt_local_());
+  reductions_->Reduce();
+
+  valid_ = !reductions_->Flag(i_fail);
+  dt_next_ = reductions_->Min(i_dt);
+  dt_reduced_ = true;
+  return !valid_;
 };
 
 
+// -----------------------------------------------------------------------------
+// Validity of every sub-PK was checked, and reduced, in AdvanceStep().
+// -----------------------------------------------------------------------------
 bool MPCPermafrostSplitFluxColumns::ValidStep() 
 {
-  return MPC<PK>::ValidStep();
+  return valid_;
 }
 
 
@@ -203,6 +237,14 @@ void MPCPermafrostSplitFluxColumns::CommitStep(double t_old, double t_new,
 
   // Copy the primary into the star to advance
   CopyPrimaryToStar(S.ptr(), S.ptr());
+
+  if (vo_->os_OK(Teuchos::VERB_HIGH)) {
+    Teuchos::OSTab tab = vo_->getOSTab();
+    *vo_->os() << "Global reductions: " << reductions_->num_collectives() - reductions_committed_
+               << " collectives (total: " << reductions_->num_collectives() << " collectives of "
+               << reductions_->num_values() << " values)" << std::endl;
+  }
+  reductions_committed_ = reductions_->num_collectives();
 }
 
 
@@ -33,6 +33,12 @@ dE_s / dt = (dE_s / dt)^* + QE_ext + h * Q_ext + qE_ss + h * q_ss
 dE / dt = div (  kappa grad T) + hq )
 kappa grad T |_s = qE_ss
 
+The columns are serial, so their time step proposals and failure flags must be
+reduced globally.  At the end of AdvanceStep() the failure flag and the time
+step proposals of all sub-PKs are reduced in a single collective (see
+ReductionAggregator), and the results are used by the following calls to
+ValidStep() and get_dt() without further communication.
+
 
 ------------------------------------------------------------------------- */
 
@@ -42,6 +48,7 @@ kappa grad T |_s = qE_ss
 #include "PK.hh"
 #include "mpc.hh"
 #include "primary_variable_field_evaluator.hh"
+#include "reduction_aggregator.hh"
 
 namespace Amanzi {
 
@@ -86,6 +93,9 @@ class MPCPermafrostSplitFluxColumns : public MPC<PK> {
   virtual void CopyStarToPrimaryPressure_(double dt);
   virtual void CopyStarToPrimaryFlux_(double dt);
   virtual void CopyStarToPrimaryHybrid_(double dt);
+
+  // -- min of the sub-PK time step proposals on this process
+  double get_dt_local_();
   
  protected:
   
@@ -105,6 +115,13 @@ class MPCPermafrostSplitFluxColumns : public MPC<PK> {
   std::vector<std::string> col_domains_;
 
   std::string coupling_;
+
+  // batched global reductions
+  Teuchos::RCP<ReductionAggregator> reductions_;
+  bool dt_reduced_;
+  double dt_next_;
+  bool valid_;
+  int reductions_committed_;
   
  private:
   // factory registration
@@ -17,6 +17,9 @@ with freezing.
 #include "PDE_Advection.hh"
 #include "PDE_Accumulation.hh"
 #include "Operator.hh"
+#include "Operator_Cell.hh"
+#include "Operator_FaceCell.hh"
+#include "OperatorDefs.hh"
 #include "LinearOperatorFactory.hh"
 #include "upwind_total_flux.hh"
 #include "upwind_arithmetic_mean.hh"
@@ -123,6 +126,8 @@ void MPCSubsurface::Setup(const Teuchos::Ptr<State>& S) {
     precon_type_ = PRECON_NO_FLOW_COUPLING;
   } else if (precon_string == "picard") {
     precon_type_ = PRECON_PICARD;
+  } else if (precon_string == "cpr") {
+    precon_type_ = PRECON_CPR;
   } else if (precon_string == "ewc") {
     AMANZI_ASSERT(0);
     precon_type_ = PRECON_EWC;
@@ -355,8 +360,41 @@ void MPCSubsurface::Setup(const Teuchos::Ptr<State>& S) {
   }
 
   // set up sparsity structure
-  preconditioner_->SymbolicAssembleMatrix();
-  preconditioner_->InitializePreconditioner(plist_->sublist("preconditioner"));
+  if (!defer_symbolic_assembly_) {
+    pc_structure_->SymbolicAssemble(name_, *preconditioner_);
+    preconditioner_->InitializePreconditioner(plist_->sublist("preconditioner"));
+  }
+
+  // CPR: the first stage solves the decoupled pressure system, the above is
+  // the smoother
+  if (precon_type_ == PRECON_CPR) {
+    if (!plist_->isSublist("CPR pressure preconditioner")) {
+      Errors::Message message("MPCSubsurface: preconditioner type \"cpr\" requires a \"CPR pressure preconditioner\" sublist.");
+      Exceptions::amanzi_throw(message);
+    }
+    // The decoupled pressure system shares the flow block's ops, so that
+    // the flow block itself is left as is for the second stage.
+    Teuchos::RCP<CompositeVectorSpace> cvs =
+        Teuchos::rcp(new CompositeVectorSpace(pcA->DomainMap()));
+    Teuchos::ParameterList cpr_plist;
+    if (cvs->HasComponent("face")) {
+      cpr_pressure_ = Teuchos::rcp(new Operators::Operator_FaceCell(cvs, cpr_plist));
+    } else if (cvs->NumComponents() == 1 && cvs->HasComponent("cell")) {
+      cpr_pressure_ = Teuchos::rcp(new Operators::Operator_Cell(cvs, cpr_plist,
+              Operators::OPERATOR_SCHEMA_DOFS_CELL));
+    } else {
+      Errors::Message message("MPCSubsurface: preconditioner type \"cpr\" requires a flow discretization on cells, or on faces and cells.");
+      Exceptions::amanzi_throw(message);
+    }
+    for (Operators::Operator::op_iterator op = pcA->begin(); op != pcA->end(); ++op) {
+      cpr_pressure_->OpPushBack(*op);
+    }
+    cpr_decoupling_ = Teuchos::rcp(new Operators::PDE_Accumulation(AmanziMesh::CELL, cpr_pressure_));
+
+    pc_structure_->SymbolicAssemble(name_+" CPR pressure", *cpr_pressure_);
+    cpr_pressure_->InitializePreconditioner(plist_->sublist("CPR pressure preconditioner"));
+    cpr_weights_ = Teuchos::rcp(new Epetra_MultiVector(mesh_->cell_map(false), 1));
+  }
 
   // create the linear solver
   if (plist_->isSublist("linear solver")) {
@@ -487,6 +525,121 @@ void MPCSubsurface::CommitStep(double t_old, double t_new, const Teuchos::RCP<St
   update_pcs_ = 0;
 }
 
+// -----------------------------------------------------------------------------
+// Modify the correction, with nonlinear elimination of stiff cells.
+// -----------------------------------------------------------------------------
+AmanziSolvers::FnBaseDefs::ModifyCorrectionResult
+MPCSubsurface::ModifyCorrection(double h, Teuchos::RCP<const TreeVector> res,
+        Teuchos::RCP<const TreeVector> u, Teuchos::RCP<TreeVector> du) {
+  AmanziSolvers::FnBaseDefs::ModifyCorrectionResult modified =
+      StrongMPC<PK_PhysicalBDF_Default>::ModifyCorrection(h, res, u, du);
+
+  if (EliminateStiffCells_(h, res, u, du)) {
+    modified = std::max(modified, AmanziSolvers::FnBaseDefs::CORRECTION_MODIFIED);
+  }
+  return modified;
+}
+
+
+// -----------------------------------------------------------------------------
+// Local solves on stiff cells of the subsurface, replacing their correction.
+// Returns true if any cell, on any process, was modified.
+// -----------------------------------------------------------------------------
+bool MPCSubsurface::EliminateStiffCells_(double h,
+        const Teuchos::RCP<const TreeVector>& g,
+        const Teuchos::RCP<const TreeVector>& u,
+        const Teuchos::RCP<TreeVector>& du) {
+  if (ewc_ == Teuchos::null || !ewc_->nonlinear_elimination()) return false;
+
+  // subsurface (p,T) vectors, by pointer
+  TreeVector sub_g, sub_u, sub_du;
+  sub_g.PushBack(Teuchos::rcp_const_cast<TreeVector>(g->SubVector(0)));
+  sub_g.PushBack(Teuchos::rcp_const_cast<TreeVector>(g->SubVector(1)));
+  sub_u.PushBack(Teuchos::rcp_const_cast<TreeVector>(u->SubVector(0)));
+  sub_u.PushBack(Teuchos::rcp_const_cast<TreeVector>(u->SubVector(1)));
+  sub_du.PushBack(du->SubVector(0));
+  sub_du.PushBack(du->SubVector(1));
+
+  int n_local = ewc_->EliminateStiffCells(S_next_->time(), h, sub_g, sub_u, sub_du);
+  int n_global = 0;
+  mesh_->get_comm()->SumAll(&n_local, &n_global, 1);
+  if (n_global == 0) return false;
+
+  if (vo_->os_OK(Teuchos::VERB_HIGH)) {
+    Teuchos::OSTab tab = vo_->getOSTab();
+    *vo_->os() << "Nonlinear elimination: " << n_global << " cells modified" << std::endl;
+  }
+  return true;
+}
+
+
+// -----------------------------------------------------------------------------
+// Probe the cell-diagonal (p,T) blocks of the preconditioner.
+//
+// Cells are colored so that no two face-neighbors share a color, and each
+// color is probed by applying the operator to an indicator vector, once in p
+// and once in T.  Cells with a ghost neighbor cannot be colored consistently
+// without communication, so they are excluded from elimination.
+// -----------------------------------------------------------------------------
+void MPCSubsurface::UpdateNonlinearElimination_(double t,
+        Teuchos::RCP<const TreeVector> up, double h, double p_scale) {
+  int ncells = mesh_->num_entities(AmanziMesh::CELL, AmanziMesh::Parallel_type::OWNED);
+
+  // greedy coloring, done once as the mesh does not change
+  if (elim_ncolors_ < 0) {
+    elim_colors_.assign(ncells, -1);
+    int ncolors_l = 0;
+    AmanziMesh::Entity_ID_List nbrs;
+    for (int c=0; c!=ncells; ++c) {
+      mesh_->cell_get_face_adj_cells(c, AmanziMesh::Parallel_type::ALL, &nbrs);
+      bool boundary = false;
+      std::vector<bool> used(ncolors_l + 1, false);
+      for (auto n : nbrs) {
+        if (n >= ncells) {
+          boundary = true;
+        } else if (elim_colors_[n] >= 0) {
+          used[elim_colors_[n]] = true;
+        }
+      }
+      if (boundary) continue;
+      int color = 0;
+      while (used[color]) color++;
+      elim_colors_[c] = color;
+      ncolors_l = std::max(ncolors_l, color + 1);
+    }
+    mesh_->get_comm()->MaxAll(&ncolors_l, &elim_ncolors_, 1);
+  }
+
+  std::vector<WhetStone::Tensor> diag(ncells, WhetStone::Tensor(2,2));
+  std::vector<bool> valid(ncells, false);
+  for (int c=0; c!=ncells; ++c) valid[c] = elim_colors_[c] >= 0;
+
+  TreeVector probe(preconditioner_->DomainMap());
+  TreeVector result(preconditioner_->DomainMap());
+  for (int color=0; color!=elim_ncolors_; ++color) {
+    for (int j=0; j!=2; ++j) {
+      probe.PutScalar(0.);
+      Epetra_MultiVector& probe_c = *probe.SubVector(j)->Data()->ViewComponent("cell",false);
+      for (int c=0; c!=ncells; ++c) {
+        if (elim_colors_[c] == color) probe_c[0][c] = 1.;
+      }
+      preconditioner_->Apply(probe, result);
+
+      // a probe in pressure is in units of the scaled pressure
+      double scale = j == 0 ? p_scale : 1.;
+      for (int i=0; i!=2; ++i) {
+        const Epetra_MultiVector& result_c = *result.SubVector(i)->Data()->ViewComponent("cell",false);
+        for (int c=0; c!=ncells; ++c) {
+          if (elim_colors_[c] == color) diag[c](i,j) = result_c[0][c] / scale;
+        }
+      }
+    }
+  }
+
+  ewc_->UpdateNonlinearElimination(t, up, h, diag, valid);
+}
+
+
 // update the predictor to be physically consistent
 bool MPCSubsurface::ModifyPredictor(double h, Teuchos::RCP<const TreeVector> up0,
         Teuchos::RCP<TreeVector> up) {
@@ -510,7 +663,8 @@ void MPCSubsurface::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector
     // nothing to do
   } else if (precon_type_ == PRECON_BLOCK_DIAGONAL) {
     StrongMPC::UpdatePreconditioner(t,up,h);
-  } else if (precon_type_ == PRECON_PICARD || precon_type_ == PRECON_EWC) {
+  } else if (precon_type_ == PRECON_PICARD || precon_type_ == PRECON_EWC ||
+             precon_type_ == PRECON_CPR) {
     StrongMPC::UpdatePreconditioner(t,up,h);
 
     // Update operators for off-diagonals
@@ -734,6 +888,7 @@ void MPCSubsurface::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector
     // finally assemble the full system, dump if requested, and form the inverse
     if (assemble) {
       preconditioner_->AssembleMatrix();
+      pc_structure_->Check(name_, *preconditioner_);
       if (dump_) {
         std::stringstream filename;
         filename << "Subsurface_PC_" << S_next_->cycle() << "_" << update_pcs_ << ".txt";
@@ -741,12 +896,38 @@ void MPCSubsurface::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector
       }
       preconditioner_->UpdatePreconditioner();
     }
+
+    // CPR: quasi-IMPES weights and the decoupled pressure system's inverse
+    if (precon_type_ == PRECON_CPR) {
+      S_next_->GetFieldEvaluator(e_key_)
+          ->HasFieldDerivativeChanged(S_next_.ptr(), name_, temp_key_);
+      const Epetra_MultiVector& dWC_dT_c = *dWC_dT->ViewComponent("cell",false);
+      const Epetra_MultiVector& dE_dT_c = *S_next_->GetFieldData(
+          Keys::getDerivKey(e_key_, temp_key_))->ViewComponent("cell",false);
+      const Epetra_MultiVector& dE_dp_c = *dE_dp->ViewComponent("cell",false);
+      Epetra_MultiVector& w = *cpr_weights_;
+      Epetra_MultiVector& decoupling = *cpr_decoupling_->local_op(0)->diag;
+      for (int c=0; c!=w.MyLength(); ++c) {
+        w[0][c] = std::abs(dE_dT_c[0][c]) > 0. ? -dWC_dT_c[0][c] / dE_dT_c[0][c] : 0.;
+        decoupling[0][c] = w[0][c] * dE_dp_c[0][c] / h;
+      }
+
+      cpr_pressure_->AssembleMatrix();
+      pc_structure_->Check(name_+" CPR pressure", *cpr_pressure_);
+      cpr_pressure_->UpdatePreconditioner();
+    }
   }
   
 
   if (precon_type_ == PRECON_EWC) {
     ewc_->UpdatePreconditioner(t,up,h);
   }
+
+  // probe the local blocks for nonlinear elimination
+  if (assemble && precon_type_ != PRECON_NONE &&
+      ewc_ != Teuchos::null && ewc_->nonlinear_elimination()) {
+    UpdateNonlinearElimination_(t, up, h, 1.);
+  }
   update_pcs_++;
 }
 
@@ -779,6 +960,8 @@ int MPCSubsurface::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u,
     ierr = StrongMPC::ApplyPreconditioner(u,Pu);
   } else if (precon_type_ == PRECON_PICARD) {
     ierr = linsolve_preconditioner_->ApplyInverse(*u, *Pu);
+  } else if (precon_type_ == PRECON_CPR) {
+    ierr = ApplyCPR_(*u, *Pu);
   } else if (precon_type_ == PRECON_EWC) {
     ierr = linsolve_preconditioner_->ApplyInverse(*u, *Pu);
 
@@ -827,6 +1010,44 @@ int MPCSubsurface::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u,
 }
 
 
+// -----------------------------------------------------------------------------
+// Two-stage CPR: a pressure solve on the decoupled residual, then the global
+// smoother on what is left.
+// -----------------------------------------------------------------------------
+int MPCSubsurface::ApplyCPR_(const TreeVector& u, TreeVector& Pu) {
+  if (cpr_r_ == Teuchos::null) {
+    cpr_rp_ = Teuchos::rcp(new CompositeVector(*u.SubVector(0)->Data()));
+    cpr_r_ = Teuchos::rcp(new TreeVector(u));
+    cpr_x_ = Teuchos::rcp(new TreeVector(u));
+  }
+
+  // stage one: r_p = r_WC + w * r_E on cells, solved on the decoupled
+  // pressure system
+  *cpr_rp_ = *u.SubVector(0)->Data();
+  {
+    Epetra_MultiVector& rp_c = *cpr_rp_->ViewComponent("cell",false);
+    const Epetra_MultiVector& re_c = *u.SubVector(1)->Data()->ViewComponent("cell",false);
+    rp_c.Multiply(1., *cpr_weights_, re_c, 1.);
+  }
+  Pu.PutScalar(0.);
+  int ierr = cpr_pressure_->ApplyInverse(*cpr_rp_, *Pu.SubVector(0)->Data());
+
+  // stage two: smooth the full residual, r - A [dp; 0]
+  preconditioner_->Apply(Pu, *cpr_r_);
+  cpr_r_->Update(1., u, -1.);
+  int ierr2 = preconditioner_->ApplyInverse(*cpr_r_, *cpr_x_);
+  Pu.Update(1., *cpr_x_, 1.);
+
+  if (vo_->os_OK(Teuchos::VERB_EXTREME)) {
+    double rnorm(0.);
+    cpr_r_->Norm2(&rnorm);
+    *vo_->os() << "CPR: pressure stage returned " << ierr << ", |r - A dp| = "
+               << rnorm << std::endl;
+  }
+  return std::min(ierr, ierr2);
+}
+
+
 // AmanziSolvers::FnBaseDefs::ModifyCorrectionResult
 //     MPCSubsurface::ModifyCorrection(double h,
 //                                     Teuchos::RCP<const TreeVector> res,
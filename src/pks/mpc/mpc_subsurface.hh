@@ -103,6 +103,21 @@ except in expert cases or for comparison's sake, but the options are:
   seems like it ought to be helpful, but often doesn't do as much as one might
   hope.
 
+- `"cpr`" A two-stage, constrained pressure residual preconditioner.  The
+  first stage decouples a pressure equation by combining, cell by cell, the
+  water content and energy residuals with quasi-IMPES weights,
+  :math:`r_p = r_{WC} - \frac{\partial WC / \partial T}{\partial E /
+  \partial T} r_E`, which eliminate the temperature dependence of the
+  accumulation terms.  This is solved on the flow block, typically with AMG,
+  as controlled by `"CPR pressure preconditioner`".  The pressure system is
+  decoupled with the same weights, i.e. it is the flow block plus the
+  weighted accumulation term of the :math:`\frac{\partial E}{\partial p}`
+  block, :math:`A_{pp} - \frac{\partial WC / \partial T}{\partial E /
+  \partial T} \frac{\partial E}{\partial p} / h` on cells.  The second
+  stage applies the `"preconditioner`" of this MPC, typically a cheap (block)
+  ILU, to the residual of the full `"picard`" system that remains after the
+  pressure correction.
+
 
 Note this "ewc" algorithm is just as valid, and more useful, in the predictor
 (where it is not deprecated/disabled).  There, we extrapolate a change in
@@ -118,13 +133,21 @@ algorithms are supported by the `EWC Globalization Delegate`_ object.
 
     * `"preconditioner type`" ``[string]`` **picard** See the above for
       detailed descriptions of the choices.  One of: `"none`", `"block
-      diagonal`", `"no flow coupling`", `"picard`", `"ewc`", and `"smart ewc`".
+      diagonal`", `"no flow coupling`", `"picard`", `"cpr`", `"ewc`", and
+      `"smart ewc`".
+
+    * `"CPR pressure preconditioner`" ``[preconditioner-typed-spec]`` Only used
+      if `"preconditioner type`" is `"cpr`".  The preconditioner for the
+      first stage pressure solve, usually AMG.
     
     * `"supress Jacobian terms: div hq / dp,T`" ``[bool]`` **false** If using picard or ewc, do not include this block in the preconditioner.
     * `"supress Jacobian terms: d div q / dT`" ``[bool]`` **false** If using picard or ewc, do not include this block in the preconditioner.
     * `"supress Jacobian terms: d div K grad T / dp`" ``[bool]`` **false** If using picard or ewc, do not include this block in the preconditioner.
 
     * `"ewc delegate`" ``[ewc-delegate-spec]`` A `EWC Globalization Delegate`_ spec.
+      If its `"nonlinear elimination`" option is set, cells near the latent
+      heat cusp get a local nonlinear solve, which replaces the correction of
+      each global Newton iteration on those cells.
 
     INCLUDES:
 
@@ -167,6 +190,8 @@ class MPCSubsurface : public StrongMPC<PK_PhysicalBDF_Default> {
                 const Teuchos::RCP<TreeVector>& soln) :
       PK(pk_tree_list, global_list, S, soln),
       StrongMPC<PK_PhysicalBDF_Default>(pk_tree_list, global_list, S, soln),
+      elim_ncolors_(-1),
+      defer_symbolic_assembly_(false),
       update_pcs_(0)
   {
     dump_ = plist_->get<bool>("dump preconditioner", false);
@@ -195,9 +220,12 @@ class MPCSubsurface : public StrongMPC<PK_PhysicalBDF_Default> {
   
   // preconditioner application
   virtual int ApplyPreconditioner(Teuchos::RCP<const TreeVector> u, Teuchos::RCP<TreeVector> Pu);
-  // virtual AmanziSolvers::FnBaseDefs::ModifyCorrectionResult
-  //     ModifyCorrection(double h, Teuchos::RCP<const TreeVector> res,
-  //                      Teuchos::RCP<const TreeVector> u, Teuchos::RCP<TreeVector> du);
+
+  // modify the correction, with nonlinear elimination of stiff cells if
+  // requested
+  virtual AmanziSolvers::FnBaseDefs::ModifyCorrectionResult
+      ModifyCorrection(double h, Teuchos::RCP<const TreeVector> res,
+                       Teuchos::RCP<const TreeVector> u, Teuchos::RCP<TreeVector> du);
 
   Teuchos::RCP<Operators::TreeOperator> preconditioner() { return preconditioner_; }
 
@@ -214,6 +242,7 @@ class MPCSubsurface : public StrongMPC<PK_PhysicalBDF_Default> {
     PRECON_PICARD = 2,
     PRECON_EWC = 3,
     PRECON_NO_FLOW_COUPLING = 4,    
+    PRECON_CPR = 5,
   };
 
   Teuchos::RCP<Operators::TreeOperator> preconditioner_;
@@ -280,6 +309,31 @@ class MPCSubsurface : public StrongMPC<PK_PhysicalBDF_Default> {
   // EWC delegate
   Teuchos::RCP<MPCDelegateEWCSubsurface> ewc_;
 
+  // nonlinear elimination: probe the cell-diagonal blocks of the assembled
+  // preconditioner, whose pressure columns are scaled by p_scale, and
+  // eliminate stiff cells from the subsurface (p,T) correction.
+  void UpdateNonlinearElimination_(double t, Teuchos::RCP<const TreeVector> up,
+          double h, double p_scale);
+  bool EliminateStiffCells_(double h, const Teuchos::RCP<const TreeVector>& g,
+                            const Teuchos::RCP<const TreeVector>& u,
+                            const Teuchos::RCP<TreeVector>& du);
+  std::vector<int> elim_colors_;
+  int elim_ncolors_;
+
+  // two-stage CPR: quasi-IMPES weights -dWC/dT / dE/dT, the decoupled
+  // pressure system (the flow block's ops and the weighted dE/dp
+  // accumulation) and work space
+  int ApplyCPR_(const TreeVector& u, TreeVector& Pu);
+  Teuchos::RCP<Epetra_MultiVector> cpr_weights_;
+  Teuchos::RCP<Operators::Operator> cpr_pressure_;
+  Teuchos::RCP<Operators::PDE_Accumulation> cpr_decoupling_;
+  Teuchos::RCP<CompositeVector> cpr_rp_;
+  Teuchos::RCP<TreeVector> cpr_r_;
+  Teuchos::RCP<TreeVector> cpr_x_;
+
+  // derived MPCs that add to the operator assemble its structure themselves
+  bool defer_symbolic_assembly_;
+
   // cruft for easier global debugging
   bool dump_;
   int update_pcs_;
@@ -226,7 +226,7 @@ void MPCSurface::Setup(const Teuchos::Ptr<State>& S) {
   }
 
   // set up sparsity structure
-  preconditioner_->SymbolicAssembleMatrix();
+  pc_structure_->SymbolicAssemble(name_, *preconditioner_);
   preconditioner_->InitializePreconditioner(plist_->sublist("preconditioner"));
 
   // create the linear solver
@@ -452,6 +452,7 @@ void MPCSurface::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> u
     // finally assemble the full system, dump if requested, and form the inverse
     if (assemble) {
       preconditioner_->AssembleMatrix();
+      pc_structure_->Check(name_, *preconditioner_);
       if (dump_) {
         std::stringstream filename;
         filename << "Subsurface_PC_" << S_next_->cycle() << "_" << update_pcs_ << ".txt";
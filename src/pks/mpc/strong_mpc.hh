@@ -11,6 +11,12 @@
 
 Globally implicit coupling solves all sub-PKs as a single system of equations.  This can be completely automated when all PKs are also `PK: BDF`_ PKs, using a block-diagonal preconditioner where each diagonal block is provided by its own sub-PK.
 
+The error norm of the coupled system is the max of the sub-PKs' norms.  The
+local norms of all sub-PKs (recursively, through nested strong MPCs) are
+gathered and reduced in a single global reduction per nonlinear iteration.
+The number of these reductions is written at `"high`" verbosity when each
+step is committed.
+
 .. _strong-mpc-spec:
 .. admonition:: strong-mpc-spec
 
@@ -52,10 +58,7 @@ public:
   virtual void Initialize(const Teuchos::Ptr<State>& S);
 
   // -- Commit any secondary (dependent) variables.
-  virtual void CommitStep(double t_old, double t_new, const Teuchos::RCP<State>& S) {
-    PK_BDF_Default::CommitStep(t_old, t_new, S);
-    MPC<PK_t>::CommitStep(t_old, t_new, S);
-  }
+  virtual void CommitStep(double t_old, double t_new, const Teuchos::RCP<State>& S);
 
   void set_states(const Teuchos::RCP<State>& S,
                   const Teuchos::RCP<State>& S_inter,
@@ -71,6 +74,12 @@ public:
   virtual double ErrorNorm(Teuchos::RCP<const TreeVector> u,
                        Teuchos::RCP<const TreeVector> du);
 
+  // -- local parts of the sub-PKs' norms, reduced together by ErrorNorm()
+  virtual void ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
+                              Teuchos::RCP<const TreeVector> du,
+                              std::vector<double>& norms);
+  virtual int ErrorNormReduced(const std::vector<double>& norms, int i);
+
   // StrongMPC's preconditioner is, by default, just the block-diagonal
   // operator formed by placing the sub PK's preconditioners on the diagonal.
   // -- Apply preconditioner to u and returns the result in Pu.
@@ -106,6 +115,10 @@ protected:
   using MPC<PK_t>::pk_tree_;
   using MPC<PK_t>::pks_list_;
 
+  // global reductions in ErrorNorm()
+  int enorm_reductions_step_;
+  int enorm_reductions_total_;
+
 private:
   // factory registration
   static RegisteredPKFactory<StrongMPC> reg_;
@@ -122,7 +135,9 @@ StrongMPC<PK_t>::StrongMPC(Teuchos::ParameterList& pk_tree,
                            const Teuchos::RCP<TreeVector>& soln) :
     PK(pk_tree, global_list, S, soln),
     MPC<PK_t>(pk_tree, global_list, S, soln),
-    PK_BDF_Default(pk_tree, global_list, S, soln) {
+    PK_BDF_Default(pk_tree, global_list, S, soln),
+    enorm_reductions_step_(0),
+    enorm_reductions_total_(0) {
   MPC<PK_t>::init_(S);
 }
 
@@ -257,15 +272,60 @@ int StrongMPC<PK_t>::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u, Teuch
 };
 
 
+// -----------------------------------------------------------------------------
+// Commit the step, writing the number of error norm reductions.
+// -----------------------------------------------------------------------------
+template<class PK_t>
+void StrongMPC<PK_t>::CommitStep(double t_old, double t_new,
+        const Teuchos::RCP<State>& S) {
+  PK_BDF_Default::CommitStep(t_old, t_new, S);
+  MPC<PK_t>::CommitStep(t_old, t_new, S);
+
+  // only the outermost strong MPC reduces
+  if (enorm_reductions_step_ > 0) {
+    enorm_reductions_total_ += enorm_reductions_step_;
+    if (vo_->os_OK(Teuchos::VERB_HIGH)) {
+      Teuchos::OSTab tab = vo_->getOSTab();
+      *vo_->os() << "ErrorNorm: " << enorm_reductions_step_
+                 << " global reductions (total: " << enorm_reductions_total_
+                 << ")" << std::endl;
+    }
+    enorm_reductions_step_ = 0;
+  }
+};
+
+
 // -----------------------------------------------------------------------------
 // Compute a norm on u-du and returns the result.
-// For a Strong MPC, the enorm is just the max of the sub PKs enorms.
+// For a Strong MPC, the enorm is just the max of the sub PKs enorms.  These
+// are all reduced at once.
 // -----------------------------------------------------------------------------
 template<class PK_t>
 double StrongMPC<PK_t>::ErrorNorm(Teuchos::RCP<const TreeVector> u,
                         Teuchos::RCP<const TreeVector> du){
+  std::vector<double> norms;
+  ErrorNormLocal(u, du, norms);
+
+  // reduce on the communicator of the first leaf vector
+  Teuchos::RCP<const TreeVector> leaf = u;
+  while (leaf->Data() == Teuchos::null) leaf = leaf->SubVector(0);
+  std::vector<double> norms_g(norms.size(), 0.);
+  leaf->Data()->Comm()->MaxAll(&norms[0], &norms_g[0], norms.size());
+  enorm_reductions_step_++;
+
+  ErrorNormReduced(norms_g, 0);
   double norm = 0.0;
+  for (auto n : norms_g) norm = std::max(norm, n);
+  return norm;
+};
 
+
+// -----------------------------------------------------------------------------
+// Gather the local norms of the sub-PKs.
+// -----------------------------------------------------------------------------
+template<class PK_t>
+void StrongMPC<PK_t>::ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
+        Teuchos::RCP<const TreeVector> du, std::vector<double>& norms) {
   // loop over sub-PKs
   for (unsigned int i=0; i!=sub_pks_.size(); ++i) {
     // pull out the u sub-vector
@@ -282,11 +342,18 @@ double StrongMPC<PK_t>::ErrorNorm(Teuchos::RCP<const TreeVector> u,
       Exceptions::amanzi_throw(message);
     }
 
-    // norm is the max of the sub-PK norms
-    double tmp_norm = sub_pks_[i]->ErrorNorm(pk_u, pk_du);
-    norm = std::max(norm, tmp_norm);
+    sub_pks_[i]->ErrorNormLocal(pk_u, pk_du, norms);
   }
-  return norm;
+};
+
+
+// -----------------------------------------------------------------------------
+// Hand the reduced norms back to the sub-PKs.
+// -----------------------------------------------------------------------------
+template<class PK_t>
+int StrongMPC<PK_t>::ErrorNormReduced(const std::vector<double>& norms, int i) {
+  for (auto& pk : sub_pks_) i = pk->ErrorNormReduced(norms, i);
+  return i;
 };
 
 
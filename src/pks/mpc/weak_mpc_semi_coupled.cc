@@ -21,7 +21,9 @@ WeakMPCSemiCoupled::WeakMPCSemiCoupled(Teuchos::ParameterList& pk_tree,
         const Teuchos::RCP<TreeVector>& solution)
     : PK(pk_tree, global_plist, S, solution),
       MPC<PK>(pk_tree, global_plist, S, solution),
-      sg_model_(false)
+      sg_model_(false),
+      dt_reduced_(false),
+      dt_next_(-1.)
 {
   // grab the list of subpks
   auto subpks = plist_->get<Teuchos::Array<std::string> >("PKs order");
@@ -38,6 +40,7 @@ WeakMPCSemiCoupled::WeakMPCSemiCoupled(Teuchos::ParameterList& pk_tree,
 
   // add for the various columns based on GIDs of the surface system
   Teuchos::RCP<const AmanziMesh::Mesh> surf_mesh = S->GetMesh("surface");
+  reductions_ = Teuchos::rcp(new ReductionAggregator(surf_mesh->get_comm()));
   int ncols = surf_mesh->num_entities(AmanziMesh::CELL, AmanziMesh::Parallel_type::OWNED);
   for (int i=0; i!=ncols; ++i) {
     int gid = surf_mesh->cell_map(false).GID(i);
@@ -75,16 +78,22 @@ WeakMPCSemiCoupled::WeakMPCSemiCoupled(Teuchos::ParameterList& pk_tree,
 
 // must communicate dts since columns are serial
 double WeakMPCSemiCoupled::get_dt() {
+  // already reduced at the end of the column advance
+  if (dt_reduced_) {
+    dt_reduced_ = false;
+    return dt_next_;
+  }
+
   double dt = 1.0e99;
   for (MPC<PK>::SubPKList::iterator pk = sub_pks_.begin();
        pk != sub_pks_.end(); ++pk) {
     dt = std::min<double>(dt,(*pk)->get_dt());
   }
   
-  double dt_local = dt;
-  S_->GetMesh("surface")->get_comm()->MinAll(&dt_local, &dt, 1);
-  
-  return dt;
+  reductions_->Reset();
+  int i_dt = reductions_->AddMin(dt);
+  reductions_->Reduce();
+  return reductions_->Min(i_dt);
 }
 
 // -----------------------------------------------------------------------------
@@ -127,6 +136,7 @@ WeakMPCSemiCoupled::Setup(const Teuchos::Ptr<State>& S) {
 bool 
 WeakMPCSemiCoupled::AdvanceStep(double t_old, double t_new, bool reinit) {
   bool fail = false;
+  dt_reduced_ = false;
   
   if (coupling_key_ == "surface subsurface system: columns"){
     fail = CoupledSurfSubsurfColumns(t_old, t_new, reinit);
@@ -398,10 +408,18 @@ WeakMPCSemiCoupled::CoupledSurfSubsurfColumns(double t_old, double t_new, bool r
   }
   
 
-  MPI_Barrier(MPI_COMM_WORLD);  
-
-  int nfailed_local = nfailed;
-  S_->GetMesh("surface")->get_comm()->SumAll(&nfailed_local, &nfailed, 1);
+  // reduce the column failures along with the next time step proposal.
+  // Only whether any column failed is used, so a max suffices.
+  double dt_local = 1.0e99;
+  for (auto& pk : sub_pks_) dt_local = std::min<double>(dt_local, pk->get_dt());
+
+  reductions_->Reset();
+  int i_failed = reductions_->AddMax(nfailed);
+  int i_dt = reductions_->AddMin(dt_local);
+  reductions_->Reduce();
+  nfailed = (int) reductions_->Max(i_failed);
+  dt_next_ = reductions_->Min(i_dt);
+  dt_reduced_ = true;
  
  
   if (nfailed ==0){ 
@@ -6,6 +6,7 @@
 //#include "weak_mpc.hh"
 #include "mpc.hh"
 #include "PK.hh"
+#include "reduction_aggregator.hh"
 
 namespace Amanzi {
   
@@ -42,6 +43,11 @@ private :
   
 
   bool sg_model_;
+
+  // the column failures and time step proposals are reduced together
+  Teuchos::RCP<ReductionAggregator> reductions_;
+  bool dt_reduced_;
+  double dt_next_;
 };
 
   
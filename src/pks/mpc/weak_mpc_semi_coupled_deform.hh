@@ -21,6 +21,7 @@
 #include "pk_physical_bdf_default.hh"
 #include "mpc.hh"
 #include "PK.hh"
+#include "reduction_aggregator.hh"
 
 namespace Amanzi {
   
@@ -52,6 +53,11 @@ private :
   Key coupling_key_ ;
   bool subcycle_key_ ;
   bool sg_model_, dynamic_sg_model_;
+
+  // the column failures and time step proposals are reduced together
+  Teuchos::RCP<ReductionAggregator> reductions_;
+  bool dt_reduced_;
+  double dt_next_;
 };
 
   
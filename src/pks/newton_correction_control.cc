@@ -0,0 +1,136 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/* -------------------------------------------------------------------------
+ATS
+
+License: see $ATS_DIR/COPYRIGHT
+Author: Ethan Coon
+
+Delegate controlling when the Newton correction is used in a diffusion
+preconditioner.
+------------------------------------------------------------------------- */
+
+#include <cmath>
+
+#include "newton_correction_control.hh"
+
+namespace Amanzi {
+
+NewtonCorrectionControl::NewtonCorrectionControl(Teuchos::ParameterList& plist,
+        const Teuchos::RCP<VerboseObject>& vo) :
+    vo_(vo),
+    step_time_(-1.e99),
+    active_(false),
+    first_step_(true),
+    last_enorm_(-1.),
+    prev_enorm_(-1.),
+    step_updates_(0),
+    step_updates_on_(0),
+    step_switches_(0),
+    total_updates_(0),
+    total_updates_on_(0),
+    total_switches_(0)
+{
+  lag_ = plist.get<int>("Newton correction lag", 0);
+  adaptive_ = plist.get<bool>("adaptive Newton correction", false);
+  contraction_threshold_ = plist.get<double>("adaptive Newton correction contraction threshold", 0.5);
+  residual_threshold_ = plist.get<double>("adaptive Newton correction residual threshold", 10.0);
+  divergence_factor_ = plist.get<double>("adaptive Newton correction divergence factor", 1.0);
+  max_switches_ = plist.get<int>("adaptive Newton correction max switches per step", 4);
+  active_ = lag_ == 0;
+}
+
+
+// -----------------------------------------------------------------------------
+// Decide whether this preconditioner update includes the correction.
+// -----------------------------------------------------------------------------
+bool NewtonCorrectionControl::UpdatePreconditioner(double t) {
+  // a change in time means a new step (or a retry with a smaller dt)
+  if (std::abs(t - step_time_) > 1.e-4 * std::max(std::abs(t), 1.)) {
+    BeginStep_(t);
+  }
+
+  active_ = Decide_();
+
+  step_updates_++;
+  if (active_) step_updates_on_++;
+  return active_;
+}
+
+
+// -----------------------------------------------------------------------------
+// Reset per-step data.
+// -----------------------------------------------------------------------------
+void NewtonCorrectionControl::BeginStep_(double t) {
+  if (step_updates_ > 0) first_step_ = false;
+  step_time_ = t;
+  last_enorm_ = -1.;
+  prev_enorm_ = -1.;
+  step_updates_ = 0;
+  step_updates_on_ = 0;
+  step_switches_ = 0;
+}
+
+
+bool NewtonCorrectionControl::Decide_() {
+  if (!adaptive_) return step_updates_ >= lag_;
+
+  // no iterate has been seen in this step -- start from the previous step's
+  // final state, or the lag on the very first step.
+  if (last_enorm_ < 0.) {
+    return first_step_ ? step_updates_ >= lag_ : active_;
+  }
+
+  bool active = active_;
+  if (step_switches_ < max_switches_) {
+    if (active_) {
+      if (prev_enorm_ > 0. && last_enorm_ > divergence_factor_ * prev_enorm_) {
+        active = false;
+      }
+    } else {
+      double rate = prev_enorm_ > 0. ? last_enorm_ / prev_enorm_ : 0.;
+      if (last_enorm_ < residual_threshold_ || rate > contraction_threshold_) {
+        active = true;
+      }
+    }
+  }
+
+  if (active != active_) {
+    step_switches_++;
+    if (vo_->os_OK(Teuchos::VERB_HIGH)) {
+      Teuchos::OSTab tab = vo_->getOSTab();
+      *vo_->os() << "Newton correction turned " << (active ? "on" : "off")
+                 << " (enorm = " << last_enorm_ << ", previous = " << prev_enorm_
+                 << ")" << std::endl;
+    }
+  }
+  prev_enorm_ = last_enorm_;
+  return active;
+}
+
+
+// -----------------------------------------------------------------------------
+// Accumulate and write statistics for the step.
+// -----------------------------------------------------------------------------
+void NewtonCorrectionControl::CommitStep(double t_old, double t_new) {
+  total_updates_ += step_updates_;
+  total_updates_on_ += step_updates_on_;
+  total_switches_ += step_switches_;
+
+  if (vo_->os_OK(Teuchos::VERB_HIGH)) {
+    Teuchos::OSTab tab = vo_->getOSTab();
+    *vo_->os() << "Newton correction: used in " << step_updates_on_ << " of "
+               << step_updates_ << " PC updates, " << step_switches_
+               << " switches (total: " << total_updates_on_ << " of "
+               << total_updates_ << ", " << total_switches_ << " switches)"
+               << std::endl;
+  }
+
+  // counts have been accumulated; the next step starts fresh
+  step_updates_ = 0;
+  step_updates_on_ = 0;
+  step_switches_ = 0;
+  first_step_ = false;
+}
+
+} // namespace
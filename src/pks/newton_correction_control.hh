@@ -0,0 +1,131 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! Controls when the Newton correction term is included in a diffusion preconditioner.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+
+/*!
+
+Diffusion PKs (Richards, overland flow, energy) may add the derivative of the
+nonlinear coefficient to their preconditioner, turning a Picard iteration into
+an (approximate) Newton iteration.  This term is expensive to assemble and, far
+from the solution, can hurt robustness.  This delegate decides, for each
+preconditioner update, whether the Newton correction is included.
+
+By default, the correction is turned on once the preconditioner has been
+updated `"Newton correction lag`" times within a step.  Optionally an adaptive
+strategy monitors the error norm reported by the nonlinear solver:
+
+- the correction is turned on when the iteration is contracting slowly (the
+  ratio of successive error norms is larger than the contraction threshold),
+  or when the error norm is below the residual threshold, i.e. the iterate is
+  close enough to the solution that Newton should converge quickly;
+- the correction is turned off again when, while it is on, the error norm
+  grows by more than the divergence factor.
+
+The state at the end of a step is used to start the next step.  Statistics are
+kept per step and written at `"high`" verbosity when the step is committed.
+
+These parameters live in the PK's `"diffusion preconditioner`" list.
+
+.. _newton-correction-control-spec:
+.. admonition:: newton-correction-control-spec
+
+    * `"Newton correction lag`" ``[int]`` **0** Number of preconditioner
+      updates in each step before the Newton correction is used.  In the
+      adaptive strategy this is only used on the first step.
+
+    * `"adaptive Newton correction`" ``[bool]`` **false** Use the adaptive
+      strategy described above.
+
+    * `"adaptive Newton correction contraction threshold`" ``[double]``
+      **0.5** Turn the correction on if :math:`e_k / e_{k-1}` exceeds this.
+
+    * `"adaptive Newton correction residual threshold`" ``[double]`` **10.0**
+      Turn the correction on if the error norm is below this.  Note that the
+      error norm is scaled such that 1 is converged.
+
+    * `"adaptive Newton correction divergence factor`" ``[double]`` **1.0**
+      Turn the correction off if :math:`e_k > f e_{k-1}` while it is on.
+
+    * `"adaptive Newton correction max switches per step`" ``[int]`` **4**
+      Limits toggling within a single step.
+
+*/
+
+#ifndef ATS_PK_NEWTON_CORRECTION_CONTROL_HH_
+#define ATS_PK_NEWTON_CORRECTION_CONTROL_HH_
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+
+#include "VerboseObject.hh"
+
+namespace Amanzi {
+
+class NewtonCorrectionControl {
+
+ public:
+  NewtonCorrectionControl(Teuchos::ParameterList& plist,
+                          const Teuchos::RCP<VerboseObject>& vo);
+
+  // Called at the start of each preconditioner update.  Returns true if the
+  // Newton correction should be included in this update.
+  bool UpdatePreconditioner(double t);
+
+  // Is the Newton correction included in the current preconditioner?
+  bool active() const { return active_; }
+
+  // Called with the error norm of each nonlinear iterate.
+  void ReportErrorNorm(double enorm) { last_enorm_ = enorm; }
+
+  // Called when a step is committed.  Writes statistics.
+  void CommitStep(double t_old, double t_new);
+
+  // statistics
+  int num_updates() const { return step_updates_; }
+  int num_updates_with_correction() const { return step_updates_on_; }
+  int num_switches() const { return step_switches_; }
+  int total_updates() const { return total_updates_; }
+  int total_updates_with_correction() const { return total_updates_on_; }
+
+ protected:
+  void BeginStep_(double t);
+  bool Decide_();
+
+ protected:
+  Teuchos::RCP<VerboseObject> vo_;
+
+  // control
+  int lag_;
+  bool adaptive_;
+  double contraction_threshold_;
+  double residual_threshold_;
+  double divergence_factor_;
+  int max_switches_;
+
+  // current step
+  double step_time_;
+  bool active_;
+  bool first_step_;
+  double last_enorm_;
+  double prev_enorm_;
+
+  // statistics
+  int step_updates_;
+  int step_updates_on_;
+  int step_switches_;
+  int total_updates_;
+  int total_updates_on_;
+  int total_switches_;
+};
+
+} // namespace
+
+#endif
@@ -28,6 +28,7 @@ void PK_BDF_Default::Setup(const Teuchos::Ptr<State>& S) {
 
   // preconditioner assembly
   assemble_preconditioner_ = plist_->get<bool>("assemble preconditioner", true);
+  pc_structure_ = Teuchos::rcp(new PreconditionerStructureMonitor(*plist_, vo_));
 
   if (!plist_->get<bool>("strongly coupled PK", false)) {
     Teuchos::ParameterList& bdf_plist = plist_->sublist("time integrator");
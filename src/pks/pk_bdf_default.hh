@@ -32,6 +32,9 @@ PKs.
     * `"preconditioner`" ``[preconditioner-typed-spec]`` **optional** A Preconditioner_.
       Note that this is only used if this PK is not strongly coupled to other PKs.
 
+    * `"fail on preconditioner structure rebuild`" ``[bool]`` **false** See
+      preconditioner-structure-spec_.
+
     INCLUDES:
 
     - ``[pk-spec]`` This *is a* PK_.
@@ -48,6 +51,7 @@ PKs.
 #include "BDFFnBase.hh"
 #include "BDF1_TI.hh"
 #include "PK_BDF.hh"
+#include "preconditioner_structure_monitor.hh"
 
 
 
@@ -116,6 +120,21 @@ class PK_BDF_Default : public PK_BDF {
 
   virtual void ResetTimeStepper(double time);
 
+  // -- Error norms, split into an on-process part and a global part so that
+  //    a coupler can reduce the norms of all of its sub-PKs at once.
+  //    ErrorNormLocal() appends this PK's local norms, and ErrorNormReduced()
+  //    is called with the max-reduced norms starting at position i, and
+  //    returns the position past this PK's norms.  By default the norm is
+  //    computed (and reduced) by ErrorNorm().
+  virtual void ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
+                              Teuchos::RCP<const TreeVector> du,
+                              std::vector<double>& norms) {
+    norms.push_back(ErrorNorm(u, du));
+  }
+  virtual int ErrorNormReduced(const std::vector<double>& norms, int i) {
+    return i+1;
+  }
+
   // experimental approach -- calling this indicates that the time
   // integration scheme is changing the value of the solution in
   // state.
@@ -126,6 +145,7 @@ class PK_BDF_Default : public PK_BDF {
  protected: // data
   // preconditioner assembly control
   bool assemble_preconditioner_;
+  Teuchos::RCP<PreconditionerStructureMonitor> pc_structure_;
 
   // timestep control
   double dt_;
@@ -48,6 +48,10 @@ void PK_PhysicalBDF_Default::Setup(const Teuchos::Ptr<State>& S) {
   atol_ = plist_->get<double>("absolute error tolerance",1.0);
   rtol_ = plist_->get<double>("relative error tolerance",1.0);
   fluxtol_ = plist_->get<double>("flux error tolerance",1.0);
+
+  // history-based predictors
+  if (plist_->isParameter("predictor type"))
+    predictor_ = Teuchos::rcp(new PredictorDelegateHistory(*plist_, vo_));
 };
 
 
@@ -64,6 +68,31 @@ void PK_PhysicalBDF_Default::Initialize(const Teuchos::Ptr<State>& S) {
   PK_Physical_Default::Initialize(S);
   PK_BDF_Default::Initialize(S);
 
+  if (predictor_ != Teuchos::null) predictor_->CommitStep(S->time(), *solution_);
+
+}
+
+
+// -----------------------------------------------------------------------------
+// Transfer operators, restarting the per-attempt statistics of delegates.
+// -----------------------------------------------------------------------------
+void PK_PhysicalBDF_Default::State_to_Solution(const Teuchos::RCP<State>& S,
+        TreeVector& solution) {
+  PK_Physical_Default::State_to_Solution(S, solution);
+  if (line_search_ != Teuchos::null) line_search_->StartAttempt();
+}
+
+
+// -----------------------------------------------------------------------------
+// Commit step, and report Newton correction, line search, and predictor
+// statistics.
+// -----------------------------------------------------------------------------
+void PK_PhysicalBDF_Default::CommitStep(double t_old, double t_new,
+        const Teuchos::RCP<State>& S) {
+  PK_BDF_Default::CommitStep(t_old, t_new, S);
+  if (newton_control_ != Teuchos::null) newton_control_->CommitStep(t_old, t_new);
+  if (line_search_ != Teuchos::null) line_search_->CommitStep();
+  if (predictor_ != Teuchos::null) predictor_->CommitStep(t_new, *solution_);
 }
 
 
@@ -72,6 +101,20 @@ void PK_PhysicalBDF_Default::Initialize(const Teuchos::Ptr<State>& S) {
 // -----------------------------------------------------------------------------
 double PK_PhysicalBDF_Default::ErrorNorm(Teuchos::RCP<const TreeVector> u,
         Teuchos::RCP<const TreeVector> res) {
+  std::vector<double> norms;
+  ErrorNormLocal(u, res, norms);
+  std::vector<double> norms_g(norms.size(), 0.);
+  mesh_->get_comm()->MaxAll(&norms[0], &norms_g[0], norms.size());
+  ErrorNormReduced(norms_g, 0);
+  return norms_g[0];
+};
+
+
+// -----------------------------------------------------------------------------
+// Local (on-process) part of the default enorm.
+// -----------------------------------------------------------------------------
+void PK_PhysicalBDF_Default::ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
+        Teuchos::RCP<const TreeVector> res, std::vector<double>& norms) {
   // Abs tol based on old conserved quantity -- we know these have been vetted
   // at some level whereas the new quantity is some iterate, and may be
   // anything from negative to overflow.
@@ -117,14 +160,12 @@ double PK_PhysicalBDF_Default::ErrorNorm(Teuchos::RCP<const TreeVector> u,
     } else if (*comp == std::string("face")) {
       // error in flux -- relative to cell's extensive conserved quantity
       int nfaces = dvec->size(*comp, false);
+      const auto& face_cells = ErrorNormFaceCells_();
 
       for (unsigned int f=0; f!=nfaces; ++f) {
-        AmanziMesh::Entity_ID_List cells;
-        mesh_->face_get_cells(f, AmanziMesh::Parallel_type::OWNED, &cells);
-        double cv_min = cells.size() == 1 ? cv[0][cells[0]]
-            : std::min(cv[0][cells[0]],cv[0][cells[1]]);
-        double conserved_min = cells.size() == 1 ? conserved[0][cells[0]]
-            : std::min(conserved[0][cells[0]],conserved[0][cells[1]]);
+        int c0 = face_cells[2*f], c1 = face_cells[2*f+1];
+        double cv_min = std::min(cv[0][c0], cv[0][c1]);
+        double conserved_min = std::min(conserved[0][c0], conserved[0][c1]);
       
         double enorm_f = fluxtol_ * h * std::abs(dvec_v[0][f])
             / (atol_*cv_min + rtol_*std::abs(conserved_min));
@@ -162,15 +203,39 @@ double PK_PhysicalBDF_Default::ErrorNorm(Teuchos::RCP<const TreeVector> u,
     enorm_val = std::max(enorm_val, enorm_comp);
   }
 
-  double enorm_val_l = enorm_val;
-
-  int ierr;
-  ierr = MPI_Allreduce(&enorm_val_l, &enorm_val, 1, MPI_DOUBLE, MPI_MAX, comm);
-  AMANZI_ASSERT(!ierr);
-  return enorm_val;
+  norms.push_back(enorm_val);
 };
 
 
+// -----------------------------------------------------------------------------
+// Receive the globally reduced enorm.
+// -----------------------------------------------------------------------------
+int PK_PhysicalBDF_Default::ErrorNormReduced(const std::vector<double>& norms, int i) {
+  if (newton_control_ != Teuchos::null) newton_control_->ReportErrorNorm(norms[i]);
+  if (predictor_ != Teuchos::null) predictor_->ReportErrorNorm(norms[i]);
+  return i+1;
+}
+
+
+// -----------------------------------------------------------------------------
+// Precompute the cells of each face, so that face error norms need not query
+// the mesh.  Faces with one cell repeat it, so the min over both is the cell.
+// -----------------------------------------------------------------------------
+const AmanziMesh::Entity_ID_List& PK_PhysicalBDF_Default::ErrorNormFaceCells_() {
+  int nfaces = mesh_->num_entities(AmanziMesh::FACE, AmanziMesh::Parallel_type::OWNED);
+  if (enorm_face_cells_.size() != 2*nfaces) {
+    enorm_face_cells_.resize(2*nfaces);
+    AmanziMesh::Entity_ID_List cells;
+    for (int f=0; f!=nfaces; ++f) {
+      mesh_->face_get_cells(f, AmanziMesh::Parallel_type::OWNED, &cells);
+      enorm_face_cells_[2*f] = cells[0];
+      enorm_face_cells_[2*f+1] = cells.size() == 1 ? cells[0] : cells[1];
+    }
+  }
+  return enorm_face_cells_;
+}
+
+
 // -----------------------------------------------------------------------------
 // Add a boundary marker to owned faces.
 // -----------------------------------------------------------------------------
@@ -46,6 +46,9 @@ code, so usually are not supplied by the user.
       flux.  Note that this default is often overridden by PKs with more physical
       values, and very rarely are these set by the user.
 
+    * `"predictor type`" ``[string]`` **optional** Selects a history-based
+      predictor, see predictor-spec_.  Only used by PKs that document it.
+
     INCLUDES:
 
     - ``[pk-bdf-default-spec]`` *Is a* `PK: BDF`_
@@ -64,6 +67,9 @@ code, so usually are not supplied by the user.
 
 #include "BCs.hh"
 #include "Operator.hh"
+#include "newton_correction_control.hh"
+#include "line_search_delegate.hh"
+#include "predictor_delegate_history.hh"
 
 namespace Amanzi {
 
@@ -90,6 +96,14 @@ class PK_PhysicalBDF_Default : public PK_BDF_Default,
 
   virtual void set_dt(double dt) override { dt_ = dt; }
 
+  // -- Called at the start of each attempt at a step, also within coupled
+  //    MPCs, so restarts the per-attempt statistics of delegates.
+  virtual void State_to_Solution(const Teuchos::RCP<State>& S,
+                                 TreeVector& soln) override;
+
+  // -- Commit any secondary (dependent) variables.
+  virtual void CommitStep(double t_old, double t_new, const Teuchos::RCP<State>& S) override;
+
   // initialize.  Note both BDFBase and PhysicalBase have initialize()
   // methods, so we need a unique overrider.
   virtual void Initialize(const Teuchos::Ptr<State>& S) override;
@@ -105,9 +119,15 @@ class PK_PhysicalBDF_Default : public PK_BDF_Default,
 
   // Default implementations of BDFFnBase methods.
   // -- Compute a norm on u-du and return the result.
+  //    This reduces the local norm from ErrorNormLocal().
   virtual double ErrorNorm(Teuchos::RCP<const TreeVector> u,
                        Teuchos::RCP<const TreeVector> du) override;
 
+  virtual void ErrorNormLocal(Teuchos::RCP<const TreeVector> u,
+                              Teuchos::RCP<const TreeVector> du,
+                              std::vector<double>& norms) override;
+  virtual int ErrorNormReduced(const std::vector<double>& norms, int i) override;
+
   virtual bool ValidStep() override {
     return PK_Physical_Default::ValidStep() && PK_BDF_Default::ValidStep();
   }
@@ -124,6 +144,10 @@ class PK_PhysicalBDF_Default : public PK_BDF_Default,
   virtual int BoundaryDirection(int face_id);
   virtual void ApplyBoundaryConditions_(const Teuchos::Ptr<CompositeVector>& u);
   
+  // -- the (one or two) owned cells of each owned face, flattened, for error
+  //    norms of face components.  Boundary faces repeat their cell.
+  const AmanziMesh::Entity_ID_List& ErrorNormFaceCells_();
+
   // PC operator access
   Teuchos::RCP<Operators::Operator> preconditioner() { return preconditioner_; }
 
@@ -139,10 +163,20 @@ class PK_PhysicalBDF_Default : public PK_BDF_Default,
   // BCs
   Teuchos::RCP<Operators::BCs> bc_;
 
+  // Newton correction control, used by PKs with a Jacobian option
+  Teuchos::RCP<NewtonCorrectionControl> newton_control_;
+
+  // line search globalization, used by PKs that support it
+  Teuchos::RCP<LineSearchDelegate> line_search_;
+
+  // history-based predictors, used by PKs that support them
+  Teuchos::RCP<PredictorDelegateHistory> predictor_;
+
   // error criteria
   Key conserved_key_;
   Key cell_vol_key_;
   double atol_, rtol_, fluxtol_;
+  AmanziMesh::Entity_ID_List enorm_face_cells_;
 
 };
 
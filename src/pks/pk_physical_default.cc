@@ -27,7 +27,11 @@ PK_Physical_Default::PK_Physical_Default(Teuchos::ParameterList& pk_tree,
   Teuchos::ParameterList& FElist = S->FEList();
   Teuchos::ParameterList& pv_sublist = FElist.sublist(key_);
   pv_sublist.set("evaluator name", key_);
-  pv_sublist.set("field evaluator type", "primary variable");
+  if (plist_->get<bool>("track changed entities", false)) {
+    pv_sublist.set("field evaluator type", "primary variable with change sets");
+  } else {
+    pv_sublist.set("field evaluator type", "primary variable");
+  }
 
   // primary variable max change
   max_valid_change_ = plist_->get<double>("max valid change", -1.0);
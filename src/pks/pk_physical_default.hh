@@ -31,6 +31,11 @@ all leaves of the PK tree will inherit from `PKPhysicalBase`.
       invalid and the timestep shrinks.  By default, any change is valid.
       Units are the same as the primary variable.
 
+    * `"track changed entities`" ``[bool]`` **false** Use a `"primary variable
+      with change sets`" evaluator, so that code modifying the primary
+      variable on a few cells may tell incremental evaluators (see
+      FusedPointwiseEvaluator) which ones.
+
     INCLUDES:
 
     - ``[pk-spec]`` This *is a* PK_.
@@ -0,0 +1,86 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/* -------------------------------------------------------------------------
+ATS
+
+License: see $ATS_DIR/COPYRIGHT
+Author: Ethan Coon
+
+Tracks the sparsity structure of assembled preconditioners.
+------------------------------------------------------------------------- */
+
+#include "errors.hh"
+#include "preconditioner_structure_monitor.hh"
+
+namespace Amanzi {
+
+PreconditionerStructureMonitor::PreconditionerStructureMonitor(Teuchos::ParameterList& plist,
+        const Teuchos::RCP<VerboseObject>& vo) :
+    vo_(vo),
+    total_rebuilds_(0)
+{
+  fail_on_rebuild_ = plist.get<bool>("fail on preconditioner structure rebuild", false);
+}
+
+
+void PreconditionerStructureMonitor::Record_(const std::string& label,
+        const Epetra_CrsMatrix& A) {
+  Structure s;
+  s.A = &A;
+  s.graph = &A.Graph();
+  s.nnz = A.NumGlobalNonzeros();
+
+  auto old = structures_.find(label);
+  if (old == structures_.end()) {
+    if (vo_->os_OK(Teuchos::VERB_HIGH)) {
+      Teuchos::OSTab tab = vo_->getOSTab();
+      *vo_->os() << "Preconditioner structure \"" << label << "\": " << A.NumGlobalRows()
+                 << " rows, " << s.nnz << " nonzeros" << std::endl;
+    }
+  } else {
+    Rebuilt_(label, "symbolic assembly", old->second.nnz, s.nnz);
+  }
+  structures_[label] = s;
+}
+
+
+bool PreconditionerStructureMonitor::Check_(const std::string& label,
+        const Epetra_CrsMatrix& A) {
+  auto s = structures_.find(label);
+  if (s == structures_.end()) {
+    Errors::Message msg;
+    msg << "PreconditionerStructureMonitor: \"" << label
+        << "\" was assembled without a recorded symbolic assembly.";
+    Exceptions::amanzi_throw(msg);
+  }
+
+  int nnz = A.NumGlobalNonzeros();
+  if (&A != s->second.A || &A.Graph() != s->second.graph || nnz != s->second.nnz) {
+    Rebuilt_(label, "changed during assembly", s->second.nnz, nnz);
+    s->second.A = &A;
+    s->second.graph = &A.Graph();
+    s->second.nnz = nnz;
+    return false;
+  }
+  return true;
+}
+
+
+void PreconditionerStructureMonitor::Rebuilt_(const std::string& label,
+        const std::string& reason, int nnz_old, int nnz_new) {
+  total_rebuilds_++;
+  if (vo_->os_OK(Teuchos::VERB_LOW)) {
+    Teuchos::OSTab tab = vo_->getOSTab();
+    *vo_->os() << "WARNING: preconditioner structure \"" << label << "\" rebuilt ("
+               << reason << "), nonzeros " << nnz_old << " --> " << nnz_new
+               << ", " << total_rebuilds_ << " rebuilds total" << std::endl;
+  }
+  if (fail_on_rebuild_) {
+    Errors::Message msg;
+    msg << "Preconditioner structure \"" << label << "\" rebuilt (" << reason
+        << "), and \"fail on preconditioner structure rebuild\" is set.";
+    Exceptions::amanzi_throw(msg);
+  }
+}
+
+} // namespace
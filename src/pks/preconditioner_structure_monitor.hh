@@ -0,0 +1,95 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! Tracks the sparsity structure of assembled preconditioners.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+
+/*!
+
+Symbolic assembly of an operator builds the graph of its matrix and the
+structure of its preconditioner.  This is done once, in Setup, and each
+preconditioner update then only refills the numeric values.  This object owns
+the symbolic assembly calls of a PK, so that any later rebuild of the
+structure is an explicit, logged event, and checks on each update that the
+structure of the assembled matrix has not changed behind our back.
+
+Rebuilds are written at `"low`" verbosity, so they show up in production
+runs.  Setting `"fail on preconditioner structure rebuild`" makes them an
+error instead, which is useful to confirm that a run never pays for a rebuild
+while time stepping.
+
+.. _preconditioner-structure-spec:
+.. admonition:: preconditioner-structure-spec
+
+    * `"fail on preconditioner structure rebuild`" ``[bool]`` **false** Throw
+      an error on any rebuild of a preconditioner's structure after its first
+      symbolic assembly.
+
+*/
+
+#ifndef ATS_PK_PRECONDITIONER_STRUCTURE_MONITOR_HH_
+#define ATS_PK_PRECONDITIONER_STRUCTURE_MONITOR_HH_
+
+#include <map>
+#include <string>
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Epetra_CrsMatrix.h"
+
+#include "VerboseObject.hh"
+
+namespace Amanzi {
+
+class PreconditionerStructureMonitor {
+
+ public:
+  PreconditionerStructureMonitor(Teuchos::ParameterList& plist,
+                                 const Teuchos::RCP<VerboseObject>& vo);
+
+  // Symbolic assembly of an Operator or TreeOperator.  Any but the first
+  // call for a given label is a (logged) rebuild.
+  template<class Op>
+  void SymbolicAssemble(const std::string& label, Op& op) {
+    op.SymbolicAssembleMatrix();
+    Record_(label, *op.A());
+  }
+
+  // Called after each assembly of values.  Returns true if the structure is
+  // the one recorded at symbolic assembly.
+  template<class Op>
+  bool Check(const std::string& label, Op& op) {
+    return Check_(label, *op.A());
+  }
+
+  // statistics
+  int num_rebuilds() const { return total_rebuilds_; }
+
+ protected:
+  void Record_(const std::string& label, const Epetra_CrsMatrix& A);
+  bool Check_(const std::string& label, const Epetra_CrsMatrix& A);
+  void Rebuilt_(const std::string& label, const std::string& reason,
+                int nnz_old, int nnz_new);
+
+ protected:
+  struct Structure {
+    const Epetra_CrsMatrix* A;
+    const Epetra_CrsGraph* graph;
+    int nnz;
+  };
+
+  Teuchos::RCP<VerboseObject> vo_;
+  bool fail_on_rebuild_;
+  std::map<std::string, Structure> structures_;
+  int total_rebuilds_;
+};
+
+} // namespace
+
+#endif
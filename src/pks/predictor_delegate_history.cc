@@ -0,0 +1,150 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/* -------------------------------------------------------------------------
+ATS
+
+License: see $ATS_DIR/COPYRIGHT
+Author: Ethan Coon
+
+Predictors for BDF1 PKs based on the history of committed solutions.
+------------------------------------------------------------------------- */
+
+#include <cmath>
+
+#include "errors.hh"
+#include "predictor_delegate_history.hh"
+
+namespace Amanzi {
+
+PredictorDelegateHistory::PredictorDelegateHistory(Teuchos::ParameterList& plist,
+        const Teuchos::RCP<VerboseObject>& vo) :
+    vo_(vo),
+    t_new_(0.),
+    h_prev_(0.),
+    have_correction_(false),
+    n_iters_(0),
+    enorm_first_(-1.),
+    enorm_last_(-1.),
+    total_steps_(0),
+    total_iters_(0),
+    total_saved_(0.)
+{
+  type_ = plist.get<std::string>("predictor type", "linear");
+  if (type_ != "linear" && type_ != "quadratic" &&
+      type_ != "previous correction" && type_ != "conserved variable") {
+    Errors::Message msg;
+    msg << "PredictorDelegateHistory: unknown \"predictor type\" \"" << type_
+        << "\", valid are \"linear\", \"quadratic\", \"previous correction\", and \"conserved variable\".";
+    Exceptions::amanzi_throw(msg);
+  }
+}
+
+
+// -----------------------------------------------------------------------------
+// Replace the linear extrapolant by the selected predictor.
+// -----------------------------------------------------------------------------
+bool PredictorDelegateHistory::ModifyPredictor(double t_new,
+        const Teuchos::RCP<TreeVector>& u) {
+  t_new_ = t_new;
+  if (linear_ == Teuchos::null) {
+    linear_ = Teuchos::rcp(new TreeVector(*u));
+  } else {
+    *linear_ = *u;
+  }
+
+  int n = history_size();
+  if (type_ == "quadratic" && n >= 3) {
+    double t0 = times_[n-3], t1 = times_[n-2], t2 = times_[n-1];
+    double L0 = (t_new - t1) * (t_new - t2) / ((t0 - t1) * (t0 - t2));
+    double L1 = (t_new - t0) * (t_new - t2) / ((t1 - t0) * (t1 - t2));
+    double L2 = (t_new - t0) * (t_new - t1) / ((t2 - t0) * (t2 - t1));
+    u->Update(L0, *solutions_[n-3], L1, *solutions_[n-2], 0.);
+    u->Update(L2, *solutions_[n-1], 1.);
+    return true;
+
+  } else if (type_ == "previous correction" && have_correction_ && n > 0 && h_prev_ > 0.) {
+    double h = t_new - times_[n-1];
+    double factor = (h / h_prev_) * (h / h_prev_);
+    u->Update(factor, *correction_, 1.);
+    return true;
+  }
+  return false;
+}
+
+
+void PredictorDelegateHistory::RecordPredictor(const TreeVector& u) {
+  if (predictor_ == Teuchos::null) {
+    predictor_ = Teuchos::rcp(new TreeVector(u));
+  } else {
+    *predictor_ = u;
+  }
+  n_iters_ = 0;
+  enorm_first_ = -1.;
+  enorm_last_ = -1.;
+}
+
+
+void PredictorDelegateHistory::ReportErrorNorm(double enorm) {
+  n_iters_++;
+  if (enorm_first_ < 0.) enorm_first_ = enorm;
+  enorm_last_ = enorm;
+}
+
+
+// -----------------------------------------------------------------------------
+// Measure the predictors and push the converged solution into the history.
+// -----------------------------------------------------------------------------
+void PredictorDelegateHistory::CommitStep(double t_new, const TreeVector& u) {
+  int n = history_size();
+  if (predictor_ != Teuchos::null && linear_ != Teuchos::null && n > 0) {
+    // error of the linear extrapolant, which is also the correction used by
+    // the "previous correction" predictor
+    if (correction_ == Teuchos::null) correction_ = Teuchos::rcp(new TreeVector(u));
+    correction_->Update(1., u, -1., *linear_, 0.);
+    double e_lin(0.);
+    correction_->NormInf(&e_lin);
+    h_prev_ = t_new - times_[n-1];
+    have_correction_ = true;
+
+    // error of the predictor actually used
+    linear_->Update(1., u, -1., *predictor_, 0.);
+    double e_pred(0.);
+    linear_->NormInf(&e_pred);
+
+    // estimate iterations saved from the observed contraction rate
+    double saved = 0.;
+    if (n_iters_ > 1 && enorm_first_ > 0. && enorm_last_ > 0.) {
+      double rho = std::pow(enorm_last_ / enorm_first_, 1. / (n_iters_ - 1));
+      if (rho > 0. && rho < 1. && e_pred > 0. && e_lin > 0.)
+        saved = std::log(e_lin / e_pred) / std::log(1. / rho);
+    }
+
+    total_steps_++;
+    total_iters_ += n_iters_;
+    total_saved_ += saved;
+
+    if (vo_->os_OK(Teuchos::VERB_HIGH)) {
+      Teuchos::OSTab tab = vo_->getOSTab();
+      *vo_->os() << "Predictor (" << type_ << "): error = " << e_pred
+                 << " (linear: " << e_lin << "), " << n_iters_
+                 << " iterations, est. saved = " << saved << " (total: "
+                 << total_saved_ << " saved over " << total_steps_ << " steps, "
+                 << total_iters_ << " iterations)" << std::endl;
+    }
+  }
+
+  // push the converged solution, recycling the oldest vector
+  Teuchos::RCP<TreeVector> soln;
+  if (n == 3) {
+    soln = solutions_.front();
+    solutions_.pop_front();
+    times_.pop_front();
+    *soln = u;
+  } else {
+    soln = Teuchos::rcp(new TreeVector(u));
+  }
+  solutions_.push_back(soln);
+  times_.push_back(t_new);
+}
+
+} // namespace
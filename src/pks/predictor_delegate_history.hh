@@ -0,0 +1,112 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! Predictors for BDF1 PKs based on the history of committed solutions.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+
+/*!
+
+The BDF1 time integrator starts each nonlinear solve from a linear
+extrapolation of the last two solutions.  This delegate keeps a short history
+of committed solutions and replaces that initial guess by one of:
+
+- `"linear`" Leave the time integrator's linear extrapolant alone.
+- `"quadratic`" Quadratic (Lagrange) extrapolation through the three most
+  recent solutions.  Falls back to linear until three solutions exist.
+- `"previous correction`" Adds to the linear extrapolant the total Newton
+  correction of the previous step (the converged solution minus its
+  predictor), scaled by :math:`(h / h_{prev})^2`, the scaling of the
+  extrapolation error.
+- `"conserved variable`" Extrapolates in the conserved variable and inverts
+  to the primary variable.  This is PK-specific and only supported by PKs that
+  document it (e.g. Richards, where it is the water content predictor).
+
+At each committed step, the error of the predictor actually used and of the
+linear extrapolant are measured against the converged solution.  Together
+with the observed contraction rate of the nonlinear iteration, this gives an
+estimate of the number of nonlinear iterations saved relative to the linear
+extrapolant, :math:`\log(e_{lin}/e_{pred}) / \log(1/\rho)`.  These are written
+at `"high`" verbosity.
+
+.. _predictor-spec:
+.. admonition:: predictor-spec
+
+    * `"predictor type`" ``[string]`` **linear** One of the above.
+
+*/
+
+#ifndef ATS_PK_PREDICTOR_DELEGATE_HISTORY_HH_
+#define ATS_PK_PREDICTOR_DELEGATE_HISTORY_HH_
+
+#include <deque>
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+
+#include "VerboseObject.hh"
+#include "TreeVector.hh"
+
+namespace Amanzi {
+
+class PredictorDelegateHistory {
+
+ public:
+  PredictorDelegateHistory(Teuchos::ParameterList& plist,
+                           const Teuchos::RCP<VerboseObject>& vo);
+
+  const std::string& type() const { return type_; }
+
+  // On entry u is the linear extrapolant to t_new, on exit it is the
+  // selected predictor.  Returns true if u was modified.
+  bool ModifyPredictor(double t_new, const Teuchos::RCP<TreeVector>& u);
+
+  // Store the final predictor, after any physics-based modifications.
+  void RecordPredictor(const TreeVector& u);
+
+  // Called with the error norm of each nonlinear iterate.
+  void ReportErrorNorm(double enorm);
+
+  // Called with the converged solution when a step is committed.
+  void CommitStep(double t_new, const TreeVector& u);
+
+  // history, most recent last
+  int history_size() const { return times_.size(); }
+  double time(int i) const { return times_[i]; }
+  const TreeVector& solution(int i) const { return *solutions_[i]; }
+
+  // statistics
+  double iterations_saved() const { return total_saved_; }
+
+ protected:
+  std::string type_;
+  Teuchos::RCP<VerboseObject> vo_;
+
+  // committed solutions, most recent last
+  std::deque<double> times_;
+  std::deque<Teuchos::RCP<TreeVector> > solutions_;
+
+  // current step
+  double t_new_;
+  Teuchos::RCP<TreeVector> linear_;
+  Teuchos::RCP<TreeVector> predictor_;
+  Teuchos::RCP<TreeVector> correction_;
+  double h_prev_;
+  bool have_correction_;
+  int n_iters_;
+  double enorm_first_, enorm_last_;
+
+  // statistics
+  int total_steps_;
+  int total_iters_;
+  double total_saved_;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,103 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/* -------------------------------------------------------------------------
+ATS
+
+License: see $ATS_DIR/COPYRIGHT
+Author: Ethan Coon
+
+Batches the small global reductions of a PK tree into one collective.
+------------------------------------------------------------------------- */
+
+#include "errors.hh"
+#include "reduction_aggregator.hh"
+
+namespace Amanzi {
+
+ReductionAggregator::ReductionAggregator(const Comm_ptr_type& comm) :
+    request_(MPI_REQUEST_NULL),
+    started_(false),
+    finished_(false),
+    num_collectives_(0),
+    num_values_(0)
+{
+  Teuchos::RCP<const MpiComm_type> mpi_comm =
+    Teuchos::rcp_dynamic_cast<const MpiComm_type>(comm);
+  if (mpi_comm == Teuchos::null) {
+    Errors::Message msg("ReductionAggregator: requires an MPI communicator.");
+    Exceptions::amanzi_throw(msg);
+  }
+  comm_ = mpi_comm->Comm();
+}
+
+
+ReductionAggregator::~ReductionAggregator() {
+  if (started_ && !finished_) MPI_Wait(&request_, MPI_STATUS_IGNORE);
+}
+
+
+void ReductionAggregator::Reset() {
+  if (started_ && !finished_) {
+    Errors::Message msg("ReductionAggregator: Reset() called on an unfinished reduction.");
+    Exceptions::amanzi_throw(msg);
+  }
+  local_.clear();
+  global_.clear();
+  started_ = false;
+  finished_ = false;
+}
+
+
+int ReductionAggregator::AddMin(double val) {
+  if (started_) {
+    Errors::Message msg("ReductionAggregator: contribution added after Start().");
+    Exceptions::amanzi_throw(msg);
+  }
+  local_.push_back(val);
+  return local_.size() - 1;
+}
+
+
+int ReductionAggregator::AddMax(double val) {
+  return AddMin(-val);
+}
+
+
+int ReductionAggregator::AddFlag(bool flag) {
+  return AddMax(flag ? 1. : 0.);
+}
+
+
+// -----------------------------------------------------------------------------
+// Post the reduction of everything added since Reset().
+// -----------------------------------------------------------------------------
+void ReductionAggregator::Start() {
+  global_.resize(local_.size());
+  started_ = true;
+  finished_ = false;
+  if (local_.size() == 0) return;
+
+  MPI_Iallreduce(&local_[0], &global_[0], local_.size(), MPI_DOUBLE, MPI_MIN,
+                 comm_, &request_);
+  num_collectives_++;
+  num_values_ += local_.size();
+}
+
+
+void ReductionAggregator::Finish() {
+  if (!started_) {
+    Errors::Message msg("ReductionAggregator: Finish() called before Start().");
+    Exceptions::amanzi_throw(msg);
+  }
+  if (!finished_ && local_.size() > 0) MPI_Wait(&request_, MPI_STATUS_IGNORE);
+  finished_ = true;
+}
+
+
+double ReductionAggregator::Min(int i) const {
+  AMANZI_ASSERT(finished_);
+  AMANZI_ASSERT(i >= 0 && i < global_.size());
+  return global_[i];
+}
+
+} // namespace
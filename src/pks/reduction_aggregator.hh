@@ -0,0 +1,90 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! Batches the small global reductions of a PK tree into one collective.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+
+/*!
+
+Time step proposals, failure flags and admissibility flags are each a single
+number per PK, but when the PKs of a tree are distributed differently (e.g.
+one serial column PK per cell of a distributed surface mesh) each of them is
+reduced globally.  These reductions are latency bound, so at large process
+counts they are a measurable share of a cycle.
+
+This aggregator collects the local contributions of one phase (e.g. the end
+of AdvanceStep()) and reduces them all in one nonblocking collective.  Max
+reductions are stored negated, so that everything is a single MPI_MIN over
+doubles.  The usual pattern is:
+
+.. code-block:: c++
+
+    red.Reset();
+    int i_dt = red.AddMin(dt_local);
+    int i_fail = red.AddFlag(fail_local);
+    red.Start();
+    // ... local work that does not need the result ...
+    red.Finish();
+    double dt = red.Min(i_dt);
+
+*/
+
+#ifndef ATS_PK_REDUCTION_AGGREGATOR_HH_
+#define ATS_PK_REDUCTION_AGGREGATOR_HH_
+
+#include <vector>
+#include "mpi.h"
+
+#include "Teuchos_RCP.hpp"
+#include "AmanziComm.hh"
+
+namespace Amanzi {
+
+class ReductionAggregator {
+
+ public:
+  explicit ReductionAggregator(const Comm_ptr_type& comm);
+  ~ReductionAggregator();
+
+  // Clear all contributions, starting a new phase.
+  void Reset();
+
+  // Add local contributions, returning the index of the reduced value.
+  int AddMin(double val);
+  int AddMax(double val);
+  int AddFlag(bool flag);  // reduced as a logical or
+
+  // Reduce all contributions of this phase in one collective.
+  void Start();
+  void Finish();
+  void Reduce() { Start(); Finish(); }
+
+  // Reduced values, valid after Finish().
+  double Min(int i) const;
+  double Max(int i) const { return -Min(i); }
+  bool Flag(int i) const { return Max(i) > 0.; }
+
+  // statistics
+  int num_collectives() const { return num_collectives_; }
+  int num_values() const { return num_values_; }
+
+ protected:
+  MPI_Comm comm_;
+  std::vector<double> local_;
+  std::vector<double> global_;
+  MPI_Request request_;
+  bool started_, finished_;
+
+  int num_collectives_;
+  int num_values_;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,31 @@
+/*
+  The evaporation downregulation via soil resistance evaluator, an algebraic
+  evaluator of EvaporationDownregulationADModel differentiated automatically.
+
+  This is opt-in, as "evaporation downregulation via soil resistance,
+  automatic differentiation".  The default, hand-written evaluator is
+  EvaporationDownregulationEvaluator.  The kernel is the same model, for use
+  in a FusedPointwiseEvaluator.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#ifndef AMANZI_SEB_EVAPORATION_DOWNREGULATION_AD_EVALUATOR_HH_
+#define AMANZI_SEB_EVAPORATION_DOWNREGULATION_AD_EVALUATOR_HH_
+
+#include "ad_model_evaluator.hh"
+#include "ad_model_kernel.hh"
+#include "evaporation_downregulation_ad_model.hh"
+
+namespace Amanzi {
+namespace SurfaceBalance {
+namespace Relations {
+
+typedef ADModelEvaluator<EvaporationDownregulationADModel> EvaporationDownregulationADEvaluator;
+typedef ADModelKernel<EvaporationDownregulationADModel> EvaporationDownregulationKernel;
+
+} //namespace
+} //namespace
+} //namespace
+
+#endif
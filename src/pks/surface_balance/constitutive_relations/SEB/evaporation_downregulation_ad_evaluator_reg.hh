@@ -0,0 +1,13 @@
+#include "evaporation_downregulation_ad_evaluator.hh"
+
+namespace Amanzi {
+
+template<>
+Utils::RegisteredFactory<FieldEvaluator,ADModelEvaluator<SurfaceBalance::Relations::EvaporationDownregulationADModel> >
+ADModelEvaluator<SurfaceBalance::Relations::EvaporationDownregulationADModel>::reg_("evaporation downregulation via soil resistance, automatic differentiation");
+
+template<>
+Utils::RegisteredFactory<Relations::PointwiseKernel,ADModelKernel<SurfaceBalance::Relations::EvaporationDownregulationADModel> >
+ADModelKernel<SurfaceBalance::Relations::EvaporationDownregulationADModel>::reg_("evaporation downregulation via soil resistance");
+
+} //namespace
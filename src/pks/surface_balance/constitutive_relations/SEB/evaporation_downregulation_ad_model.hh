@@ -0,0 +1,59 @@
+/*
+  The evaporation downregulation via soil resistance model, differentiated
+  automatically.
+
+  Downregulates evaporation from a potential, by the soil resistance of
+  Sakagucki and Zeng 2009.  Unlike EvaporationDownregulationModel, whose
+  partial derivatives with respect to saturation of gas and porosity are
+  taken to be zero, all partial derivatives are computed by the
+  ADModelEvaluator from the model on dual numbers.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#ifndef AMANZI_SEB_EVAPORATION_DOWNREGULATION_AD_MODEL_HH_
+#define AMANZI_SEB_EVAPORATION_DOWNREGULATION_AD_MODEL_HH_
+
+#include <string>
+#include <vector>
+
+#include "Teuchos_ParameterList.hpp"
+
+#include "seb_physics_funcs.hh"
+
+namespace Amanzi {
+namespace SurfaceBalance {
+namespace Relations {
+
+class EvaporationDownregulationADModel {
+
+ public:
+  static const int num_args = 3;
+  static std::string name() { return "evaporation_downregulation"; }
+  static std::vector<std::string> arguments() {
+    return { "saturation_gas", "porosity", "potential_evaporation" };
+  }
+
+  explicit
+  EvaporationDownregulationADModel(Teuchos::ParameterList& plist) {
+    dess_dz_ = plist.get<double>("dessicated zone thickness [m]", 0.1);
+    Clapp_Horn_b_ = plist.get<double>("Clapp and Hornberger b of surface soil [-]", 1.0);
+  }
+
+  // evaporation, given saturation of gas, porosity and potential evaporation
+  template<class Scalar>
+  Scalar operator()(const Scalar* x) const {
+    return x[2] / (1. + SEBPhysics::EvaporativeResistanceCoef(x[0], x[1], dess_dz_, Clapp_Horn_b_));
+  }
+
+ protected:
+  double dess_dz_;
+  double Clapp_Horn_b_;
+
+};
+
+} //namespace
+} //namespace
+} //namespace
+
+#endif
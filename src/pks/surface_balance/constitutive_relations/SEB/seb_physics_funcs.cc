@@ -128,25 +128,6 @@ double EvaporativeResistanceGround(const GroundProperties& surf,
   }
 }
 
-double EvaporativeResistanceCoef(double saturation_gas,
-        double porosity, double dessicated_zone_thickness, double Clapp_Horn_b) {
-  double Rsoil;
-  if (saturation_gas == 0.) {
-    Rsoil = 0.; // ponded water
-  } else {
-    // Equation for reduced vapor diffusivity
-    // See Sakagucki and Zeng 2009 eqaution (9) and Moldrup et al., 2004. 
-    double vp_diffusion = 0.000022 * (std::pow(porosity,2))
-                          * std::pow((1-(0.0556/porosity)),(2+3*Clapp_Horn_b));
-    // Sakagucki and Zeng 2009 eqaution (10)
-    double L_Rsoil = std::exp(std::pow(saturation_gas, 5));
-    L_Rsoil = dessicated_zone_thickness * (L_Rsoil -1) * (1/(std::exp(1.)-1));
-    Rsoil = L_Rsoil/vp_diffusion;
-  }
-  return Rsoil;
-}
-
-
 double SensibleHeat(double resistance_coef,
                     double density_air,
                     double Cp_air,
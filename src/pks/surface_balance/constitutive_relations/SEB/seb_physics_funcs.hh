@@ -86,8 +86,28 @@ double EvaporativeResistanceGround(const GroundProperties& surf,
         const ModelParams& params, 
         double vapor_pressure_air, double vapor_pressure_ground);
 
-double EvaporativeResistanceCoef(double saturation_gas,
-        double porosity, double dessicated_zone_thickness, double Clapp_Horn_b);
+// Templated on the scalar type, so that it may be differentiated with dual
+// numbers (see dual.hh).
+template<class Scalar>
+Scalar EvaporativeResistanceCoef(const Scalar& saturation_gas,
+        const Scalar& porosity, double dessicated_zone_thickness, double Clapp_Horn_b) {
+  using std::pow;
+  using std::exp;
+  Scalar Rsoil;
+  if (saturation_gas == 0.) {
+    Rsoil = 0.; // ponded water
+  } else {
+    // Equation for reduced vapor diffusivity
+    // See Sakagucki and Zeng 2009 eqaution (9) and Moldrup et al., 2004. 
+    Scalar vp_diffusion = 0.000022 * (pow(porosity,2))
+                          * pow((1-(0.0556/porosity)),(2+3*Clapp_Horn_b));
+    // Sakagucki and Zeng 2009 eqaution (10)
+    Scalar L_Rsoil = exp(pow(saturation_gas, 5));
+    L_Rsoil = dessicated_zone_thickness * (L_Rsoil -1) * (1/(std::exp(1.)-1));
+    Rsoil = L_Rsoil/vp_diffusion;
+  }
+  return Rsoil;
+}
 
 
 // 
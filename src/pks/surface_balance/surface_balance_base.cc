@@ -84,7 +84,7 @@ SurfaceBalanceBase::Setup(const Teuchos::Ptr<State>& S) {
   //    symbolic assemble
   precon_used_ = plist_->isSublist("preconditioner");
   if (precon_used_) {
-    preconditioner_->SymbolicAssembleMatrix();
+    pc_structure_->SymbolicAssemble(name_, *preconditioner_);
     preconditioner_->InitializePreconditioner(plist_->sublist("preconditioner"));
   }
 
@@ -220,6 +220,7 @@ SurfaceBalanceBase::UpdatePreconditioner(double t,
 
     if (precon_used_) {
       preconditioner_->AssembleMatrix();
+      pc_structure_->Check(name_, *preconditioner_);
       preconditioner_->UpdatePreconditioner();
     }
   }
@@ -0,0 +1,14 @@
+#include <UnitTest++.h>
+#include <TestReporterStdout.h>
+#include <mpi.h>
+#include "Teuchos_GlobalMPISession.hpp"
+
+#include "state_evaluators_registration.hh"
+#include "VerboseObject_objs.hh"
+
+int main(int argc, char *argv[])
+{
+  Teuchos::GlobalMPISession mpiSession(&argc,&argv);
+  return UnitTest::RunAllTests ();
+}
+
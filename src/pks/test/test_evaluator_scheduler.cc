@@ -0,0 +1,209 @@
+/*
+  EvaluatorScheduler on a small DAG of a State: grouping of roots sharing
+  evaluators, pruning of roots depending on excluded keys, rethrow of an
+  evaluator's exception, and equivalence with updating the roots one after
+  the other.
+*/
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "UnitTest++.h"
+
+#include "Teuchos_ParameterList.hpp"
+#include "Teuchos_RCP.hpp"
+
+#include "AmanziComm.hh"
+#include "MeshFactory.hh"
+#include "State.hh"
+#include "primary_variable_field_evaluator.hh"
+#include "secondary_variable_field_evaluator.hh"
+
+#include "AdditiveEvaluator.hh"
+#include "errors.hh"
+#include "evaluator_scheduler.hh"
+
+namespace {
+
+using namespace Amanzi;
+
+// An evaluator of one dependency which always fails.
+class ThrowingEvaluator : public SecondaryVariableFieldEvaluator {
+ public:
+  explicit ThrowingEvaluator(Teuchos::ParameterList& plist) :
+      SecondaryVariableFieldEvaluator(plist) {
+    dependencies_.insert(plist.get<std::string>("dependency"));
+  }
+  ThrowingEvaluator(const ThrowingEvaluator& other) = default;
+
+  virtual Teuchos::RCP<FieldEvaluator> Clone() const {
+    return Teuchos::rcp(new ThrowingEvaluator(*this));
+  }
+
+ protected:
+  virtual void EvaluateField_(const Teuchos::Ptr<State>& S,
+                              const Teuchos::Ptr<CompositeVector>& result) {
+    Errors::Message msg("ThrowingEvaluator: failed as intended.");
+    Exceptions::amanzi_throw(msg);
+  }
+  virtual void EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
+          Key wrt_key, const Teuchos::Ptr<CompositeVector>& result) {}
+};
+
+
+// Primary variables a, b and x, and
+//   a1 = a,  a2 = a1 + a,  b1 = b,  x1 = x + b,
+// so that a1 and a2 share evaluators, b1 and x1 share b, and if given
+//   bad = fails(a)
+Teuchos::RCP<State>
+CreateState(const Teuchos::RCP<AmanziMesh::Mesh>& mesh, bool with_bad)
+{
+  Teuchos::ParameterList state_plist;
+  Teuchos::RCP<State> S = Teuchos::rcp(new State(state_plist));
+  S->RegisterDomainMesh(mesh);
+
+  std::vector<Key> primaries = { "a", "b", "x" };
+  for (const auto& key : primaries) {
+    S->RequireField(key, key)->SetMesh(mesh)->SetGhosted()
+        ->SetComponent("cell", AmanziMesh::CELL, 1);
+    Teuchos::ParameterList pv_plist;
+    pv_plist.set<std::string>("evaluator name", key);
+    S->SetFieldEvaluator(key, Teuchos::rcp(new PrimaryVariableFieldEvaluator(pv_plist)));
+  }
+
+  std::vector<std::pair<Key, std::vector<std::string> > > sums = {
+    { "a1", { "a" } }, { "a2", { "a1", "a" } }, { "b1", { "b" } }, { "x1", { "x", "b" } } };
+  std::vector<Key> secondaries;
+  for (const auto& sum : sums) {
+    Teuchos::ParameterList plist(sum.first);
+    plist.set("evaluator dependencies", Teuchos::Array<std::string>(sum.second));
+    S->SetFieldEvaluator(sum.first, Teuchos::rcp(new Relations::AdditiveEvaluator(plist)));
+    secondaries.push_back(sum.first);
+  }
+
+  if (with_bad) {
+    Teuchos::ParameterList plist("bad");
+    plist.set<std::string>("dependency", "a");
+    S->SetFieldEvaluator("bad", Teuchos::rcp(new ThrowingEvaluator(plist)));
+    secondaries.push_back("bad");
+  }
+
+  for (const auto& key : secondaries) {
+    S->RequireField(key, key)->SetMesh(mesh)->SetGhosted()
+        ->SetComponent("cell", AmanziMesh::CELL, 1);
+    S->RequireFieldEvaluator(key)->EnsureCompatibility(S.ptr());
+  }
+  S->Setup();
+
+  double value = 1.;
+  for (const auto& key : primaries) {
+    S->GetFieldData(key, key)->PutScalar(value);
+    value *= 2.;
+    S->GetField(key, key)->set_initialized();
+    Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>(S->GetFieldEvaluator(key))
+        ->SetFieldAsChanged(S.ptr());
+  }
+  return S;
+}
+
+
+Teuchos::RCP<AmanziMesh::Mesh>
+CreateMesh()
+{
+  auto comm = getDefaultComm();
+  AmanziMesh::MeshFactory factory(comm);
+  return factory.create(0., 0., 0., 1., 1., 1., 2, 2, 2);
+}
+
+
+void
+CheckEqual(const CompositeVector& expected, const CompositeVector& cv)
+{
+  const Epetra_MultiVector& expected_v = *expected.ViewComponent("cell", false);
+  const Epetra_MultiVector& cv_v = *cv.ViewComponent("cell", false);
+  for (int c=0; c!=cv_v.MyLength(); ++c) CHECK_EQUAL(expected_v[0][c], cv_v[0][c]);
+}
+
+} // namespace
+
+
+TEST(EVALUATOR_SCHEDULER_GROUPS) {
+  auto mesh = CreateMesh();
+  auto S = CreateState(mesh, false);
+
+  // x1 depends on the excluded x, and is dropped, so b1 is alone
+  KeySet excluded = { "x" };
+  EvaluatorScheduler scheduler("test", { "a1", "b1", "a2", "x1" }, excluded);
+  scheduler.Setup(S.ptr());
+  CHECK(scheduler.is_setup());
+
+  const std::vector<std::vector<Key> >& groups = scheduler.get_groups();
+  CHECK_EQUAL(2, (int) groups.size());
+  CHECK(groups[0] == std::vector<Key>({ "a1", "a2" }));
+  CHECK(groups[1] == std::vector<Key>({ "b1" }));
+
+  // without exclusions, x1 joins b1 through b
+  EvaluatorScheduler scheduler2("test2", { "a1", "b1", "a2", "x1" }, KeySet());
+  scheduler2.Setup(S.ptr());
+  CHECK_EQUAL(2, (int) scheduler2.get_groups().size());
+  CHECK(scheduler2.get_groups()[1] == std::vector<Key>({ "b1", "x1" }));
+
+  // groups never run concurrently on more than one process
+  if (mesh->get_comm()->NumProc() > 1) CHECK(!scheduler.concurrent());
+
+  // a root without an evaluator is an error
+  EvaluatorScheduler scheduler3("test3", { "a1", "missing" }, KeySet());
+  CHECK_THROW(scheduler3.Setup(S.ptr()), std::exception);
+}
+
+
+TEST(EVALUATOR_SCHEDULER_SERIAL_EQUIVALENCE) {
+  auto mesh = CreateMesh();
+  auto S = CreateState(mesh, false);
+  auto S_serial = CreateState(mesh, false);
+
+  std::vector<Key> roots = { "a1", "b1", "a2" };
+  EvaluatorScheduler scheduler("test", roots, KeySet());
+
+  // the first Update() sets up, and computes every root
+  CHECK(scheduler.Update(S.ptr()));
+  CHECK(scheduler.is_setup());
+  for (const auto& root : roots) {
+    S_serial->GetFieldEvaluator(root)->HasFieldChanged(S_serial.ptr(), "test");
+    CheckEqual(*S_serial->GetFieldData(root), *S->GetFieldData(root));
+  }
+
+  // nothing has changed since
+  CHECK(!scheduler.Update(S.ptr()));
+
+  // a change in one branch updates it only
+  S->GetFieldData("b", "b")->PutScalar(5.);
+  Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>(S->GetFieldEvaluator("b"))
+      ->SetFieldAsChanged(S.ptr());
+  CHECK(scheduler.Update(S.ptr()));
+  CHECK(!S->GetFieldEvaluator("a2")->HasFieldChanged(S.ptr(), "test scheduler"));
+
+  S_serial->GetFieldData("b", "b")->PutScalar(5.);
+  Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>(S_serial->GetFieldEvaluator("b"))
+      ->SetFieldAsChanged(S_serial.ptr());
+  for (const auto& root : roots) {
+    S_serial->GetFieldEvaluator(root)->HasFieldChanged(S_serial.ptr(), "test");
+    CheckEqual(*S_serial->GetFieldData(root), *S->GetFieldData(root));
+  }
+}
+
+
+TEST(EVALUATOR_SCHEDULER_RETHROWS) {
+  auto mesh = CreateMesh();
+  auto S = CreateState(mesh, true);
+
+  // the failing root is in its own group, after a group which succeeds
+  EvaluatorScheduler scheduler("test", { "b1", "bad" }, KeySet());
+  scheduler.Setup(S.ptr());
+  CHECK_EQUAL(2, (int) scheduler.get_groups().size());
+  CHECK_THROW(scheduler.Update(S.ptr()), Errors::Message);
+
+  // the other group was still brought up to date
+  const Epetra_MultiVector& b1 = *S->GetFieldData("b1")->ViewComponent("cell", false);
+  CHECK_EQUAL(2., b1[0][0]);
+}
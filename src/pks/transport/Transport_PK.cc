@@ -33,6 +33,7 @@
 #include "PDE_Accumulation.hh"
 #include "PK_DomainFunctionFactory.hh"
 #include "PK_Utils.hh"
+#include "parallel_for.hh"
 
 #include "MultiscaleTransportPorosityFactory.hh"
 #include "Transport_PK_ATS.hh"
@@ -346,6 +347,9 @@ void Transport_PK_ATS::Initialize(const Teuchos::Ptr<State>& S)
 
   IdentifyUpwindCells();
 
+  // split-phase ghost exchange of concentrations
+  cell_scatter_ = Teuchos::rcp(new Operators::GhostScatter(mesh_->cell_map(false), mesh_->cell_map(true)));
+
   // advection block initialization
   current_component_ = -1;
 
@@ -1264,40 +1268,41 @@ void Transport_PK_ATS::AdvanceDonorUpwind(double dt_cycle)
   mass_solutes_bc_.assign(num_aqueous + num_gaseous, 0.0);
 
   // populating next state of concentrations
-  tcc->ScatterMasterToGhosted("cell");
   Epetra_MultiVector& tcc_prev = *tcc->ViewComponent("cell", true);
   Epetra_MultiVector& tcc_next = *tcc_tmp->ViewComponent("cell", true);
 
+  // Ghost concentrations are only needed on faces whose upwind cell is a
+  // ghost, so their exchange is overlapped with the work on owned cells.
+  cell_scatter_->Begin(tcc_prev);
+
   // prepare conservative state in master and slave cells
-  double vol_phi_ws_den, tcc_flux;
+  double tcc_flux;
   double mass_start = 0., tmp1, mass;
 
   // We advect only aqueous components.
   int num_advect = num_aqueous;
 
-  for (int c = 0; c < ncells_owned; c++) {
-    vol_phi_ws_den = mesh_->cell_volume(c) * (*phi_)[0][c] * (*ws_start)[0][c] * (*mol_dens_start)[0][c];
-    for (int i = 0; i < num_advect; i++){
-      (*conserve_qty_)[i][c] = tcc_prev[i][c] * vol_phi_ws_den;
-      if ((vol_phi_ws_den > water_tolerance_) && ((*solid_qty_)[i][c] > 0 )){   // Desolve solid residual into liquid
-        double add_mass = std::min((*solid_qty_)[i][c], max_tcc_* vol_phi_ws_den - (*conserve_qty_)[i][c]);
-        (*solid_qty_)[i][c] -= add_mass;
-        (*conserve_qty_)[i][c] += add_mass;
+  // cell volumes, outside of the threaded loops as the mesh caches them
+  std::vector<double> vol(ncells_owned);
+  for (int c = 0; c < ncells_owned; c++) vol[c] = mesh_->cell_volume(c);
+
+  mass_start = Threading::parallel_sum(ncells_owned, [&](int c) {
+      double vol_phi_ws_den = vol[c] * (*phi_)[0][c] * (*ws_start)[0][c] * (*mol_dens_start)[0][c];
+      double mass_c = 0.;
+      for (int i = 0; i < num_advect; i++){
+        (*conserve_qty_)[i][c] = tcc_prev[i][c] * vol_phi_ws_den;
+        if ((vol_phi_ws_den > water_tolerance_) && ((*solid_qty_)[i][c] > 0 )){   // Desolve solid residual into liquid
+          double add_mass = std::min((*solid_qty_)[i][c], max_tcc_* vol_phi_ws_den - (*conserve_qty_)[i][c]);
+          (*solid_qty_)[i][c] -= add_mass;
+          (*conserve_qty_)[i][c] += add_mass;
+        }
+        mass_c += (*conserve_qty_)[i][c];
       }
-      mass_start += (*conserve_qty_)[i][c];
-    }
-  }
+      return mass_c;
+    });
 
-  tmp1 = mass_start;
-  mesh_->get_comm()->SumAll(&tmp1, &mass_start, 1);
-
-  if (vo_->getVerbLevel() >= Teuchos::VERB_EXTREME){
-    if (domain_name_ == "surface")  *vo_->os()<<std::setprecision(10)<<"Surface mass start "<<mass_start<<"\n";
-    else  *vo_->os()<<std::setprecision(10)<<"Subsurface mass start "<<mass_start<<"\n";
-  }
-
-  
-  // advance all components at once
+  // advance all components at once, first on faces with an owned upwind cell
+  ghost_upwind_faces_.clear();
   for (int f = 0; f < nfaces_wghost; f++) {  // loop over master and slave faces
     int c1 = (*upwind_cell_)[f];
     int c2 = (*downwind_cell_)[f];
@@ -1321,14 +1326,32 @@ void Transport_PK_ATS::AdvanceDonorUpwind(double dt_cycle)
       }
 
     } else if (c1 >= ncells_owned && c2 >= 0 && c2 < ncells_owned) {
-      for (int i = 0; i < num_advect; i++) {
-        tcc_flux = dt_ * u * tcc_prev[i][c1];
-        (*conserve_qty_)[i][c2] += tcc_flux;
-      }
+      ghost_upwind_faces_.push_back(f);
     }
   }
 
- 
+  // then on faces whose upwind cell is a ghost
+  cell_scatter_->End();
+  for (int f : ghost_upwind_faces_) {
+    int c1 = (*upwind_cell_)[f];
+    int c2 = (*downwind_cell_)[f];
+
+    double u = fabs((*flux_)[0][f]);
+    for (int i = 0; i < num_advect; i++) {
+      tcc_flux = dt_ * u * tcc_prev[i][c1];
+      (*conserve_qty_)[i][c2] += tcc_flux;
+    }
+  }
+
+  // the global sum is a collective, so it waits until the exchange is done
+  tmp1 = mass_start;
+  mesh_->get_comm()->SumAll(&tmp1, &mass_start, 1);
+
+  if (vo_->getVerbLevel() >= Teuchos::VERB_EXTREME){
+    if (domain_name_ == "surface")  *vo_->os()<<std::setprecision(10)<<"Surface mass start "<<mass_start<<"\n";
+    else  *vo_->os()<<std::setprecision(10)<<"Subsurface mass start "<<mass_start<<"\n";
+  }
+
   // loop over exterior boundary sets
   for (int m = 0; m < bcs_.size(); m++) {
     std::vector<int>& tcc_index = bcs_[m]->tcc_index();
@@ -1360,25 +1383,21 @@ void Transport_PK_ATS::AdvanceDonorUpwind(double dt_cycle)
   }
  
   // recover concentration from new conservative state
-  for (int c = 0; c < ncells_owned; c++) {
-    vol_phi_ws_den = mesh_->cell_volume(c) * (*phi_)[0][c] * (*ws_end)[0][c] * (*mol_dens_end)[0][c];
-    for (int i = 0; i < num_advect; i++) {
-      if (vol_phi_ws_den > water_tolerance_ && (*conserve_qty_)[i][c] > 0) {
-        tcc_next[i][c] = (*conserve_qty_)[i][c] / vol_phi_ws_den;
-      }
-      else  {
-        (*solid_qty_)[i][c] += std::max((*conserve_qty_)[i][c], 0.);
-        tcc_next[i][c] = 0.;
+  double mass_final = Threading::parallel_sum(ncells_owned, [&](int c) {
+      double vol_phi_ws_den = vol[c] * (*phi_)[0][c] * (*ws_end)[0][c] * (*mol_dens_end)[0][c];
+      double mass_c = 0.;
+      for (int i = 0; i < num_advect; i++) {
+        if (vol_phi_ws_den > water_tolerance_ && (*conserve_qty_)[i][c] > 0) {
+          tcc_next[i][c] = (*conserve_qty_)[i][c] / vol_phi_ws_den;
+        }
+        else  {
+          (*solid_qty_)[i][c] += std::max((*conserve_qty_)[i][c], 0.);
+          tcc_next[i][c] = 0.;
+        }
+        mass_c += (*conserve_qty_)[i][c];
       }
-    }
-  }
-
-  double mass_final = 0;
-  for (int c = 0; c < ncells_owned; c++) {
-    for (int i = 0; i < num_advect; i++){        
-      mass_final += (*conserve_qty_)[i][c];
-    }    
-  }
+      return mass_c;
+    });
 
   tmp1 = mass_final;
   mesh_->get_comm()->SumAll(&tmp1, &mass_final, 1);
@@ -1439,11 +1458,14 @@ void Transport_PK_ATS::AdvanceSecondOrderUpwindRK1(double dt_cycle)
   Epetra_MultiVector& tcc_next = *tcc_tmp->ViewComponent("cell", true);
 
 
+  std::vector<double> vol(ncells_owned);
+  for (int c = 0; c < ncells_owned; c++) vol[c] = mesh_->cell_volume(c);
+
   Epetra_Vector ws_ratio(Copy, *ws_start, 0);
   for (int c = 0; c < ncells_owned; c++){
-    double vol_phi_ws_den_end = mesh_->cell_volume(c) * (*phi_)[0][c] * (*ws_end)[0][c] * (*mol_dens_end)[0][c];
+    double vol_phi_ws_den_end = vol[c] * (*phi_)[0][c] * (*ws_end)[0][c] * (*mol_dens_end)[0][c];
     if (vol_phi_ws_den_end > water_tolerance_)  {
-      double vol_phi_ws_den_start = mesh_->cell_volume(c) * (*phi_)[0][c] * (*ws_start)[0][c] * (*mol_dens_start)[0][c];
+      double vol_phi_ws_den_start = vol[c] * (*phi_)[0][c] * (*ws_start)[0][c] * (*mol_dens_start)[0][c];
       if (vol_phi_ws_den_start > water_tolerance_){
         ws_ratio[c] = ( (*ws_start)[0][c] * (*mol_dens_start)[0][c] )
                     / ( (*ws_end)[0][c]   * (*mol_dens_end)[0][c]   );
@@ -1470,7 +1492,7 @@ void Transport_PK_ATS::AdvanceSecondOrderUpwindRK1(double dt_cycle)
       tcc_next[i][c] = (tcc_prev[i][c] + dt_ * f_component[c]) * ws_ratio[c];
 
       if (tcc_next[i][c] < 0){
-        double vol_phi_ws_den = mesh_->cell_volume(c) * (*phi_)[0][c] * (*ws_end)[0][c] * (*mol_dens_end)[0][c];
+        double vol_phi_ws_den = vol[c] * (*phi_)[0][c] * (*ws_end)[0][c] * (*mol_dens_end)[0][c];
         (*solid_qty_)[i][c] += abs(tcc_next[i][c])*vol_phi_ws_den;
         tcc_next[i][c] = 0.;
       }
@@ -1507,6 +1529,9 @@ void Transport_PK_ATS::AdvanceSecondOrderUpwindRK2(double dt_cycle)
   Epetra_MultiVector& tcc_prev = *tcc->ViewComponent("cell", true);
   Epetra_MultiVector& tcc_next = *tcc_tmp->ViewComponent("cell", true);
 
+  std::vector<double> vol(ncells_owned);
+  for (int c = 0; c < ncells_owned; c++) vol[c] = mesh_->cell_volume(c);
+
   Epetra_Vector ws_ratio(Copy, *ws_start, 0);
   for (int c = 0; c < ncells_owned; c++){
     if ((*ws_end)[0][c] > 1e-10)  {
@@ -1556,7 +1581,7 @@ void Transport_PK_ATS::AdvanceSecondOrderUpwindRK2(double dt_cycle)
       double value = (tcc_prev[i][c] + dt_ * f_component[c]) * ws_ratio[c];
       tcc_next[i][c] = (tcc_next[i][c] + value) / 2;
       if (tcc_next[i][c] < 0){
-        double vol_phi_ws_den = mesh_->cell_volume(c) * (*phi_)[0][c] * (*ws_end)[0][c] * (*mol_dens_end)[0][c];
+        double vol_phi_ws_den = vol[c] * (*phi_)[0][c] * (*ws_end)[0][c] * (*mol_dens_end)[0][c];
         (*solid_qty_)[i][c] += abs(tcc_next[i][c])*vol_phi_ws_den;
         tcc_next[i][c] = 0.;
       }
@@ -32,6 +32,7 @@
 #include "VerboseObject.hh"
 #include "PK_PhysicalExplicit.hh"
 #include "DenseVector.hh"
+#include "ghost_scatter.hh"
 
 #include <string>
 
@@ -270,6 +271,8 @@ typedef double AnalyticFunction(const AmanziGeometry::Point&, const double);
 
   Teuchos::RCP<Epetra_IntVector> upwind_cell_;
   Teuchos::RCP<Epetra_IntVector> downwind_cell_;
+  std::vector<int> ghost_upwind_faces_;  // faces deferred until ghosts arrive
+  Teuchos::RCP<Operators::GhostScatter> cell_scatter_;
 
   Teuchos::RCP<const Epetra_MultiVector> ws_start, ws_end;  // data for subcycling 
   Teuchos::RCP<const Epetra_MultiVector> mol_dens_start, mol_dens_end;  // data for subcycling 
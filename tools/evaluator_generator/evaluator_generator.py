@@ -1,4 +1,5 @@
 import sys,os
+import sympy
 from sympy.printing import ccode
 
 _template_directory = os.path.dirname(os.path.abspath(__file__))
@@ -89,8 +90,6 @@ class EvalGen(object):
 
     def renderKeyEpetraVector(self):
         return '\n'.join([render('evaluator_keyEpetraVector.cc', dict(arg=arg,var=var)) for arg,var in zip(self.args,self.vars)])        
-    def renderKeyEpetraVectorIndented(self):
-        return '\n'.join([render('evaluator_keyEpetraVectorIndented.cc', dict(arg=arg,var=var)) for arg,var in zip(self.args,self.vars)])        
 
     def renderMyMethodArgs(self):
         return ", ".join(["%s_v[0][i]"%var for var in self.vars])
@@ -105,34 +104,17 @@ class EvalGen(object):
         d['myMethodArgs'] = self.renderMyMethodArgs()
         return render('evaluator_evaluateModel.cc', d)
 
-    def renderEvaluateDerivs(self):
-        wrt_list = []
+    def renderDependencyIndex(self):
+        return '\n'.join(["  if (key == %s_key_) return %d;"%(var,i) for i,var in enumerate(self.vars)])
+
+    def renderEvaluatePartials(self):
+        d = dict()
+        d['keyEpetraVectorList'] = self.renderKeyEpetraVector()
+        d['myKeyMethod'] = self.d['myKeyMethod']
+        d['myMethodArgs'] = self.renderMyMethodArgs()
+        d['nDependencies'] = len(self.args)
+        return render('evaluator_evaluatePartials.cc', d)
 
-        def getDict(arg,var):
-            d = dict(arg=arg,var=var)
-            d['keyEpetraVectorList'] = self.renderKeyEpetraVectorIndented()
-            d['myKeyMethod'] = self.d['myKeyMethod']
-            d['wrtMethod'] = ''.join([word[0].upper()+word[1:] for word in arg.split("_")])
-            d['myMethodArgs'] = self.renderMyMethodArgs()
-            return d
-        
-        if len(self.args) > 0:
-            d = getDict(self.args[0], self.vars[0])
-            d['if_elseif'] = render('evaluator_ifWRT.cc', d)
-            wrt_list.append(render('evaluator_evaluateDerivs.cc', d))
-
-        if len(self.args) > 1:
-            for arg,var in zip(self.args[1:],self.vars[1:]):
-                d = getDict(arg,var)
-                d['if_elseif'] = render('evaluator_elseifWRT.cc', d)
-                wrt_list.append(render('evaluator_evaluateDerivs.cc', d))
-
-        wrt_list.append('\n'.join(["  } else {",
-                                   "    ASSERT(0);",
-                                   "  }"]))
-
-        return "\n\n".join(wrt_list)
-                            
     def renderModelMethodDeclaration(self):
         return render('model_declaration.hh', dict(myMethod=self.d['myKeyMethod'],
                                                    myMethodDeclarationArgs=self.d['myMethodDeclarationArgs']))
@@ -157,7 +139,7 @@ class EvalGen(object):
 
         for arg,var in zip(self.args,self.vars):
             if self.expression is not None:
-                print "differentiation of", self.expression, "with respect to", var
+                print("differentiation of", self.expression, "with respect to", var)
                 implementation = ccode(self.expression.diff(var))
             else:
                 implementation = "ASSERT(False)"
@@ -168,6 +150,30 @@ class EvalGen(object):
                                      myMethodImplementation=implementation)))
         return '\n\n'.join(impls)
     
+    def renderModelFusedDeclaration(self):
+        return render('model_fusedDeclaration.hh', dict(myMethod=self.d['myKeyMethod'],
+                                                        myMethodDeclarationArgs=self.d['myMethodDeclarationArgs']))
+
+    def renderModelFusedImplementation(self):
+        # common subexpressions of the value and all partials are evaluated once
+        lines = []
+        if self.expression is not None:
+            derivs = [self.expression.diff(var) for var in self.vars]
+            tmps, exprs = sympy.cse([self.expression,] + derivs,
+                                    symbols=sympy.numbered_symbols("tmp"))
+            for tmp, tmp_expr in tmps:
+                lines.append("  double %s = %s;"%(tmp, ccode(tmp_expr)))
+            for i, deriv in enumerate(exprs[1:]):
+                lines.append("  d%s[%d] = %s;"%(self.d['myKeyMethod'], i, ccode(deriv)))
+            lines.append("  return %s;"%ccode(exprs[0]))
+        else:
+            lines.append("  AMANZI_ASSERT(false);")
+            lines.append("  return 0.;")
+        return render('model_fusedImplementation.cc', dict(evalClassName=self.d['evalClassName'],
+                                                            myMethod=self.d['myKeyMethod'],
+                                                            myMethodDeclarationArgs=self.d['myMethodDeclarationArgs'],
+                                                            myMethodImplementation='\n'.join(lines)))
+
     def renderModelParamDeclarations(self):
         return '\n'.join(['  %s %s;'%p for p in self.pars])
 
@@ -191,14 +197,18 @@ class EvalGen(object):
         self.d['myMethodArgs'] = self.renderMyMethodArgs()
         self.d['myMethodDeclarationArgs'] = self.renderMyMethodDeclarationArgs()
         self.d['evaluateModel'] = self.renderEvaluateModel()
-        self.d['evaluateDerivs'] = self.renderEvaluateDerivs()
+        self.d['nDependencies'] = len(self.args)
+        self.d['dependencyIndexList'] = self.renderDependencyIndex()
+        self.d['evaluatePartials'] = self.renderEvaluatePartials()
 
         self.d['modelMethodDeclaration'] = self.renderModelMethodDeclaration()
         self.d['modelDerivDeclarationList'] = self.renderModelDerivDeclarations()
+        self.d['modelFusedDeclaration'] = self.renderModelFusedDeclaration()
         self.d['paramDeclarationList'] = self.renderModelParamDeclarations()
 
         self.d['modelMethodImplementation'] = self.renderModelMethodImplementation()
         self.d['modelDerivImplementationList'] = self.renderModelDerivImplementations()
+        self.d['modelFusedImplementation'] = self.renderModelFusedImplementation()
         self.d['modelInitializeParamsList'] = self.renderModelParamInitializations()
 
 def generate_evaluator(name, namespace, descriptor, my_key, dependencies, parameters, **kwargs):
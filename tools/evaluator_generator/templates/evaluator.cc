@@ -25,7 +25,9 @@ namespace Relations {{
 {evalClassName}Evaluator::{evalClassName}Evaluator(const {evalClassName}Evaluator& other) :
     SecondaryVariableFieldEvaluator(other),
 {keyCopyConstructorList}    
-    model_(other.model_) {{}}
+    model_(other.model_),
+    partials_({nDependencies}),
+    partials_request_(other.partials_request_) {{}}
 
 
 // Virtual copy constructor
@@ -46,6 +48,17 @@ void
 
   // - pull Keys from plist
 {keyInitializeList}
+
+  partials_.resize({nDependencies});
+  partials_request_ = my_key_ + " partial derivatives";
+}}
+
+
+int
+{evalClassName}Evaluator::DependencyIndex_(const Key& key) const
+{{
+{dependencyIndexList}
+  return -1;
 }}
 
 
@@ -59,13 +72,66 @@ void
 }}
 
 
+// Assembling a preconditioner requests partial derivatives with respect to
+// several dependencies at the same state, one at a time.  All partials
+// requested so far are computed together in one pass, and kept until a
+// dependency changes.
 void
 {evalClassName}Evaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
         Key wrt_key, const Teuchos::Ptr<CompositeVector>& result)
+{{
+  int k = DependencyIndex_(wrt_key);
+  AMANZI_ASSERT(k >= 0);
+
+  bool changed = false;
+  for (KeySet::const_iterator dep=dependencies_.begin();
+       dep!=dependencies_.end(); ++dep) {{
+    changed |= S->GetFieldEvaluator(*dep)->HasFieldChanged(S, partials_request_);
+  }}
+
+  if (changed || partials_[k] == Teuchos::null) {{
+    if (partials_[k] == Teuchos::null) {{
+      partials_[k] = Teuchos::rcp(new CompositeVector(*result));
+    }}
+
+    std::vector<int> wrt;
+    std::vector<Teuchos::Ptr<CompositeVector> > results;
+    for (int j=0; j!={nDependencies}; ++j) {{
+      if (partials_[j] != Teuchos::null) {{
+        wrt.push_back(j);
+        results.push_back(partials_[j].ptr());
+      }}
+    }}
+    EvaluatePartials_(S, wrt, results);
+  }}
+
+  *result = *partials_[k];
+}}
+
+
+void
+{evalClassName}Evaluator::EvaluateFieldPartialDerivatives_(const Teuchos::Ptr<State>& S,
+        const std::vector<Key>& wrt_keys,
+        const std::vector<Teuchos::Ptr<CompositeVector> >& results)
+{{
+  AMANZI_ASSERT(wrt_keys.size() == results.size());
+  std::vector<int> wrt(wrt_keys.size());
+  for (int j=0; j!=wrt.size(); ++j) {{
+    wrt[j] = DependencyIndex_(wrt_keys[j]);
+    AMANZI_ASSERT(wrt[j] >= 0);
+  }}
+  if (wrt.size() > 0) EvaluatePartials_(S, wrt, results);
+}}
+
+
+void
+{evalClassName}Evaluator::EvaluatePartials_(const Teuchos::Ptr<State>& S,
+        const std::vector<int>& wrt,
+        const std::vector<Teuchos::Ptr<CompositeVector> >& results)
 {{
 {keyCompositeVectorList}
 
-{evaluateDerivs}
+{evaluatePartials}
 }}
 
 
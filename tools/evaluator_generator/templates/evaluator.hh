@@ -10,6 +10,8 @@
 #ifndef AMANZI_{namespaceCaps}_{evalNameCaps}_EVALUATOR_HH_
 #define AMANZI_{namespaceCaps}_{evalNameCaps}_EVALUATOR_HH_
 
+#include <vector>
+
 #include "Factory.hh"
 #include "secondary_variable_field_evaluator.hh"
 
@@ -34,15 +36,33 @@ class {evalClassName}Evaluator : public SecondaryVariableFieldEvaluator {{
   virtual void EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
           Key wrt_key, const Teuchos::Ptr<CompositeVector>& result);
 
+  // Partial derivatives with respect to several dependencies, computed
+  // together in one pass.
+  void EvaluateFieldPartialDerivatives_(const Teuchos::Ptr<State>& S,
+          const std::vector<Key>& wrt_keys,
+          const std::vector<Teuchos::Ptr<CompositeVector> >& results);
+
   Teuchos::RCP<{evalClassName}Model> get_model() {{ return model_; }}
 
  protected:
   void InitializeFromPlist_();
 
+  // index of a dependency in the model's argument list, or -1
+  int DependencyIndex_(const Key& key) const;
+
+  void EvaluatePartials_(const Teuchos::Ptr<State>& S,
+          const std::vector<int>& wrt,
+          const std::vector<Teuchos::Ptr<CompositeVector> >& results);
+
 {keyDeclarationList}
 
   Teuchos::RCP<{evalClassName}Model> model_;
 
+  // partial derivatives with respect to each dependency requested so far,
+  // by dependency index, valid until a dependency changes
+  std::vector<Teuchos::RCP<CompositeVector> > partials_;
+  Key partials_request_;
+
  private:
   static Utils::RegisteredFactory<FieldEvaluator,{evalClassName}Evaluator> reg_;
 
@@ -1 +0,0 @@
-  }} else if (wrt_key == {var}_key_) {{
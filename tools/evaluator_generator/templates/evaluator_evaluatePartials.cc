@@ -0,0 +1,19 @@
+  int nwrt = wrt.size();
+  std::vector<Epetra_MultiVector*> results_v(nwrt);
+  double d{myKeyMethod}[{nDependencies}];
+
+  for (CompositeVector::name_iterator comp=results[0]->begin();
+       comp!=results[0]->end(); ++comp) {{
+{keyEpetraVectorList}
+    for (int j=0; j!=nwrt; ++j) {{
+      results_v[j] = results[j]->ViewComponent(*comp,false).get();
+    }}
+
+    int ncomp = results[0]->size(*comp, false);
+    for (int i=0; i!=ncomp; ++i) {{
+      model_->{myKeyMethod}AndDerivatives({myMethodArgs}, d{myKeyMethod});
+      for (int j=0; j!=nwrt; ++j) {{
+        (*results_v[j])[0][i] = d{myKeyMethod}[wrt[j]];
+      }}
+    }}
+  }}
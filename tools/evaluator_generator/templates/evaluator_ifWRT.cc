@@ -1 +0,0 @@
-  if (wrt_key == {var}_key_) {{
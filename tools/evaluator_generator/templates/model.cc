@@ -35,6 +35,9 @@ void
 
 {modelDerivImplementationList}
 
+// value and all partial derivatives
+{modelFusedImplementation}
+
 }} //namespace
 }} //namespace
 }} //namespace
@@ -23,6 +23,8 @@ class {evalClassName}Model {{
 {modelMethodDeclaration}
 
 {modelDerivDeclarationList}
+
+{modelFusedDeclaration}
   
  protected:
   void InitializeFromPlist_(Teuchos::ParameterList& plist);
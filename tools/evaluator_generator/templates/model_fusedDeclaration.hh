@@ -0,0 +1,3 @@
+  // value, and the partial derivative with respect to each argument, in
+  // argument order, written to d{myMethod}
+  double {myMethod}AndDerivatives({myMethodDeclarationArgs}, double* d{myMethod}) const;
@@ -0,0 +1,5 @@
+double
+{evalClassName}Model::{myMethod}AndDerivatives({myMethodDeclarationArgs}, double* d{myMethod}) const
+{{
+{myMethodImplementation}
+}}